@@ -89,7 +89,7 @@ QVariant BreakpointModel::data(const QModelIndex& index, int role) const
 				case BreakpointColumns::CONDITION:
 					return bp->hasCond ? QString::fromStdString(bp->cond.expressionString) : "";
 				case BreakpointColumns::HITS:
-					return tr("--");
+					return bp->hasCond ? QString::number(bp->cond.hits.Get()) : tr("--");
 			}
 		}
 		else if (const auto* mc = std::get_if<MemCheck>(&bp_mc))
@@ -118,7 +118,7 @@ QVariant BreakpointModel::data(const QModelIndex& index, int role) const
 				case BreakpointColumns::CONDITION:
 					return mc->hasCond ? QString::fromStdString(mc->cond.expressionString) : "";
 				case BreakpointColumns::HITS:
-					return QString::number(mc->numHits);
+					return QString::number(mc->numHits.Get());
 			}
 		}
 	}
@@ -189,7 +189,7 @@ QVariant BreakpointModel::data(const QModelIndex& index, int role) const
 				case BreakpointColumns::CONDITION:
 					return mc->hasCond ? QString::fromStdString(mc->cond.expressionString) : "";
 				case BreakpointColumns::HITS:
-					return mc->numHits;
+					return static_cast<qulonglong>(mc->numHits.Get());
 			}
 		}
 	}
@@ -235,12 +235,23 @@ QVariant BreakpointModel::data(const QModelIndex& index, int role) const
 				case BreakpointColumns::CONDITION:
 					return mc->hasCond ? QString::fromStdString(mc->cond.expressionString) : "";
 				case BreakpointColumns::HITS:
-					return mc->numHits;
+					return static_cast<qulonglong>(mc->numHits.Get());
 				case BreakpointColumns::ENABLED:
 					return (mc->result & MEMCHECK_BREAK);
 			}
 		}
 	}
+	else if (role == Qt::ToolTipRole && index.column() == BreakpointColumns::CONDITION)
+	{
+		const BreakPointCond* cond = nullptr;
+		if (const auto* bp = std::get_if<BreakPoint>(&bp_mc))
+			cond = bp->hasCond ? &bp->cond : nullptr;
+		else if (const auto* mc = std::get_if<MemCheck>(&bp_mc))
+			cond = mc->hasCond ? &mc->cond : nullptr;
+
+		if (cond)
+			return tr("Evaluated %1 times, true %2 times").arg(cond->evaluations.Get()).arg(cond->hits.Get());
+	}
 	else if (role == Qt::CheckStateRole)
 	{
 		if (index.column() == 0)
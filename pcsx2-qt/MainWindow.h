@@ -175,6 +175,7 @@ private Q_SLOTS:
 	void onAboutActionTriggered();
 	void onToolsOpenDataDirectoryTriggered();
 	void onToolsCoverDownloaderTriggered();
+	void onToolsVerifyDiscImagesTriggered();
 #if !defined(__APPLE__)
 	void onCreateGameShortcutTriggered();
 #endif
@@ -458,6 +458,7 @@ bool ChdFileReader::ParseTOC(u64* out_frame_count)
 {
 	u64 total_frames = 0;
 	int max_found_track = -1;
+	track_count = 1;
 
 	for (int search_index = 0;; search_index++)
 	{
@@ -501,6 +502,8 @@ bool ChdFileReader::ParseTOC(u64* out_frame_count)
 		DevCon.WriteLn(fmt::format("CHD Track {}: frames:{} pregap:{} postgap:{} type:{} sub:{} pgtype:{} pgsub:{}",
 			track_num, frames, pregap_frames, postgap_frames, type_str, subtype_str, pgtype_str, pgsub_str));
 
+		track_count = std::max(track_count, static_cast<u32>(track_num));
+
 		// PCSX2 doesn't currently support multiple tracks for CDs.
 		if (track_num != 1)
 		{
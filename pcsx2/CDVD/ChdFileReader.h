@@ -24,6 +24,7 @@ public:
 
 	void Close2(void) override;
 	uint GetBlockCount(void) const override;
+	u32 GetTrackCount(void) const override { return track_count; }
 
 private:
 	bool ParseTOC(u64* out_frame_count);
@@ -31,4 +32,5 @@ private:
 	chd_file* ChdFile = nullptr;
 	u64 file_size = 0;
 	u32 hunk_size = 0;
+	u32 track_count = 1;
 };
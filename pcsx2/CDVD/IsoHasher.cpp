@@ -2,15 +2,63 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoHasher.h"
+#include "GameDatabase.h"
 #include "Host.h"
+#include "VMManager.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
+#include "common/FileSystem.h"
 #include "common/MD5Digest.h"
+#include "common/ScopedGuard.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
 
 #include "fmt/format.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// Sectors are read in chunks, which are hashed on a separate thread while the following chunks are read.
+static constexpr u32 HASH_CHUNK_SECTORS = 256;
+static constexpr u32 HASH_PIPELINE_DEPTH = 4;
+
+namespace
+{
+	/// Passed to the hashers running in a batch, so they never touch the caller's callback from another thread.
+	class BatchProgressCallback final : public BaseProgressCallback
+	{
+	public:
+		explicit BatchProgressCallback(const std::atomic_bool& cancelled)
+			: m_batch_cancelled(cancelled)
+		{
+		}
+
+		const std::string& GetError() const { return m_error; }
+
+		bool IsCancelled() const override { return m_batch_cancelled.load(std::memory_order_relaxed); }
+
+		void SetTitle(const char* title) override {}
+		void DisplayError(const char* message) override { m_error = message; }
+		void DisplayWarning(const char* message) override {}
+		void DisplayInformation(const char* message) override {}
+		void DisplayDebugMessage(const char* message) override {}
+		void ModalError(const char* message) override { m_error = message; }
+		bool ModalConfirmation(const char* message) override { return false; }
+		void ModalInformation(const char* message) override {}
+
+	private:
+		const std::atomic_bool& m_batch_cancelled;
+		std::string m_error;
+	};
+} // namespace
 
 IsoHasher::IsoHasher() = default;
 
@@ -104,8 +152,61 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 	return true;
 }
 
+bool IsoHasher::OpenImage(std::string iso_path, Error* error)
+{
+	Close();
+
+	m_iso = std::make_unique<InputIsoFile>();
+	if (!m_iso->Open(std::move(iso_path), error))
+	{
+		m_iso.reset();
+		return false;
+	}
+
+	switch (m_iso->GetType())
+	{
+		case ISOTYPE_CD:
+			m_is_cd = true;
+			break;
+
+		case ISOTYPE_DVD:
+		case ISOTYPE_DVDDL:
+			m_is_cd = false;
+			break;
+
+		default:
+			Error::SetString(error, fmt::format("Unknown image type {}", static_cast<int>(m_iso->GetType())));
+			Close();
+			return false;
+	}
+
+	// The readers only expose the first track, hashing it alone would pass off a partial image as complete.
+	if (const u32 tracks = m_iso->GetTrackCount(); tracks > 1)
+	{
+		Error::SetString(error, fmt::format("Image has {} tracks, only single track images can be hashed.", tracks));
+		Close();
+		return false;
+	}
+
+	Track strack;
+	strack.number = 1;
+	strack.type = CDVD_MODE1_TRACK;
+	strack.start_lsn = 0;
+	strack.sectors = m_iso->GetBlockCount();
+	strack.size = static_cast<u64>(strack.sectors) * (m_is_cd ? 2352 : 2048);
+	m_tracks.push_back(std::move(strack));
+	return true;
+}
+
 void IsoHasher::Close()
 {
+	if (m_iso)
+	{
+		m_iso.reset();
+		m_tracks.clear();
+		m_is_cd = false;
+	}
+
 	if (!m_is_locked)
 		return;
 
@@ -121,6 +222,18 @@ void IsoHasher::Close()
 	m_is_open = false;
 }
 
+s32 IsoHasher::ReadSector(u8* buffer, u32 lsn, int mode)
+{
+	if (!m_iso)
+		return DoCDVDreadSector(buffer, lsn, mode);
+
+	// Read through the same path as the ISO source's track reads, which fills in the header for
+	// 2048 byte CD images. Anything the image doesn't cover is left zeroed.
+	std::memset(buffer, 0, (mode == CDVD_MODE_2352) ? 2352 : 2048);
+	m_iso->BeginRead2(lsn);
+	return m_iso->FinishRead3(buffer, mode);
+}
+
 void IsoHasher::ComputeHashes(ProgressCallback* callback)
 {
 	callback->SetProgressRange(GetTrackCount());
@@ -155,32 +268,90 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 	// use 2048 byte reads for DVDs, otherwise 2352 raw.
 	const int read_mode = m_is_cd ? CDVD_MODE_2352 : CDVD_MODE_2048;
 	const u32 sector_size = m_is_cd ? 2352 : 2048;
-	std::vector<u8> sector_buffer(sector_size);
 
 	const u32 update_interval = std::max<u32>(track.sectors / 100u, 1u);
 	callback->SetStatusText(
 		fmt::format(TRANSLATE_FS("CDVD", "Calculating checksum for track {}..."), track.number).c_str());
 	callback->SetProgressRange(track.sectors);
 
+	std::array<std::vector<u8>, HASH_PIPELINE_DEPTH> chunks;
+	std::array<u32, HASH_PIPELINE_DEPTH> chunk_sizes = {};
+	for (std::vector<u8>& chunk : chunks)
+		chunk.resize(HASH_CHUNK_SECTORS * sector_size);
+
+	// Chunks are filled in order, and hashed in order, filled - hashed chunks are waiting.
+	std::mutex mutex;
+	std::condition_variable cv;
+	u32 chunks_filled = 0;
+	u32 chunks_hashed = 0;
+	bool reading_done = false;
+
 	MD5Digest md5;
-	for (u32 i = 0; i < track.sectors; i++)
-	{
-		if (callback->IsCancelled())
-			return false;
+	std::thread hasher([&]() {
+		Threading::SetNameOfCurrentThread("ISO Hasher");
 
-		const u32 lsn = track.start_lsn + i;
-		if (DoCDVDreadSector(sector_buffer.data(), lsn, read_mode) != 0)
+		std::unique_lock lock(mutex);
+		for (;;)
 		{
-			callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
-			return false;
+			cv.wait(lock, [&]() { return (chunks_hashed != chunks_filled || reading_done); });
+			if (chunks_hashed == chunks_filled)
+				break;
+
+			const u32 slot = chunks_hashed % HASH_PIPELINE_DEPTH;
+			lock.unlock();
+			md5.Update(chunks[slot].data(), chunk_sizes[slot]);
+			lock.lock();
+
+			chunks_hashed++;
+			cv.notify_all();
 		}
+	});
 
-		md5.Update(sector_buffer.data(), sector_size);
+	ScopedGuard stop_hasher([&]() {
+		{
+			std::unique_lock lock(mutex);
+			reading_done = true;
+		}
+		cv.notify_all();
+		hasher.join();
+	});
+
+	for (u32 i = 0; i < track.sectors;)
+	{
+		u32 slot;
+		{
+			std::unique_lock lock(mutex);
+			cv.wait(lock, [&]() { return (chunks_filled - chunks_hashed) < HASH_PIPELINE_DEPTH; });
+			slot = chunks_filled % HASH_PIPELINE_DEPTH;
+		}
+
+		const u32 count = std::min(track.sectors - i, HASH_CHUNK_SECTORS);
+		for (u32 j = 0; j < count; j++, i++)
+		{
+			if (callback->IsCancelled())
+				return false;
+
+			const u32 lsn = track.start_lsn + i;
+			if (ReadSector(&chunks[slot][j * sector_size], lsn, read_mode) != 0)
+			{
+				callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
+				return false;
+			}
+
+			if ((i % update_interval) == 0)
+				callback->SetProgressValue(i);
+		}
 
-		if ((i % update_interval) == 0)
-			callback->SetProgressValue(i);
+		chunk_sizes[slot] = count * sector_size;
+		{
+			std::unique_lock lock(mutex);
+			chunks_filled++;
+		}
+		cv.notify_all();
 	}
 
+	stop_hasher.Run();
+
 	u8 digest[16];
 	md5.Final(digest);
 	track.hash =
@@ -191,3 +362,123 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 	callback->SetProgressValue(track.sectors);
 	return true;
 }
+
+std::vector<IsoHasher::BatchEntry> IsoHasher::FindImages(const char* directory, bool recursive)
+{
+	FileSystem::FindResultsArray files;
+	FileSystem::FindFiles(directory, "*",
+		recursive ? (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE) :
+					(FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES),
+		&files);
+
+	std::vector<BatchEntry> entries;
+	for (FILESYSTEM_FIND_DATA& ffd : files)
+	{
+		if (!VMManager::IsDiscFileName(ffd.FileName))
+			continue;
+
+		BatchEntry entry;
+		entry.path = std::move(ffd.FileName);
+		entries.push_back(std::move(entry));
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const BatchEntry& lhs, const BatchEntry& rhs) { return lhs.path < rhs.path; });
+	return entries;
+}
+
+IsoHasher::BatchStats IsoHasher::VerifyImages(std::vector<BatchEntry>& entries, u32 max_images, ProgressCallback* callback)
+{
+	BatchStats stats = {};
+	Common::Timer timer;
+
+	callback->SetProgressRange(static_cast<u32>(entries.size()));
+	callback->SetProgressValue(0);
+	callback->SetCancellable(true);
+
+	GameDatabase::loadHashDatabase();
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::atomic_bool cancelled{false};
+	size_t next_entry = 0;
+	u32 entries_done = 0;
+	u64 bytes_hashed = 0;
+
+	const auto verify = [&](BatchEntry& entry) {
+		IsoHasher hasher;
+		Error error;
+		if (!hasher.OpenImage(entry.path, &error))
+		{
+			entry.error = error.GetDescription();
+			return;
+		}
+
+		BatchProgressCallback hash_callback(cancelled);
+		hasher.ComputeHashes(&hash_callback);
+
+		entry.tracks = hasher.GetTracks();
+		std::vector<GameDatabase::TrackHash> thashes(entry.tracks.size());
+		for (size_t i = 0; i < entry.tracks.size(); i++)
+		{
+			thashes[i].size = entry.tracks[i].size;
+			if (entry.tracks[i].hash.empty() || !thashes[i].parseHash(entry.tracks[i].hash))
+			{
+				entry.error = hash_callback.GetError().empty() ? std::string("One or more tracks is missing.") : hash_callback.GetError();
+				return;
+			}
+		}
+
+		std::unique_ptr<bool[]> tracks_matched = std::make_unique<bool[]>(thashes.size());
+		std::unique_lock lock(mutex);
+		for (const Track& track : entry.tracks)
+			bytes_hashed += track.size;
+		entry.db_entry = GameDatabase::lookupHash(thashes.data(), thashes.size(), tracks_matched.get(), &entry.error);
+	};
+
+	std::vector<std::thread> workers;
+	const u32 num_workers = std::min(std::max(max_images, 1u), static_cast<u32>(entries.size()));
+	for (u32 i = 0; i < num_workers; i++)
+	{
+		workers.emplace_back([&]() {
+			Threading::SetNameOfCurrentThread("ISO Batch Verify");
+
+			std::unique_lock lock(mutex);
+			while (!cancelled.load(std::memory_order_relaxed) && next_entry < entries.size())
+			{
+				BatchEntry& entry = entries[next_entry++];
+
+				lock.unlock();
+				verify(entry);
+				lock.lock();
+
+				entries_done++;
+				cv.notify_all();
+			}
+		});
+	}
+
+	// The caller's callback is only used on this thread.
+	{
+		std::unique_lock lock(mutex);
+		while (entries_done < entries.size() && !cancelled.load(std::memory_order_relaxed))
+		{
+			cv.wait_for(lock, std::chrono::milliseconds(100));
+			callback->SetProgressValue(entries_done);
+			if (callback->IsCancelled())
+				cancelled.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	callback->SetProgressValue(entries_done);
+
+	stats.images = entries_done;
+	stats.bytes = bytes_hashed;
+	stats.seconds = timer.GetTimeSeconds();
+	Console.WriteLn("IsoHasher: Verified %u images, %.2f MB in %.2f seconds (%.2f MB/s)", stats.images,
+		static_cast<double>(stats.bytes) / 1048576.0, stats.seconds,
+		(stats.seconds > 0.0) ? (static_cast<double>(stats.bytes) / 1048576.0 / stats.seconds) : 0.0);
+	return stats;
+}
@@ -6,10 +6,17 @@
 #include "common/Pcsx2Defs.h"
 #include "common/ProgressCallback.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
 class Error;
+class InputIsoFile;
+
+namespace GameDatabase
+{
+	struct HashDatabaseEntry;
+}
 
 class IsoHasher
 {
@@ -24,6 +31,22 @@ public:
 		std::string hash;
 	};
 
+	struct BatchEntry
+	{
+		std::string path;
+		std::vector<Track> tracks;
+		const GameDatabase::HashDatabaseEntry* db_entry = nullptr;
+		/// Why the image couldn't be hashed, or why its hashes don't match the database.
+		std::string error;
+	};
+
+	struct BatchStats
+	{
+		u32 images;
+		u64 bytes;
+		double seconds;
+	};
+
 public:
 	IsoHasher();
 	~IsoHasher();
@@ -39,14 +62,29 @@ public:
 	bool IsCD() const { return m_is_cd; }
 
 	bool Open(std::string iso_path, Error* error = nullptr);
+
+	/// Opens the image with its own reader instead of through CDVD, so it can be hashed alongside other images.
+	/// Sectors are read the way the ISO source returns them. Images with more than one track are rejected,
+	/// since only the first track can be read.
+	bool OpenImage(std::string iso_path, Error* error = nullptr);
+
 	void Close();
 
 	void ComputeHashes(ProgressCallback* callback = ProgressCallback::NullProgressCallback);
 
+	/// Returns the disc images in a directory, for VerifyImages().
+	static std::vector<BatchEntry> FindImages(const char* directory, bool recursive);
+
+	/// Hashes up to max_images images at once, and looks each one up in the hash database as soon as it's done.
+	static BatchStats VerifyImages(std::vector<BatchEntry>& entries, u32 max_images,
+		ProgressCallback* callback = ProgressCallback::NullProgressCallback);
+
 private:
 	bool ComputeTrackHash(Track& track, ProgressCallback* callback);
+	s32 ReadSector(u8* buffer, u32 lsn, int mode);
 
 	std::vector<Track> m_tracks;
+	std::unique_ptr<InputIsoFile> m_iso;
 	bool m_is_locked = false;
 	bool m_is_open = false;
 	bool m_is_cd = false;
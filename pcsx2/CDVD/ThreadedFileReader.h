@@ -113,6 +113,8 @@ public:
 	u32 GetBlockSize() const { return m_blocksize; }
 
 	virtual u32 GetBlockCount() const = 0;
+	/// Tracks in the image. Only the first is ever read, the rest are ignored.
+	virtual u32 GetTrackCount() const { return 1; }
 
 
 	bool Open(std::string filename, Error* error);
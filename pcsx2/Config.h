@@ -656,6 +656,8 @@ struct Pcsx2Config
 			EnableFastmem : 1;
 		bool
 			PauseOnTLBMiss : 1;
+		bool
+			EnableBlockProfile : 1;
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -839,6 +841,7 @@ struct Pcsx2Config
 		};
 
 		int VsyncQueueSize = 2;
+		int MTGSRingBufferSizeMB = 8; // Rounded up to a power of two, applied when the GS thread starts
 
 		float FramerateNTSC = DEFAULT_FRAME_RATE_NTSC;
 		float FrameratePAL = DEFAULT_FRAME_RATE_PAL;
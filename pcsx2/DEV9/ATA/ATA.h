@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <thread>
 #include <atomic>
@@ -17,6 +18,25 @@
 class ATA
 {
 public:
+	// Updated from both the CPU and IO threads, so every counter is atomic.
+	struct IOStats
+	{
+		std::atomic<u64> reads{0}; // Guest reads
+		std::atomic<u64> readSectors{0};
+		std::atomic<u64> readAheadHitSectors{0}; // Sectors served from read-ahead
+		std::atomic<u64> readAheads{0};
+		std::atomic<u64> readTimeNs{0}; // Time the guest waited on reads
+		std::atomic<u64> maxReadTimeNs{0};
+		std::atomic<u64> writeRequests{0}; // Guest writes
+		std::atomic<u64> writes{0}; // Writes issued to the image, after coalescing
+		std::atomic<u64> writeSectors{0};
+		std::atomic<u64> writeTimeNs{0};
+		std::atomic<u64> maxWriteTimeNs{0};
+		std::atomic<u32> maxPendingWrites{0}; // Deepest the write queue got
+
+		void Reset();
+	};
+
 	//Transfer
 	bool dmaReady = false;
 	int nsector = 0;     //sector count
@@ -116,6 +136,14 @@ private:
 		u64 sector;
 	};
 	SimpleQueue<WriteQueueEntry> writeQueue;
+	// Guest writes not yet written to the image, including those held by the IO thread.
+	std::atomic<u32> ioPendingWrites{0};
+	// Dequeued, but not contiguous with the previous write (IO thread only).
+	std::optional<WriteQueueEntry> ioHeldWrite;
+	// Contiguous queued writes are merged up to this size.
+	static constexpr u32 WriteCoalesceLimit = 4 * 1024 * 1024;
+	// Merged writes are gathered here, allocated on first merge and reused after.
+	std::unique_ptr<u8[]> writeCoalesceBuffer;
 
 	std::thread ioThread;
 	bool ioRunning = false;
@@ -128,9 +156,26 @@ private:
 	std::atomic_bool ioClose{false};
 	bool ioWrite;
 	bool ioRead;
+	bool ioReadAhead = false;
 	void (ATA::*waitingCmd)() = nullptr;
 	//Write Buffer(s)
 
+	//Read-ahead
+	//After a read that continues the previous one, the IO thread reads
+	//the following sectors while the guest consumes the current ones.
+	static constexpr u32 ReadAheadSectors = 512;
+	std::unique_ptr<u8[]> readAheadBuffer;
+	s64 readAheadLBA = 0;
+	u32 readAheadLength = 0; //sectors
+	s64 readAheadNextLBA = 0;
+	//Bumped after every write to the image, discarding read-ahead from before it.
+	u32 readAheadGeneration = 0;
+	u32 readAheadFilledGeneration = 0;
+	s64 lastReadEndLBA = -1;
+	//Read-ahead
+
+	IOStats ioStats;
+
 	//Read Buffer
 	int rdTransferred = 0;
 	int wrTransferred = 0;
@@ -171,6 +216,8 @@ public:
 
 	void Async(u32 cycles);
 
+	const IOStats& GetIOStats() const { return ioStats; }
+
 	int ReadDMAToFIFO(u8* buffer, int space);
 	int WriteDMAFromFIFO(u8* buffer, int available);
 
@@ -211,7 +258,13 @@ private:
 	//Transfer
 	void IO_Thread();
 	void IO_Read();
+	void IO_ReadAhead();
 	bool IO_Write();
+	bool IO_NextWrite(WriteQueueEntry* entry);
+	bool IO_ReadAt(u8* data, u64 byteOffset, u64 byteSize);
+	bool IO_WriteAt(const u8* data, u64 byteOffset, u64 byteSize);
+	static void IO_StatsMax(std::atomic<u64>& stat, u64 value);
+	void IO_LogStats();
 	bool IO_SparseZero(u64 byteOffset, u64 byteSize);
 	void IO_SparseCacheUpdateLocation(u64 Offset);
 	void IO_SparseCacheLoad();
@@ -54,6 +54,21 @@ int ATA::Open(const std::string& hddPath)
 		return -1;
 	}
 
+	// All reads and writes are positional, on the OS handle.
+	// The handle is owned by hddImage.
+#ifdef _WIN32
+	hddNativeHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(hddImage)));
+#elif defined(__POSIX__)
+	hddNativeHandle = fileno(hddImage);
+#endif
+	if (hddNativeHandle == INVALID_HANDLE_VALUE)
+	{
+		Console.Error("DEV9: ATA: Failed to get handle for HDD image '%s'", hddPath.c_str());
+		std::fclose(hddImage);
+		hddImage = nullptr;
+		return -1;
+	}
+
 	// Open and read the content of the hddid file
 	std::string hddidPath = Path::ReplaceExtension(hddPath, "hddid");
 	std::optional<std::vector<u8>> fileContent = FileSystem::ReadBinaryFile(hddidPath.c_str());
@@ -101,10 +116,16 @@ int ATA::Open(const std::string& hddPath)
 
 	InitSparseSupport(hddPath);
 
+	readAheadBuffer = std::make_unique<u8[]>(ReadAheadSectors * 512);
+	readAheadLength = 0;
+	lastReadEndLBA = -1;
+	ioStats.Reset();
+
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
 		ioWrite = false;
+		ioReadAhead = false;
 	}
 
 	ioThread = std::thread(&ATA::IO_Thread, this);
@@ -125,16 +146,6 @@ void ATA::InitSparseSupport(const std::string& hddPath)
 	if (!hddSparse)
 		return;
 
-	// Get OS specific file handle for spare writing.
-	// HANDLE is owned by FILE* hddImage.
-	hddNativeHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(hddImage)));
-	if (hddNativeHandle == INVALID_HANDLE_VALUE)
-	{
-		Console.Error("DEV9: ATA: Failed to open file for sparse");
-		hddSparse = false;
-		return;
-	}
-
 	// Get sparse block size (Initially assumed as 4096 bytes).
 	hddSparseBlockSize = 4096;
 
@@ -222,25 +233,17 @@ void ATA::InitSparseSupport(const std::string& hddPath)
 	// Otherwise assume SparseBlockSize == block size.
 
 #elif defined(__POSIX__)
-	// fd is owned by FILE* hddImage.
-	hddNativeHandle = fileno(hddImage);
-	hddSparse = false;
-	if (hddNativeHandle != -1)
-	{
-		// No way to check if we can hole punch without trying it
-		// so just assume sparse files are supported.
-		hddSparse = true;
-
-		// Get sparse block size (Initially assumed as 4096 bytes).
-		hddSparseBlockSize = 4096;
-		struct stat fileInfo;
-		if (fstat(hddNativeHandle, &fileInfo) == 0)
-			hddSparseBlockSize = fileInfo.st_blksize;
-		else
-			Console.Error("DEV9: ATA: Failed to get sparse block size (fstat returned != 0)");
-	}
+	// No way to check if we can hole punch without trying it
+	// so just assume sparse files are supported.
+	hddSparse = true;
+
+	// Get sparse block size (Initially assumed as 4096 bytes).
+	hddSparseBlockSize = 4096;
+	struct stat fileInfo;
+	if (fstat(hddNativeHandle, &fileInfo) == 0)
+		hddSparseBlockSize = fileInfo.st_blksize;
 	else
-		Console.Error("DEV9: ATA: Failed to open file for sparse");
+		Console.Error("DEV9: ATA: Failed to get sparse block size (fstat returned != 0)");
 #endif
 	hddSparseBlock = std::make_unique<u8[]>(hddSparseBlockSize);
 	hddSparseBlockValid = false;
@@ -263,20 +266,22 @@ void ATA::Close()
 	}
 
 	//verify queue
-	if (!writeQueue.IsQueueEmpty())
+	if (ioPendingWrites.load() != 0 || !writeQueue.IsQueueEmpty())
 	{
 		Console.Error("DEV9: ATA: Write queue not empty, possible data loss");
 		pxAssert(false);
 		abort(); //All data must be written at this point
 	}
 
+	if (hddImage)
+		IO_LogStats();
+
 	//Close File Handle
+	// hddNativeHandle is owned by hddImage.
+	// It will get closed in fclose(hddImage).
+	hddNativeHandle = INVALID_HANDLE_VALUE;
 	if (hddSparse)
 	{
-		// hddNativeHandle is owned by hddImage.
-		// It will get closed in fclose(hddImage).
-		hddNativeHandle = INVALID_HANDLE_VALUE;
-
 		hddSparse = false;
 		hddSparseBlock = nullptr;
 		hddSparseBlockValid = false;
@@ -289,6 +294,8 @@ void ATA::Close()
 
 	delete[] readBuffer;
 	readBuffer = nullptr;
+	readAheadBuffer = nullptr;
+	readAheadLength = 0;
 }
 
 void ATA::ResetBegin()
@@ -534,7 +541,7 @@ void ATA::Async(uint cycles)
 			waitingCmd = nullptr;
 			(this->*cmd)();
 		}
-		else if (!writeQueue.IsQueueEmpty()) //Flush cache
+		else if (ioPendingWrites.load() != 0) //Flush cache
 		{
 			//Log_Info("Starting async write");
 			{
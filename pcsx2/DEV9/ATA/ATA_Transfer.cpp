@@ -3,6 +3,7 @@
 
 #include "common/Assertions.h"
 #include "common/FileSystem.h"
+#include "common/Timer.h"
 
 #include "ATA.h"
 #include "DEV9/DEV9.h"
@@ -25,12 +26,16 @@ void ATA::IO_Thread()
 		ioThreadIdle_bool = true;
 		ioThreadIdle_cv.notify_all();
 
-		ioReady.wait(ioWaitHandle, [&] { return ioRead | ioWrite; });
+		ioReady.wait(ioWaitHandle, [&] { return ioRead | ioWrite | ioReadAhead; });
 		ioThreadIdle_bool = false;
 
+		//Read-ahead goes before writes, as the guest is likely to ask for it next,
+		//while queued writes are already acknowledged.
 		int ioType = -1;
 		if (ioRead)
 			ioType = 0;
+		else if (ioReadAhead)
+			ioType = 2;
 		else if (ioWrite)
 			ioType = 1;
 
@@ -39,6 +44,8 @@ void ATA::IO_Thread()
 		//Read or Write
 		if (ioType == 0)
 			IO_Read();
+		else if (ioType == 2)
+			IO_ReadAhead();
 		else if (ioType == 1)
 		{
 			if (!IO_Write())
@@ -67,71 +74,176 @@ void ATA::IO_Read()
 		abort();
 	}
 
-	const u64 pos = lba * 512;
-	if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
-		std::fread(readBuffer,  512, nsector, hddImage) != static_cast<size_t>(nsector))
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+
+	//Take what we can from the read-ahead, the IO thread is idle at this point.
+	u32 done = 0;
+	if (readAheadLength != 0 && readAheadFilledGeneration == readAheadGeneration &&
+		lba >= readAheadLBA && lba < readAheadLBA + readAheadLength)
+	{
+		done = std::min<u32>(nsector, static_cast<u32>(readAheadLBA + readAheadLength - lba));
+		memcpy(readBuffer, &readAheadBuffer[(lba - readAheadLBA) * 512], done * 512);
+		ioStats.readAheadHitSectors.fetch_add(done, std::memory_order_relaxed);
+	}
+
+	if (done != static_cast<u32>(nsector) &&
+		!IO_ReadAt(&readBuffer[done * 512], (lba + done) * 512, (nsector - done) * 512))
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
 		abort();
 	}
+
+	const u64 time = static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue() - start));
+	ioStats.reads.fetch_add(1, std::memory_order_relaxed);
+	ioStats.readSectors.fetch_add(nsector, std::memory_order_relaxed);
+	ioStats.readTimeNs.fetch_add(time, std::memory_order_relaxed);
+	IO_StatsMax(ioStats.maxReadTimeNs, time);
+
+	//Prefetch what follows a sequential read, unless we already have it.
+	const s64 end = lba + nsector;
+	const bool sequential = (lba == lastReadEndLBA);
+	lastReadEndLBA = end;
+
+	const bool readAhead = sequential && static_cast<u64>(end) < hddImageSize / 512 &&
+						   (readAheadFilledGeneration != readAheadGeneration ||
+							   end < readAheadLBA || end + nsector > readAheadLBA + readAheadLength);
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
+		if (readAhead)
+		{
+			readAheadNextLBA = end;
+			ioReadAhead = true;
+		}
+	}
+	if (readAhead)
+		ioReady.notify_all();
+}
+
+void ATA::IO_ReadAhead()
+{
+	s64 lba;
+	u32 generation;
+	{
+		std::lock_guard ioSignallock(ioMutex);
+		lba = readAheadNextLBA;
+		generation = readAheadGeneration;
+	}
+
+	const u32 sectors = static_cast<u32>(std::min<u64>(ReadAheadSectors, hddImageSize / 512 - lba));
+	if (!IO_ReadAt(readAheadBuffer.get(), lba * 512, sectors * 512))
+	{
+		Console.Error("DEV9: ATA: File read error");
+		pxAssert(false);
+		abort();
+	}
+	ioStats.readAheads.fetch_add(1, std::memory_order_relaxed);
+
+	std::lock_guard ioSignallock(ioMutex);
+	readAheadLBA = lba;
+	readAheadLength = sectors;
+	readAheadFilledGeneration = generation;
+	ioReadAhead = false;
+}
+
+bool ATA::IO_NextWrite(WriteQueueEntry* entry)
+{
+	if (ioHeldWrite.has_value())
+	{
+		*entry = ioHeldWrite.value();
+		ioHeldWrite.reset();
+		return true;
 	}
+	return writeQueue.Dequeue(entry);
 }
 
 bool ATA::IO_Write()
 {
 	WriteQueueEntry entry;
-	if (!writeQueue.Dequeue(&entry))
+	if (!IO_NextWrite(&entry))
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioWrite = false;
 		return false;
 	}
 
-	const u64 imagePos = entry.sector * 512;
-	if (FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
+	//Merge writes to following sectors, so a stream of small guest writes becomes one large write.
+	//A write which doesn't follow on is held for next time.
+	u32 merged = 1;
+	const u8* data = entry.data;
+	u32 length = entry.length;
 	{
-		Console.Error("DEV9: ATA: File seek error");
-		pxAssert(false);
-		abort();
+		std::vector<WriteQueueEntry> batch;
+		WriteQueueEntry next;
+		while (length < WriteCoalesceLimit && IO_NextWrite(&next))
+		{
+			const WriteQueueEntry& last = batch.empty() ? entry : batch.back();
+			if (next.sector != last.sector + last.length / 512 || length + next.length > WriteCoalesceLimit)
+			{
+				ioHeldWrite = next;
+				break;
+			}
+			batch.push_back(next);
+			length += next.length;
+		}
+
+		if (!batch.empty())
+		{
+			if (!writeCoalesceBuffer)
+				writeCoalesceBuffer = std::make_unique<u8[]>(WriteCoalesceLimit);
+
+			u8* buffer = writeCoalesceBuffer.get();
+			memcpy(buffer, entry.data, entry.length);
+			delete[] entry.data;
+
+			u32 offset = entry.length;
+			for (const WriteQueueEntry& part : batch)
+			{
+				memcpy(&buffer[offset], part.data, part.length);
+				offset += part.length;
+				delete[] part.data;
+			}
+
+			entry.data = nullptr;
+			data = buffer;
+			merged += static_cast<u32>(batch.size());
+		}
 	}
+
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+
+	const u64 imagePos = entry.sector * 512;
 	if (hddSparse)
 	{
 		u32 written = 0;
-		while (written != entry.length)
+		while (written != length)
 		{
 			IO_SparseCacheUpdateLocation(imagePos + written);
 			// Align to sparse block size.
 			u32 writeSize = static_cast<u32>(hddSparseBlockSize - ((imagePos + written) % hddSparseBlockSize));
 			// Limit to size of write.
-			writeSize = std::min(writeSize, entry.length - written);
+			writeSize = std::min(writeSize, length - written);
 
 			pxAssert(writeSize > 0);
 			pxAssert(writeSize <= hddSparseBlockSize);
 			pxAssert((imagePos + written) >= HddSparseStart);
 			pxAssert((imagePos + written) - HddSparseStart + writeSize <= hddSparseBlockSize);
 
-			bool sparseWrite = IsAllZero(&entry.data[written], writeSize);
+			bool sparseWrite = IsAllZero(&data[written], writeSize);
 
 			if (sparseWrite)
 			{
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 				std::unique_ptr<u8[]> zeroBlock = std::make_unique<u8[]>(writeSize);
 				memset(zeroBlock.get(), 0, writeSize);
-				pxAssert(memcmp(&entry.data[written], zeroBlock.get(), writeSize) == 0);
+				pxAssert(memcmp(&data[written], zeroBlock.get(), writeSize) == 0);
 #endif
 
 				if (!IO_SparseZero(imagePos + written, writeSize))
 				{
 					Console.Error("DEV9: ATA: File sparse write error");
 
-					// hddNativeHandle is owned by hddImage.
-					// do not close it.
-					hddNativeHandle = INVALID_HANDLE_VALUE;
-
 					hddSparse = false;
 					hddSparseBlock = nullptr;
 					hddSparseBlockValid = false;
@@ -149,15 +261,14 @@ bool ATA::IO_Write()
 				{
 					std::unique_ptr<u8[]> zeroBlock = std::make_unique<u8[]>(writeSize);
 					memset(zeroBlock.get(), 0, writeSize);
-					pxAssert(memcmp(&entry.data[written], zeroBlock.get(), writeSize) != 0);
+					pxAssert(memcmp(&data[written], zeroBlock.get(), writeSize) != 0);
 				}
 #endif
 				// Update cache.
 				if (hddSparseBlockValid)
-					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &entry.data[written], writeSize);
+					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &data[written], writeSize);
 
-				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1 ||
-					std::fflush(hddImage) != 0)
+				if (!IO_WriteAt(&data[written], imagePos + written, writeSize))
 				{
 					Console.Error("DEV9: ATA: File write error");
 					pxAssert(false);
@@ -165,12 +276,11 @@ bool ATA::IO_Write()
 				}
 			}
 			written += writeSize;
-			pxAssert(FileSystem::FTell64(hddImage) == (s64)(imagePos + written));
 		}
 	}
 	else
 	{
-		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
+		if (!IO_WriteAt(data, imagePos, length))
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -178,9 +288,110 @@ bool ATA::IO_Write()
 		}
 	}
 	delete[] entry.data;
+
+	//Any read-ahead done before this write is stale now.
+	{
+		std::lock_guard ioSignallock(ioMutex);
+		readAheadGeneration++;
+	}
+
+	const u64 time = static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue() - start));
+	ioStats.writes.fetch_add(1, std::memory_order_relaxed);
+	ioStats.writeSectors.fetch_add(length / 512, std::memory_order_relaxed);
+	ioStats.writeTimeNs.fetch_add(time, std::memory_order_relaxed);
+	IO_StatsMax(ioStats.maxWriteTimeNs, time);
+
+	ioPendingWrites.fetch_sub(merged);
 	return true;
 }
 
+bool ATA::IO_ReadAt(u8* data, u64 byteOffset, u64 byteSize)
+{
+	while (byteSize > 0)
+	{
+#ifdef _WIN32
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(byteOffset);
+		overlapped.OffsetHigh = static_cast<DWORD>(byteOffset >> 32);
+		DWORD read;
+		if (!ReadFile(hddNativeHandle, data, static_cast<DWORD>(std::min<u64>(byteSize, 0x40000000)), &read, &overlapped) || read == 0)
+			return false;
+#else
+		const ssize_t read = pread(hddNativeHandle, data, byteSize, static_cast<off_t>(byteOffset));
+		if (read <= 0)
+		{
+			if (read == -1 && errno == EINTR)
+				continue;
+			return false;
+		}
+#endif
+		data += read;
+		byteOffset += read;
+		byteSize -= read;
+	}
+	return true;
+}
+
+bool ATA::IO_WriteAt(const u8* data, u64 byteOffset, u64 byteSize)
+{
+	while (byteSize > 0)
+	{
+#ifdef _WIN32
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(byteOffset);
+		overlapped.OffsetHigh = static_cast<DWORD>(byteOffset >> 32);
+		DWORD written;
+		if (!WriteFile(hddNativeHandle, data, static_cast<DWORD>(std::min<u64>(byteSize, 0x40000000)), &written, &overlapped) || written == 0)
+			return false;
+#else
+		const ssize_t written = pwrite(hddNativeHandle, data, byteSize, static_cast<off_t>(byteOffset));
+		if (written <= 0)
+		{
+			if (written == -1 && errno == EINTR)
+				continue;
+			return false;
+		}
+#endif
+		data += written;
+		byteOffset += written;
+		byteSize -= written;
+	}
+	return true;
+}
+
+void ATA::IO_StatsMax(std::atomic<u64>& stat, u64 value)
+{
+	u64 current = stat.load(std::memory_order_relaxed);
+	while (value > current && !stat.compare_exchange_weak(current, value, std::memory_order_relaxed))
+	{
+	}
+}
+
+void ATA::IOStats::Reset()
+{
+	for (std::atomic<u64>* stat : {&reads, &readSectors, &readAheadHitSectors, &readAheads, &readTimeNs, &maxReadTimeNs,
+			 &writeRequests, &writes, &writeSectors, &writeTimeNs, &maxWriteTimeNs})
+		stat->store(0, std::memory_order_relaxed);
+	maxPendingWrites.store(0, std::memory_order_relaxed);
+}
+
+void ATA::IO_LogStats()
+{
+	if (ioStats.reads != 0)
+	{
+		DevCon.WriteLn("DEV9: ATA: %llu reads, %llu sectors (%llu from read-ahead, %llu read-aheads), %.2f ms (max %.2f ms)",
+			ioStats.reads.load(), ioStats.readSectors.load(), ioStats.readAheadHitSectors.load(), ioStats.readAheads.load(),
+			static_cast<double>(ioStats.readTimeNs.load()) / 1000000.0, static_cast<double>(ioStats.maxReadTimeNs.load()) / 1000000.0);
+	}
+	if (ioStats.writeRequests != 0)
+	{
+		DevCon.WriteLn("DEV9: ATA: %llu writes as %llu after coalescing, %llu sectors, %.2f ms (max %.2f ms), max queue depth %u",
+			ioStats.writeRequests.load(), ioStats.writes.load(), ioStats.writeSectors.load(),
+			static_cast<double>(ioStats.writeTimeNs.load()) / 1000000.0, static_cast<double>(ioStats.maxWriteTimeNs.load()) / 1000000.0,
+			ioStats.maxPendingWrites.load());
+	}
+}
+
 void ATA::IO_SparseCacheLoad()
 {
 	// Reads are bounds checked, but for the sectors read only.
@@ -195,12 +406,6 @@ void ATA::IO_SparseCacheLoad()
 		memset(&hddSparseBlock[readSize], 0, hddSparseBlockSize - readSize);
 	}
 
-	// Flush so that we know what is allocated.
-	std::fflush(hddImage);
-
-	// Store file pointer.
-	const s64 orgPos = FileSystem::FTell64(hddImage);
-
 #ifdef _WIN32
 	// FlushFileBuffers is required, hddSparseBlock differs from actual file without it.
 	FlushFileBuffers(hddNativeHandle);
@@ -247,10 +452,7 @@ void ATA::IO_SparseCacheLoad()
 #endif
 
 	// Load into cache.
-	if (orgPos == -1 ||
-		FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET) != 0 ||
-		std::fread((char*)hddSparseBlock.get(), readSize, 1, hddImage) != 1 ||
-		FileSystem::FSeek64(hddImage, orgPos, SEEK_SET) != 0) // Restore file pointer.
+	if (!IO_ReadAt(hddSparseBlock.get(), HddSparseStart, readSize))
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
@@ -265,21 +467,11 @@ void ATA::IO_SparseCacheLoad()
 // Used by IO_SparseCacheLoad to ensure the sparse/allocated apis and FileSystem apis are in sync
 void ATA::IO_SparseCacheAssertFileZeros(u64 hddSparseBlockSizeReadable)
 {
-	const s64 orgPos = FileSystem::FTell64(hddImage);
-	pxAssert(orgPos != -1);
-
-	// Load into check buffer.
-	FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET);
-
 	std::unique_ptr<u8[]> temp = std::make_unique<u8[]>(hddSparseBlockSize);
 	memset(temp.get(), 0, hddSparseBlockSize);
 
-	if (FileSystem::FSeek64(hddImage, HddSparseStart, SEEK_SET) != 0 ||
-		std::fread((char*)hddSparseBlock.get(), hddSparseBlockSizeReadable, 1, hddImage) != 1)
-		pxAssert(false);
-
-	// Restore file pointer.
-	if (FileSystem::FSeek64(hddImage, orgPos, SEEK_SET) != 0)
+	// Load into check buffer.
+	if (!IO_ReadAt(hddSparseBlock.get(), HddSparseStart, hddSparseBlockSizeReadable))
 		pxAssert(false);
 
 	bool regionIsZeros = memcmp(hddSparseBlock.get(), temp.get(), hddSparseBlockSize) == 0;
@@ -309,7 +501,6 @@ void ATA::IO_SparseCacheUpdateLocation(u64 byteOffset)
 	}
 }
 
-// Also sets hddImage write ptr.
 bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 {
 	if (hddSparseBlockValid == false)
@@ -332,8 +523,7 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 #endif
 
 		//No, do normal write
-		if (std::fwrite((char*)&hddSparseBlock[byteOffset - HddSparseStart], byteSize, 1, hddImage) != 1 ||
-			std::fflush(hddImage) != 0)
+		if (!IO_WriteAt(&hddSparseBlock[byteOffset - HddSparseStart], byteOffset, byteSize))
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -379,12 +569,6 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 	Console.Error("DEV9: ATA: Hole punching not supported on current OS");
 	return false;
 #endif
-	if (FileSystem::FSeek64(hddImage, byteOffset + byteSize, SEEK_SET) != 0)
-	{
-		Console.Error("DEV9: ATA: File seek error");
-		pxAssert(false);
-		abort();
-	}
 	return true;
 }
 
@@ -51,6 +51,12 @@ void ATA::PostCmdDMADataFromHost()
 	entry.data = currentWrite;
 	entry.length = currentWriteLength;
 	entry.sector = currentWriteSectors;
+
+	ioStats.writeRequests.fetch_add(1, std::memory_order_relaxed);
+	const u32 pending = ioPendingWrites.fetch_add(1) + 1;
+	if (pending > ioStats.maxPendingWrites.load(std::memory_order_relaxed))
+		ioStats.maxPendingWrites.store(pending, std::memory_order_relaxed);
+
 	writeQueue.Enqueue(entry);
 	currentWrite = nullptr;
 	currentWriteLength = 0;
@@ -5,6 +5,7 @@
 
 #include "DEV9/net.h"
 #include "MAC_Address.h"
+#include "PacketPool.h"
 #include "Payload.h"
 
 namespace PacketReader
@@ -20,7 +21,7 @@ namespace PacketReader
 		VlanDoubleQTag = 0x9100
 	};
 
-	class EthernetFrame
+	class EthernetFrame : public PacketPool::PooledObject
 	{
 	public:
 		MAC_Address destinationMAC{};
@@ -5,9 +5,11 @@
 
 #include "common/Pcsx2Defs.h"
 
+#include "DEV9/PacketReader/PacketPool.h"
+
 namespace PacketReader::IP
 {
-	class IP_Payload
+	class IP_Payload : public PacketPool::PooledObject
 	{
 	public: //Nedd GetProtocol
 		virtual int GetLength() = 0;
@@ -22,7 +24,7 @@ namespace PacketReader::IP
 	class IP_PayloadData : public IP_Payload
 	{
 	public:
-		std::unique_ptr<u8[]> data;
+		PacketPool::BufferPtr data;
 
 	private:
 		const int length;
@@ -30,21 +32,18 @@ namespace PacketReader::IP
 
 	public:
 		IP_PayloadData(int len, u8 prot)
-			: length{len}
+			: data{PacketPool::MakeBuffer(len)}
+			, length{len}
 			, protocol{prot}
 		{
-			if (len != 0)
-				data = std::make_unique<u8[]>(len);
 		}
 		IP_PayloadData(const IP_PayloadData& original)
-			: length{original.length}
+			: data{PacketPool::MakeBuffer(original.length)}
+			, length{original.length}
 			, protocol{original.protocol}
 		{
 			if (length != 0)
-			{
-				data = std::make_unique<u8[]>(length);
 				memcpy(data.get(), original.data.get(), length);
-			}
 		}
 		virtual int GetLength()
 		{
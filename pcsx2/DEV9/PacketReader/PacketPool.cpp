@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "PacketPool.h"
+
+#include <atomic>
+#include <iterator>
+#include <new>
+
+namespace PacketReader::PacketPool
+{
+	namespace
+	{
+		//Packet objects are small, the largest ones are under 256 bytes
+		constexpr size_t ObjectClassSizes[] = {64, 128, 256, 512};
+		constexpr size_t ObjectClassCount = std::size(ObjectClassSizes);
+		constexpr size_t BufferClass = ObjectClassCount;
+		constexpr size_t ClassCount = ObjectClassCount + 1;
+
+		//Enough to cover a burst of queued frames, anything over is freed
+		constexpr size_t MaxCachedObjects = 256;
+		constexpr size_t MaxCachedBuffers = 64;
+
+		struct ThreadPool;
+
+		//Placed in front of every pooled block, so it can be returned to the pool it came from
+		struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader
+		{
+			ThreadPool* owner;
+			//Links blocks freed by other threads, while the block is on a remote list
+			BlockHeader* next;
+		};
+
+		class FreeList
+		{
+			BlockHeader** blocks;
+			size_t count = 0;
+			const size_t capacity;
+
+		public:
+			explicit FreeList(size_t cap)
+				: blocks{new BlockHeader*[cap]}
+				, capacity{cap}
+			{
+			}
+			FreeList(const FreeList&) = delete;
+			~FreeList()
+			{
+				for (size_t i = 0; i < count; i++)
+					::operator delete(blocks[i]);
+				delete[] blocks;
+			}
+
+			BlockHeader* Pop()
+			{
+				return count != 0 ? blocks[--count] : nullptr;
+			}
+
+			bool Push(BlockHeader* block)
+			{
+				if (count == capacity)
+					return false;
+				blocks[count++] = block;
+				return true;
+			}
+		};
+
+		//Owned by one thread, which is the only one to touch the free lists
+		//Other threads hand blocks back through the remote lists, which the owner takes whole when its own list runs dry
+		//The pool outlives its thread while any of its blocks are still in use
+		struct ThreadPool
+		{
+			FreeList lists[ClassCount] = {
+				FreeList{MaxCachedObjects},
+				FreeList{MaxCachedObjects},
+				FreeList{MaxCachedObjects},
+				FreeList{MaxCachedObjects},
+				FreeList{MaxCachedBuffers},
+			};
+			std::atomic<BlockHeader*> remote[ClassCount] = {};
+			//One for the owning thread, plus one per block in use
+			std::atomic<size_t> refs{1};
+
+			~ThreadPool()
+			{
+				for (std::atomic<BlockHeader*>& list : remote)
+				{
+					BlockHeader* block = list.load(std::memory_order_acquire);
+					while (block != nullptr)
+					{
+						BlockHeader* next = block->next;
+						::operator delete(block);
+						block = next;
+					}
+				}
+			}
+
+			void Release()
+			{
+				if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					delete this;
+			}
+		};
+
+		//Trivially destructible, so still readable while other thread locals are destroyed
+		thread_local ThreadPool* t_pool = nullptr;
+		thread_local bool t_pool_released = false;
+
+		//Drops the thread's reference to its pool when the thread exits
+		//Packets freed after this go back to the pool they came from, or the heap
+		class ThreadPoolGuard
+		{
+		public:
+			~ThreadPoolGuard()
+			{
+				ThreadPool* pool = t_pool;
+				t_pool = nullptr;
+				t_pool_released = true;
+				pool->Release();
+			}
+		};
+
+		ThreadPool* GetThreadPool()
+		{
+			if (t_pool == nullptr && !t_pool_released)
+			{
+				t_pool = new ThreadPool();
+				thread_local ThreadPoolGuard guard;
+			}
+			return t_pool;
+		}
+
+		int GetObjectClass(size_t size)
+		{
+			for (size_t i = 0; i < ObjectClassCount; i++)
+			{
+				if (size <= ObjectClassSizes[i])
+					return static_cast<int>(i);
+			}
+			return -1;
+		}
+
+		void* AllocateBlock(size_t blockClass, size_t size)
+		{
+			ThreadPool* pool = GetThreadPool();
+			BlockHeader* block = nullptr;
+			if (pool != nullptr)
+			{
+				block = pool->lists[blockClass].Pop();
+				if (block == nullptr)
+				{
+					//Take back everything other threads have freed since we last looked
+					BlockHeader* returned = pool->remote[blockClass].exchange(nullptr, std::memory_order_acquire);
+					while (returned != nullptr)
+					{
+						BlockHeader* next = returned->next;
+						if (!pool->lists[blockClass].Push(returned))
+							::operator delete(returned);
+						returned = next;
+					}
+					block = pool->lists[blockClass].Pop();
+				}
+				pool->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (block == nullptr)
+				block = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size));
+			block->owner = pool;
+			return block + 1;
+		}
+
+		void FreeBlock(size_t blockClass, void* ptr)
+		{
+			BlockHeader* block = static_cast<BlockHeader*>(ptr) - 1;
+			ThreadPool* owner = block->owner;
+			if (owner == nullptr)
+			{
+				::operator delete(block);
+				return;
+			}
+
+			if (owner == t_pool)
+			{
+				if (!owner->lists[blockClass].Push(block))
+					::operator delete(block);
+			}
+			else
+			{
+				//Freed on another thread, or after the owning thread has exited
+				std::atomic<BlockHeader*>& list = owner->remote[blockClass];
+				BlockHeader* head = list.load(std::memory_order_relaxed);
+				do
+				{
+					block->next = head;
+				} while (!list.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+			}
+			owner->Release();
+		}
+	} // namespace
+
+	void* AllocateObject(size_t size)
+	{
+		const int objectClass = GetObjectClass(size);
+		if (objectClass == -1)
+			return ::operator new(size);
+
+		return AllocateBlock(objectClass, ObjectClassSizes[objectClass]);
+	}
+
+	void FreeObject(void* ptr, size_t size)
+	{
+		if (ptr == nullptr)
+			return;
+
+		const int objectClass = GetObjectClass(size);
+		if (objectClass == -1)
+			::operator delete(ptr);
+		else
+			FreeBlock(objectClass, ptr);
+	}
+
+	u8* AllocateBuffer()
+	{
+		return static_cast<u8*>(AllocateBlock(BufferClass, BufferSize));
+	}
+
+	void FreeBuffer(u8* buffer)
+	{
+		if (buffer != nullptr)
+			FreeBlock(BufferClass, buffer);
+	}
+
+	BufferPtr MakeBuffer(int size)
+	{
+		if (size == 0)
+			return BufferPtr{};
+		if (size > BufferSize)
+			return BufferPtr{new u8[size], BufferDeleter{false}};
+		return BufferPtr{AllocateBuffer(), BufferDeleter{true}};
+	}
+} // namespace PacketReader::PacketPool
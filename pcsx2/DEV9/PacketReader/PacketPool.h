@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "common/Pcsx2Defs.h"
+
+//Recycles the memory of packet objects and payload buffers, which are created and destroyed for every frame
+//Freed blocks go back to a free list owned by the thread which allocated them, so only blocks freed by another thread need an atomic
+namespace PacketReader::PacketPool
+{
+	//Large enough for the contents of any frame
+	constexpr int BufferSize = 2048;
+
+	void* AllocateObject(size_t size);
+	void FreeObject(void* ptr, size_t size);
+
+	u8* AllocateBuffer();
+	void FreeBuffer(u8* buffer);
+
+	struct BufferDeleter
+	{
+		bool pooled = false;
+
+		void operator()(u8* buffer) const
+		{
+			if (pooled)
+				FreeBuffer(buffer);
+			else
+				delete[] buffer;
+		}
+	};
+
+	typedef std::unique_ptr<u8[], BufferDeleter> BufferPtr;
+
+	//Pooled unless larger than BufferSize, null if size is 0
+	BufferPtr MakeBuffer(int size);
+
+	//Base for classes allocated per packet
+	class PooledObject
+	{
+	public:
+		static void* operator new(size_t size)
+		{
+			return AllocateObject(size);
+		}
+		//Deleting via a base class pointer needs a virtual destructor, for size to be correct
+		static void operator delete(void* ptr, size_t size)
+		{
+			FreeObject(ptr, size);
+		}
+	};
+} // namespace PacketReader::PacketPool
@@ -9,9 +9,11 @@
 #include "common/Assertions.h"
 #include "common/Pcsx2Defs.h"
 
+#include "PacketPool.h"
+
 namespace PacketReader
 {
-	class Payload
+	class Payload : public PacketPool::PooledObject
 	{
 	public:
 		virtual int GetLength() = 0;
@@ -24,26 +26,29 @@ namespace PacketReader
 	class PayloadData : public Payload
 	{
 	public:
-		std::unique_ptr<u8[]> data;
+		PacketPool::BufferPtr data;
 
 	private:
 		int length;
 
 	public:
 		PayloadData(int len)
-			: length{len}
+			: data{PacketPool::MakeBuffer(len)}
+			, length{len}
+		{
+		}
+		//Takes ownership of buffer, which holds at least len bytes
+		PayloadData(PacketPool::BufferPtr buffer, int len)
+			: data{std::move(buffer)}
+			, length{len}
 		{
-			if (len != 0)
-				data = std::make_unique<u8[]>(len);
 		}
 		PayloadData(const PayloadData& original)
-			: length{original.length}
+			: data{PacketPool::MakeBuffer(original.length)}
+			, length{original.length}
 		{
 			if (length != 0)
-			{
-				data = std::make_unique<u8[]>(length);
 				memcpy(data.get(), original.data.get(), length);
-			}
 		}
 		virtual int GetLength()
 		{
@@ -1,6 +1,10 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#ifdef __POSIX__
+#define INVALID_SOCKET -1
+#endif
+
 #include "BaseSession.h"
 
 namespace Sessions
@@ -28,6 +32,17 @@ namespace Sessions
 		connectionClosedHandlers.push_back(handler);
 	}
 
+	// By default, Recv() is called on every poll.
+	PollSocket BaseSession::GetRecvSocket()
+	{
+		return INVALID_SOCKET;
+	}
+
+	bool BaseSession::HasPendingRecv()
+	{
+		return true;
+	}
+
 	void BaseSession::RaiseEventConnectionClosed()
 	{
 		std::vector<ConnectionClosedEventHandler> Handlers = connectionClosedHandlers;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "DEV9/PacketReader/IP/IP_Packet.h"
+#include "DEV9/SocketPoller.h"
 #include <functional>
 #include <optional>
 #include <vector>
@@ -53,6 +54,12 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload) = 0;
 		virtual void Reset() = 0;
 
+		// Socket Recv() reads from, Recv() only needs calling once it is readable.
+		// Invalid if the session has no socket of its own.
+		virtual PollSocket GetRecvSocket();
+		// True if Recv() has work that isn't waiting on the socket.
+		virtual bool HasPendingRecv();
+
 		virtual ~BaseSession() {}
 
 	protected:
@@ -81,6 +81,9 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
+		virtual PollSocket GetRecvSocket();
+		virtual bool HasPendingRecv();
+
 		virtual ~TCP_Session();
 
 	private:
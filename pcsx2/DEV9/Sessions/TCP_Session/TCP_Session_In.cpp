@@ -84,7 +84,7 @@ namespace Sessions
 
 		if (maxSize > 0)
 		{
-			std::unique_ptr<u8[]> buffer;
+			PacketPool::BufferPtr buffer;
 			int err = 0;
 			int recived;
 
@@ -101,7 +101,8 @@ namespace Sessions
 				if (available > static_cast<uint>(maxSize))
 					Console.WriteLn("DEV9: TCP: Got a lot of data: %lu using: %d", available, maxSize);
 
-				buffer = std::make_unique<u8[]>(maxSize);
+				// Receive straight into the payload buffer
+				buffer = PacketPool::MakeBuffer(maxSize);
 				recived = recv(client, reinterpret_cast<char*>(buffer.get()), maxSize, 0);
 				if (recived == -1)
 #ifdef _WIN32
@@ -165,8 +166,7 @@ namespace Sessions
 				}
 				DevCon.WriteLn("DEV9: TCP: [SRV] Sending %d bytes", recived);
 
-				PayloadData* recivedData = new PayloadData(recived);
-				memcpy(recivedData->data.get(), buffer.get(), recived);
+				PayloadData* recivedData = new PayloadData(std::move(buffer), recived);
 
 				std::unique_ptr<TCP_Packet> iRet = CreateBasePacket(recivedData);
 				IncrementMyNumber(static_cast<u32>(recived));
@@ -183,6 +183,20 @@ namespace Sessions
 		return std::nullopt;
 	}
 
+	PollSocket TCP_Session::GetRecvSocket()
+	{
+		return client;
+	}
+
+	bool TCP_Session::HasPendingRecv()
+	{
+		// Packets from the send side, a connect waiting on writability, or the final close.
+		// Checked from the recv thread, which can only see a false positive here.
+		return !_recvBuff.IsQueueEmpty() ||
+			   state == TCP_State::SendingSYN_ACK ||
+			   state == TCP_State::CloseCompletedFlushBuffer;
+	}
+
 	std::optional<ReceivedPayload> TCP_Session::ConnectTCPComplete(bool success)
 	{
 		if (success)
@@ -135,8 +135,7 @@ namespace Sessions::UDP_Common
 		else if (FD_ISSET(client, &sReady))
 		{
 			unsigned long available = 0;
-			PayloadData* recived = nullptr;
-			std::unique_ptr<u8[]> buffer;
+			PacketPool::BufferPtr buffer;
 			sockaddr_in endpoint{};
 
 			// FIONREAD returns total size of all available messages
@@ -148,7 +147,8 @@ namespace Sessions::UDP_Common
 #endif
 			if (ret != SOCKET_ERROR)
 			{
-				buffer = std::make_unique<u8[]>(available);
+				// Receive straight into the payload buffer
+				buffer = PacketPool::MakeBuffer(available);
 
 #ifdef _WIN32
 				int fromlen = sizeof(endpoint);
@@ -179,8 +179,7 @@ namespace Sessions::UDP_Common
 #endif
 			}
 
-			recived = new PayloadData(ret);
-			memcpy(recived->data.get(), buffer.get(), ret);
+			PayloadData* recived = new PayloadData(std::move(buffer), ret);
 
 			std::unique_ptr<UDP_Packet> iRet = std::make_unique<UDP_Packet>(recived);
 			iRet->destinationPort = port;
@@ -124,6 +124,16 @@ namespace Sessions
 		return std::nullopt;
 	}
 
+	PollSocket UDP_FixedPort::GetRecvSocket()
+	{
+		return client;
+	}
+
+	bool UDP_FixedPort::HasPendingRecv()
+	{
+		return false;
+	}
+
 	bool UDP_FixedPort::Send(PacketReader::IP::IP_Payload* payload)
 	{
 		pxAssert(false);
@@ -41,6 +41,8 @@ namespace Sessions
 		void Init();
 
 		virtual std::optional<ReceivedPayload> Recv();
+		virtual PollSocket GetRecvSocket();
+		virtual bool HasPendingRecv();
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
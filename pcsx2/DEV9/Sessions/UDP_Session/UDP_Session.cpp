@@ -97,6 +97,18 @@ namespace Sessions
 		return std::nullopt;
 	}
 
+	PollSocket UDP_Session::GetRecvSocket()
+	{
+		// Fixed port sessions share the socket of their UDP_FixedPort, which does the receiving.
+		return isFixedPort ? INVALID_SOCKET : client;
+	}
+
+	bool UDP_Session::HasPendingRecv()
+	{
+		// Only the idle timeout, which doesn't need checking on every poll.
+		return false;
+	}
+
 	bool UDP_Session::WillRecive(IP_Address parDestIP)
 	{
 		if (!open.load())
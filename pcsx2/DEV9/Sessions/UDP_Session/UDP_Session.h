@@ -47,6 +47,8 @@ namespace Sessions
 #endif
 
 		virtual std::optional<ReceivedPayload> Recv();
+		virtual PollSocket GetRecvSocket();
+		virtual bool HasPendingRecv();
 		virtual bool WillRecive(PacketReader::IP::IP_Address parDestIP);
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "common/Console.h"
+
+#include <algorithm>
+
+#ifdef __POSIX__
+#define INVALID_SOCKET -1
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#include "SocketPoller.h"
+
+SocketPoller::SocketPoller()
+{
+#ifdef __linux__
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFd == -1)
+		Console.Error("DEV9: Socket: epoll_create1 failed, falling back to poll. Error: %d", errno);
+#endif
+}
+
+SocketPoller::~SocketPoller()
+{
+#ifdef __linux__
+	if (epollFd != -1)
+		::close(epollFd);
+#endif
+}
+
+void SocketPoller::Update(const void* owner, PollSocket socket)
+{
+	std::lock_guard lock(accessMutex);
+
+	auto search = ownerSockets.find(owner);
+	if (search != ownerSockets.end())
+	{
+		if (search->second == socket)
+			return;
+		RemoveLocked(owner);
+	}
+
+	if (socket == INVALID_SOCKET)
+		return;
+
+	//The socket number may have been closed by its previous owner and reused
+	auto previous = socketOwners.find(socket);
+	if (previous != socketOwners.end())
+		ownerSockets.erase(previous->second);
+
+	socketOwners[socket] = owner;
+	ownerSockets[owner] = socket;
+
+#ifdef __linux__
+	if (epollFd != -1)
+	{
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.fd = socket;
+		//A closed socket drops out of the epoll set by itself, but a reused one may still be there
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event) == -1 &&
+			(errno != EEXIST || epoll_ctl(epollFd, EPOLL_CTL_MOD, socket, &event) == -1))
+			Console.Error("DEV9: Socket: epoll_ctl failed. Error: %d", errno);
+	}
+#endif
+}
+
+void SocketPoller::Remove(const void* owner)
+{
+	std::lock_guard lock(accessMutex);
+	RemoveLocked(owner);
+}
+
+void SocketPoller::RemoveLocked(const void* owner)
+{
+	auto search = ownerSockets.find(owner);
+	if (search == ownerSockets.end())
+		return;
+
+	const PollSocket socket = search->second;
+	ownerSockets.erase(search);
+
+	//Leave the socket alone if it has been reused by another owner
+	auto ownerSearch = socketOwners.find(socket);
+	if (ownerSearch == socketOwners.end() || ownerSearch->second != owner)
+		return;
+
+	socketOwners.erase(ownerSearch);
+#ifdef __linux__
+	//Fails if the socket was already closed, which is fine
+	if (epollFd != -1)
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);
+#endif
+}
+
+void SocketPoller::Poll(std::vector<PollSocket>* ready)
+{
+	ready->clear();
+
+#ifdef __linux__
+	if (epollFd != -1)
+	{
+		//Level triggered, any sockets which don't fit are reported on the next poll
+		epoll_event events[256];
+		const int count = epoll_wait(epollFd, events, static_cast<int>(std::size(events)), 0);
+		if (count == -1 && errno != EINTR)
+			Console.Error("DEV9: Socket: epoll_wait failed. Error: %d", errno);
+
+		for (int i = 0; i < count; i++)
+			ready->push_back(events[i].data.fd);
+
+		std::sort(ready->begin(), ready->end());
+		return;
+	}
+#endif
+
+#ifdef _WIN32
+	std::vector<WSAPOLLFD> fds;
+#elif defined(__POSIX__)
+	std::vector<pollfd> fds;
+#endif
+	{
+		std::lock_guard lock(accessMutex);
+		fds.reserve(socketOwners.size());
+		for (const auto& [socket, owner] : socketOwners)
+			fds.push_back({socket, POLLIN, 0});
+	}
+
+	if (fds.empty())
+		return;
+
+#ifdef _WIN32
+	const int count = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), 0);
+#elif defined(__POSIX__)
+	const int count = poll(fds.data(), static_cast<nfds_t>(fds.size()), 0);
+#endif
+	if (count <= 0)
+		return;
+
+	for (const auto& fd : fds)
+	{
+		if (fd.revents != 0)
+			ready->push_back(fd.fd);
+	}
+
+	std::sort(ready->begin(), ready->end());
+}
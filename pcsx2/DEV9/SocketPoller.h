@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#include <winsock2.h>
+#endif
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Pcsx2Defs.h"
+
+#ifdef _WIN32
+typedef SOCKET PollSocket;
+#elif defined(__POSIX__)
+typedef int PollSocket;
+#endif
+
+//Reports which of a set of sockets are readable (or have an error pending), in one call
+//Uses epoll on Linux, where sockets stay registered with the kernel between polls,
+//and poll()/WSAPoll() elsewhere
+class SocketPoller
+{
+	std::mutex accessMutex;
+
+	//Each owner (a session) has up to one socket
+	std::unordered_map<const void*, PollSocket> ownerSockets;
+	std::unordered_map<PollSocket, const void*> socketOwners;
+
+#ifdef __linux__
+	int epollFd = -1;
+#endif
+
+public:
+	SocketPoller();
+	~SocketPoller();
+
+	//Sets the socket polled for owner, an invalid socket stops polling it
+	//Cheap when the socket hasn't changed
+	void Update(const void* owner, PollSocket socket);
+	//Must be called before owner is freed
+	void Remove(const void* owner);
+
+	//Fills ready with the readable sockets, sorted, without blocking
+	void Poll(std::vector<PollSocket>* ready);
+
+private:
+	void RemoveLocked(const void* owner);
+};
@@ -66,6 +66,21 @@ public:
 		return keys;
 	}
 
+	//Calls func on every value with the map locked for reading
+	//func must not modify the map
+	template <typename Func>
+	void ForEachValue(Func func)
+	{
+#ifdef NO_SHARED_MUTEX
+		std::unique_lock readLock(accessMutex);
+#else
+		std::shared_lock readLock(accessMutex);
+#endif
+
+		for (auto iter = map.begin(); iter != map.end(); ++iter)
+			func(iter->second);
+	}
+
 	//Does not error or insert if no key is found
 	bool TryGetValue(Key key, T* value)
 	{
@@ -5,6 +5,8 @@
 #include "common/StringUtil.h"
 #include "common/ScopedGuard.h"
 
+#include <algorithm>
+
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
 #include <winsock2.h>
@@ -218,13 +220,31 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	if (!vRecBuffer.Dequeue(&bFrame))
 	{
 		std::lock_guard deletelock(deleteSendSentry);
-		std::vector<ConnectionKey> keys = connections.GetKeys();
-		for (size_t i = 0; i < keys.size(); i++)
+
+		// Sessions are registered with the poller while the map is locked, so one being
+		// closed on the send thread can't be registered again after it was removed.
+		recvSessions.clear();
+		connections.ForEachValue([this](BaseSession* session) {
+			recvSessions.push_back(session);
+			poller.Update(session, session->GetRecvSocket());
+		});
+		poller.Poll(&readySockets);
+
+		using namespace std::chrono_literals;
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const bool sweep = (now - lastRecvSweep) >= 1s;
+		if (sweep)
+			lastRecvSweep = now;
+
+		for (BaseSession* session : recvSessions)
 		{
-			const ConnectionKey key = keys[i];
+			if (!sweep && !session->HasPendingRecv() &&
+				!std::binary_search(readySockets.begin(), readySockets.end(), session->GetRecvSocket()))
+				continue;
 
-			BaseSession* session;
-			if (!connections.TryGetValue(key, &session))
+			// May have been closed since we listed it.
+			BaseSession* current;
+			if (!connections.TryGetValue(session->key, &current) || current != session)
 				continue;
 
 			std::optional<ReceivedPayload> pl = session->Recv();
@@ -541,6 +561,7 @@ void SocketAdapter::HandleConnectionClosed(BaseSession* sender)
 	const ConnectionKey key = sender->key;
 	if (!connections.Remove(key))
 		return;
+	poller.Remove(sender);
 
 	// Defer deleting the connection untill we have left the calling session's callstack
 	if (std::this_thread::get_id() == sendThreadId)
@@ -573,6 +594,7 @@ void SocketAdapter::HandleFixedPortClosed(BaseSession* sender)
 	const ConnectionKey key = sender->key;
 	if (!connections.Remove(key))
 		return;
+	poller.Remove(sender);
 	fixedUDPPorts.Remove(key.ps2Port);
 
 	// Defer deleting the connection untill we have left the calling session's callstack
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #pragma once
+#include <chrono>
 #include <mutex>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "PacketReader/EthernetFrame.h"
 #include "Sessions/BaseSession.h"
 #include "SimpleQueue.h"
+#include "SocketPoller.h"
 #include "ThreadSafeMap.h"
 
 class SocketAdapter : public NetAdapter
@@ -27,6 +29,13 @@ class SocketAdapter : public NetAdapter
 	ThreadSafeMap<Sessions::ConnectionKey, Sessions::BaseSession*> connections;
 	ThreadSafeMap<u16, Sessions::BaseSession*> fixedUDPPorts;
 
+	//Only sessions with a readable socket or pending work are asked for packets.
+	//All sessions get asked once in a while, to run their idle timeouts.
+	SocketPoller poller;
+	std::vector<Sessions::BaseSession*> recvSessions;
+	std::vector<PollSocket> readySockets;
+	std::chrono::steady_clock::time_point lastRecvSweep;
+
 	std::thread::id sendThreadId;
 	std::vector<Sessions::BaseSession*> deleteQueueSendThread;
 	std::vector<Sessions::BaseSession*> deleteQueueRecvThread;
@@ -6,8 +6,11 @@
 #include "MIPSAnalyst.h"
 #include <cstdio>
 #include "R5900.h"
+#include "R5900OpcodeTables.h"
 #include "R3000A.h"
 
+#include "common/Console.h"
+
 std::vector<BreakPoint> CBreakPoints::breakPoints_;
 u32 CBreakPoints::breakSkipFirstAtEE_ = 0;
 u32 CBreakPoints::breakSkipFirstAtIop_ = 0;
@@ -42,7 +45,6 @@ MemCheck::MemCheck()
 	, memCond(MEMCHECK_READWRITE)
 	, result(MEMCHECK_BOTH)
 	, cpu(BREAKPOINT_EE)
-	, numHits(0)
 	, lastPC(0)
 	, lastAddr(0)
 	, lastSize(0)
@@ -58,7 +60,7 @@ void MemCheck::Action(u32 addr, bool write, int size, u32 pc)
 	int mask = write ? MEMCHECK_WRITE : MEMCHECK_READ;
 	if (memCond & mask)
 	{
-		++numHits;
+		numHits.Increment();
 
 		Log(addr, write, size, pc);
 		if (result & MEMCHECK_BREAK)
@@ -98,7 +100,7 @@ void MemCheck::JitCleanup()
 	bool changed = MIPSAnalyst::OpWouldChangeMemory(lastPC, lastAddr);
 	if (changed)
 	{
-		++numHits;
+		numHits.Increment();
 		Log(lastAddr, true, lastSize, lastPC);
 	}
 
@@ -258,6 +260,7 @@ void CBreakPoints::ChangeBreakPointAddCond(BreakPointCpu cpu, u32 addr, const Br
 	{
 		breakPoints_[bp].hasCond = true;
 		breakPoints_[bp].cond = cond;
+		breakPoints_[bp].cond.Compile();
 		Update();
 	}
 }
@@ -362,6 +365,7 @@ void CBreakPoints::ChangeMemCheckAddCond(BreakPointCpu cpu, u32 start, u32 end,
 	{
 		memChecks_[mc].hasCond = true;
 		memChecks_[mc].cond = cond;
+		memChecks_[mc].cond.Compile();
 		Update(cpu);
 	}
 }
@@ -506,3 +510,46 @@ void CBreakPoints::Update(BreakPointCpu cpu, u32 addr)
 	if (resume)
 		r5900Debug.resumeCpu();
 }
+
+u32 MemCheckWatch::GetAccessPC(u32 resume_pc, u32 op)
+{
+	return (R5900::GetInstruction(op).flags & IS_BRANCH) ? resume_pc + 4 : resume_pc;
+}
+
+bool MemCheckWatch::Check(std::vector<MemCheck>& checks, u32 addr, u32 size, bool write)
+{
+	// Blocks add their cycles when they end, so only the retried access has the same pc and cycle count.
+	const u32 pc = cpuRegs.pc;
+	if (m_stopped && m_stopped_pc == pc && m_stopped_cycle == cpuRegs.cycle)
+		return false;
+
+	// logic: memAddress < bpEnd && bpStart < memAddress+memSize
+	const u32 start = standardizeBreakpointAddress(addr);
+	const u32 end = start + size;
+	const int mask = write ? MEMCHECK_WRITE : MEMCHECK_READ;
+	bool stop = false;
+	for (MemCheck& mc : checks)
+	{
+		if (mc.result == MEMCHECK_IGNORE || !(mc.memCond & mask))
+			continue;
+		if (start >= standardizeBreakpointAddress(mc.end) || standardizeBreakpointAddress(mc.start) >= end)
+			continue;
+		if (mc.hasCond && !mc.cond.Evaluate())
+			continue;
+
+		mc.numHits.Increment();
+		if (mc.result & MEMCHECK_LOG)
+			DevCon.WriteLn("Hit %s breakpoint @0x%x (0x%x, %u bytes)", write ? "store" : "load", GetAccessPC(pc, r5900Debug.Read32(pc)), addr, size);
+		if (mc.result & MEMCHECK_BREAK)
+			stop = true;
+	}
+
+	if (stop)
+	{
+		m_stopped = true;
+		m_stopped_pc = pc;
+		m_stopped_cycle = cpuRegs.cycle;
+	}
+
+	return stop;
+}
@@ -4,24 +4,63 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 #include "DebugInterface.h"
 #include "common/Pcsx2Types.h"
 
+// The CPUs check copies of the breakpoints taken when they're reset, while the debugger lists the
+// entries in CBreakPoints, so counts are shared between an entry and its copies.
+class BreakPointCounter
+{
+public:
+	u64 Get() const { return m_count->load(std::memory_order_relaxed); }
+	void Increment() { m_count->fetch_add(1, std::memory_order_relaxed); }
+
+	// Copies taken before this keep counting into the old storage until they're replaced.
+	void Reset() { m_count = std::make_shared<std::atomic<u64>>(0); }
+
+private:
+	std::shared_ptr<std::atomic<u64>> m_count = std::make_shared<std::atomic<u64>>(0);
+};
+
 struct BreakPointCond
 {
 	DebugInterface* debug = nullptr;
 	PostfixExpression expression;
 	std::string expressionString;
 
+	// Built from expression once the condition is set, conditions on hot code are checked very often.
+	CompiledExpression compiled;
+
+	// Since the condition was set.
+	BreakPointCounter evaluations;
+	BreakPointCounter hits;
+
+	void Compile()
+	{
+		std::string error;
+		compiled.clear();
+		evaluations.Reset();
+		hits.Reset();
+		if (debug)
+			debug->compileExpression(expression, compiled, error);
+	}
+
 	u32 Evaluate()
 	{
 		u64 result;
 		std::string error;
-		if (!debug->parseExpression(expression, result, error) || result == 0)
+		evaluations.Increment();
+		// Expressions which fail to compile would fail to evaluate too, the interpreter reports that.
+		const bool valid = compiled.empty() ? debug->parseExpression(expression, result, error) :
+		                                      debug->parseExpression(compiled, result, error);
+		if (!valid || result == 0)
 			return 0;
+		hits.Increment();
 		return 1;
 	}
 };
@@ -82,7 +121,7 @@ struct MemCheck
 
 	std::string description;
 
-	u32 numHits;
+	BreakPointCounter numHits;
 
 	u32 lastPC;
 	u32 lastAddr;
@@ -182,6 +221,25 @@ private:
 	static std::vector<MemCheck*> cleanupMemChecks_;
 };
 
+// Checks EE accesses against memchecks for the recompiler, which stops before the access and retries it
+// on resume. cpuRegs has to be written back, with the pc where execution resumes: the access itself, or
+// the branch when the access is in its delay slot.
+class MemCheckWatch
+{
+public:
+	// The instruction making the access, op being the instruction at the resume pc.
+	static u32 GetAccessPC(u32 resume_pc, u32 op);
+
+	// Returns true if execution should stop before the access.
+	bool Check(std::vector<MemCheck>& checks, u32 addr, u32 size, bool write);
+
+private:
+	// The access execution stopped before, so the retry doesn't stop again.
+	bool m_stopped = false;
+	u32 m_stopped_pc = 0;
+	u64 m_stopped_cycle = 0;
+};
+
 
 // called from the dynarec
 u32 standardizeBreakpointAddress(u32 addr);
@@ -159,6 +159,18 @@ bool DebugInterface::parseExpression(PostfixExpression& exp, u64& dest, std::str
 	return parsePostfixExpression(exp, &funcs, dest, error);
 }
 
+bool DebugInterface::compileExpression(const PostfixExpression& exp, CompiledExpression& dest, std::string& error)
+{
+	MipsExpressionFunctions funcs(this, nullptr, false);
+	return dest.compile(exp, &funcs, error);
+}
+
+bool DebugInterface::parseExpression(const CompiledExpression& exp, u64& dest, std::string& error)
+{
+	MipsExpressionFunctions funcs(this, nullptr, false);
+	return exp.evaluate(&funcs, dest, error);
+}
+
 DebugInterface& DebugInterface::get(BreakPointCpu cpu)
 {
 	switch (cpu)
@@ -1393,6 +1405,42 @@ ExpressionType MipsExpressionFunctions::getReferenceType(u64 referenceIndex)
 	return EXPR_TYPE_UINT;
 }
 
+const void* MipsExpressionFunctions::getReferencePointer(u64 referenceIndex, int& size)
+{
+	// Must read the same values as getReferenceValue.
+	switch (m_cpu->getCpuType())
+	{
+		case BREAKPOINT_EE:
+			size = 8;
+			if (referenceIndex < 32)
+				return &cpuRegs.GPR.r[referenceIndex].UD[0];
+			if (referenceIndex == REF_INDEX_HI)
+				return &cpuRegs.HI.UD[0];
+			if (referenceIndex == REF_INDEX_LO)
+				return &cpuRegs.LO.UD[0];
+			size = 4;
+			if (referenceIndex == REF_INDEX_PC)
+				return &cpuRegs.pc;
+			if (!(referenceIndex & REF_INDEX_IS_OPSL) && (referenceIndex & REF_INDEX_FPU))
+				return &fpuRegs.fpr[referenceIndex & 0x1F].UL;
+			break;
+		case BREAKPOINT_IOP:
+			size = 4;
+			if (referenceIndex < 32)
+				return &psxRegs.GPR.r[referenceIndex];
+			if (referenceIndex == REF_INDEX_HI)
+				return &psxRegs.GPR.n.hi;
+			if (referenceIndex == REF_INDEX_LO)
+				return &psxRegs.GPR.n.lo;
+			if (referenceIndex == REF_INDEX_PC)
+				return &psxRegs.pc;
+			break;
+		default:
+			break;
+	}
+	return nullptr;
+}
+
 bool MipsExpressionFunctions::getMemoryValue(u32 address, int size, u64& dest, std::string& error)
 {
 	switch (size)
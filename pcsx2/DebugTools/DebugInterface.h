@@ -88,6 +88,8 @@ public:
 	bool evaluateExpression(const char* expression, u64& dest, std::string& error);
 	bool initExpression(const char* exp, PostfixExpression& dest, std::string& error);
 	bool parseExpression(PostfixExpression& exp, u64& dest, std::string& error);
+	bool compileExpression(const PostfixExpression& exp, CompiledExpression& dest, std::string& error);
+	bool parseExpression(const CompiledExpression& exp, u64& dest, std::string& error);
 
 	static void setPauseOnEntry(bool pauseOnEntry) { m_pause_on_entry = pauseOnEntry; };
 	static bool getPauseOnEntry() { return m_pause_on_entry; }
@@ -229,6 +231,7 @@ public:
 	u64 getReferenceValue(u64 referenceIndex) override;
 	ExpressionType getReferenceType(u64 referenceIndex) override;
 	bool getMemoryValue(u32 address, int size, u64& dest, std::string& error) override;
+	const void* getReferencePointer(u64 referenceIndex, int& size) override;
 
 protected:
 	void enumerateSymbols(const ccc::SymbolDatabase& database);
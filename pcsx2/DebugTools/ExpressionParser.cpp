@@ -6,6 +6,7 @@
 #include "Host.h"
 #include "common/StringUtil.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
 #include <cstring>
@@ -614,3 +615,356 @@ bool parseExpression(const char* exp, IExpressionFunctions* funcs, u64& dest, st
 	if (!initPostfixExpression(exp,funcs,postfix,error)) return false;
 	return parsePostfixExpression(postfix,funcs,dest,error);
 }
+
+typedef enum {
+	COP_CONST, COP_REF, COP_REF32, COP_REF64, COP_MEM, COP_MEMSIZE, COP_DROP,
+	COP_NEG, COP_FNEG, COP_BITNOT, COP_LOGNOT, COP_MUL, COP_FMUL, COP_DIV, COP_FDIV, COP_MOD,
+	COP_ADD, COP_FADD, COP_SUB, COP_FSUB, COP_SHL, COP_SHR, COP_GREATEREQUAL, COP_FGREATEREQUAL,
+	COP_GREATER, COP_FGREATER, COP_LOWEREQUAL, COP_FLOWEREQUAL, COP_LOWER, COP_FLOWER,
+	COP_EQUAL, COP_FEQUAL, COP_NOTEQUAL, COP_FNOTEQUAL, COP_BITAND, COP_XOR, COP_BITOR,
+	COP_LOGAND, COP_LOGOR, COP_SELECT
+} CompiledOpcodeType;
+
+// Integer and float versions of the operators, the float one is used once a float has been seen.
+static bool getCompiledOpcode(u64 opcode, bool useFloat, u32& type)
+{
+	switch (opcode)
+	{
+	case EXOP_MEM:          type = COP_MEM; break;
+	case EXOP_SIGNPLUS:     type = COP_DROP; break; // the interpreter doesn't push the operand back
+	case EXOP_SIGNMINUS:    type = useFloat ? COP_FNEG : COP_NEG; break;
+	case EXOP_BITNOT:       type = COP_BITNOT; break;
+	case EXOP_LOGNOT:       type = COP_LOGNOT; break;
+	case EXOP_MUL:          type = useFloat ? COP_FMUL : COP_MUL; break;
+	case EXOP_DIV:          type = useFloat ? COP_FDIV : COP_DIV; break;
+	case EXOP_MOD:          type = COP_MOD; break;
+	case EXOP_ADD:          type = useFloat ? COP_FADD : COP_ADD; break;
+	case EXOP_SUB:          type = useFloat ? COP_FSUB : COP_SUB; break;
+	case EXOP_SHL:          type = COP_SHL; break;
+	case EXOP_SHR:          type = COP_SHR; break;
+	case EXOP_GREATEREQUAL: type = useFloat ? COP_FGREATEREQUAL : COP_GREATEREQUAL; break;
+	case EXOP_GREATER:      type = useFloat ? COP_FGREATER : COP_GREATER; break;
+	case EXOP_LOWEREQUAL:   type = useFloat ? COP_FLOWEREQUAL : COP_LOWEREQUAL; break;
+	case EXOP_LOWER:        type = useFloat ? COP_FLOWER : COP_LOWER; break;
+	case EXOP_EQUAL:        type = useFloat ? COP_FEQUAL : COP_EQUAL; break;
+	case EXOP_NOTEQUAL:     type = useFloat ? COP_FNOTEQUAL : COP_NOTEQUAL; break;
+	case EXOP_BITAND:       type = COP_BITAND; break;
+	case EXOP_XOR:          type = COP_XOR; break;
+	case EXOP_BITOR:        type = COP_BITOR; break;
+	case EXOP_LOGAND:       type = COP_LOGAND; break;
+	case EXOP_LOGOR:        type = COP_LOGOR; break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+void CompiledExpression::clear()
+{
+	m_ops.clear();
+	m_stack_size = 0;
+}
+
+bool CompiledExpression::compile(const PostfixExpression& exp, IExpressionFunctions* funcs, std::string& error)
+{
+	clear();
+
+	// Whether an operator works on floats only depends on what came before it, and the stack
+	// depth at every point is fixed, so all of the interpreter's checks can be done here.
+	bool useFloat = false;
+	u32 depth = 0;
+
+	for (size_t num = 0; num < exp.size(); num++)
+	{
+		Op op = {};
+		u32 pushed = 1;
+
+		switch (exp[num].first)
+		{
+		case EXCOMM_CONST:
+			op.type = COP_CONST;
+			op.value = exp[num].second;
+			break;
+		case EXCOMM_CONST_FLOAT:
+			useFloat = true;
+			op.type = COP_CONST;
+			op.value = exp[num].second;
+			break;
+		case EXCOMM_REF:
+			{
+				useFloat = useFloat || funcs->getReferenceType(exp[num].second) == EXPR_TYPE_FLOAT;
+				int size = 0;
+				op.ptr = funcs->getReferencePointer(exp[num].second, size);
+				if (op.ptr && (size == 4 || size == 8))
+					op.type = (size == 8) ? COP_REF64 : COP_REF32;
+				else
+					op.type = COP_REF;
+				op.value = exp[num].second;
+			}
+			break;
+		case EXCOMM_OP:
+			{
+				const u64 opcode = exp[num].second;
+				if (opcode >= EXOP_COUNT)
+				{
+					error = TRANSLATE("ExpressionParser", "Invalid expression.");
+					clear();
+					return false;
+				}
+				if (depth < ExpressionOpcodes[opcode].args)
+				{
+					error = TRANSLATE("ExpressionParser", "Not enough arguments.");
+					clear();
+					return false;
+				}
+				depth -= ExpressionOpcodes[opcode].args;
+
+				if (opcode == EXOP_MEMSIZE)
+				{
+					if (++num >= exp.size() || exp[num].second != EXOP_MEM)
+					{
+						error = TRANSLATE("ExpressionParser", "Invalid memsize operator.");
+						clear();
+						return false;
+					}
+					op.type = COP_MEMSIZE;
+				}
+				else if (opcode == EXOP_TERTELSE)
+				{
+					if (++num >= exp.size() || exp[num].second != EXOP_TERTIF)
+					{
+						error = TRANSLATE("ExpressionParser", "Invalid tertiary operator.");
+						clear();
+						return false;
+					}
+					op.type = COP_SELECT;
+				}
+				else if (opcode == EXOP_TERTIF)
+				{
+					// Only valid straight after its else, which consumes it. No message, like the interpreter.
+					clear();
+					return false;
+				}
+				else if (!getCompiledOpcode(opcode, useFloat, op.type))
+				{
+					// Brackets never make it into a postfix expression.
+					continue;
+				}
+
+				if (op.type == COP_DROP)
+					pushed = 0;
+			}
+			break;
+		}
+
+		m_ops.push_back(op);
+		depth += pushed;
+		m_stack_size = std::max(m_stack_size, depth);
+	}
+
+	if (depth != 1)
+	{
+		error = TRANSLATE("ExpressionParser", "Invalid expression (Too many constants?)");
+		clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool CompiledExpression::evaluate(IExpressionFunctions* funcs, u64& dest, std::string& error) const
+{
+	if (m_ops.empty())
+	{
+		error = TRANSLATE("ExpressionParser", "Invalid expression.");
+		return false;
+	}
+
+	static constexpr u32 LOCAL_STACK_SIZE = 32;
+	if (m_stack_size <= LOCAL_STACK_SIZE)
+	{
+		u64 stack[LOCAL_STACK_SIZE];
+		return run(stack, funcs, dest, error);
+	}
+
+	std::vector<u64> stack(m_stack_size);
+	return run(stack.data(), funcs, dest, error);
+}
+
+bool CompiledExpression::run(u64* stack, IExpressionFunctions* funcs, u64& dest, std::string& error) const
+{
+	// Points past the top of the stack, operands were counted when compiling.
+	u64* sp = stack;
+
+	for (const Op& op : m_ops)
+	{
+		switch (op.type)
+		{
+		case COP_CONST:
+			*sp++ = op.value;
+			break;
+		case COP_REF:
+			*sp++ = funcs->getReferenceValue(op.value);
+			break;
+		case COP_REF32:
+			*sp++ = *static_cast<const u32*>(op.ptr);
+			break;
+		case COP_REF64:
+			*sp++ = *static_cast<const u64*>(op.ptr);
+			break;
+		case COP_MEM:
+			if (!funcs->getMemoryValue(static_cast<u32>(sp[-1]), 4, sp[-1], error))
+				return false;
+			break;
+		case COP_MEMSIZE:
+			sp--;
+			if (!funcs->getMemoryValue(static_cast<u32>(sp[-1]), static_cast<int>(sp[0]), sp[-1], error))
+				return false;
+			break;
+		case COP_DROP:
+			sp--;
+			break;
+		case COP_NEG:
+			sp[-1] = 0 - sp[-1];
+			break;
+		case COP_FNEG:
+			sp[-1] = 0.0 - static_cast<float>(sp[-1]);
+			break;
+		case COP_BITNOT:
+			sp[-1] = ~sp[-1];
+			break;
+		case COP_LOGNOT:
+			sp[-1] = !sp[-1];
+			break;
+		case COP_MUL:
+			sp--;
+			sp[-1] = sp[-1] * sp[0];
+			break;
+		case COP_FMUL:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) * static_cast<float>(sp[0]);
+			break;
+		case COP_DIV:
+		case COP_FDIV:
+			sp--;
+			if (sp[0] == 0)
+			{
+				error = TRANSLATE("ExpressionParser", "Division by zero.");
+				return false;
+			}
+			if (op.type == COP_FDIV)
+				sp[-1] = static_cast<float>(sp[-1]) / static_cast<float>(sp[0]);
+			else
+				sp[-1] = sp[-1] / sp[0];
+			break;
+		case COP_MOD:
+			sp--;
+			if (sp[0] == 0)
+			{
+				error = TRANSLATE("ExpressionParser", "Modulo by zero.");
+				return false;
+			}
+			sp[-1] = sp[-1] % sp[0];
+			break;
+		case COP_ADD:
+			sp--;
+			sp[-1] = sp[-1] + sp[0];
+			break;
+		case COP_FADD:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) + static_cast<float>(sp[0]);
+			break;
+		case COP_SUB:
+			sp--;
+			sp[-1] = sp[-1] - sp[0];
+			break;
+		case COP_FSUB:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) - static_cast<float>(sp[0]);
+			break;
+		case COP_SHL:
+			sp--;
+			sp[-1] = sp[-1] << sp[0];
+			break;
+		case COP_SHR:
+			sp--;
+			sp[-1] = sp[-1] >> sp[0];
+			break;
+		case COP_GREATEREQUAL:
+			sp--;
+			sp[-1] = sp[-1] >= sp[0];
+			break;
+		case COP_FGREATEREQUAL:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) >= static_cast<float>(sp[0]);
+			break;
+		case COP_GREATER:
+			sp--;
+			sp[-1] = sp[-1] > sp[0];
+			break;
+		case COP_FGREATER:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) > static_cast<float>(sp[0]);
+			break;
+		case COP_LOWEREQUAL:
+			sp--;
+			sp[-1] = sp[-1] <= sp[0];
+			break;
+		case COP_FLOWEREQUAL:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) <= static_cast<float>(sp[0]);
+			break;
+		case COP_LOWER:
+			sp--;
+			sp[-1] = sp[-1] < sp[0];
+			break;
+		case COP_FLOWER:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) < static_cast<float>(sp[0]);
+			break;
+		case COP_EQUAL:
+			sp--;
+			sp[-1] = sp[-1] == sp[0];
+			break;
+		case COP_FEQUAL:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) == static_cast<float>(sp[0]);
+			break;
+		case COP_NOTEQUAL:
+			sp--;
+			sp[-1] = sp[-1] != sp[0];
+			break;
+		case COP_FNOTEQUAL:
+			sp--;
+			sp[-1] = static_cast<float>(sp[-1]) != static_cast<float>(sp[0]);
+			break;
+		case COP_BITAND:
+			sp--;
+			sp[-1] = sp[-1] & sp[0];
+			break;
+		case COP_XOR:
+			sp--;
+			sp[-1] = sp[-1] ^ sp[0];
+			break;
+		case COP_BITOR:
+			sp--;
+			sp[-1] = sp[-1] | sp[0];
+			break;
+		case COP_LOGAND:
+			sp--;
+			sp[-1] = sp[-1] && sp[0];
+			break;
+		case COP_LOGOR:
+			sp--;
+			sp[-1] = sp[-1] || sp[0];
+			break;
+		case COP_SELECT:
+			sp -= 2;
+			sp[-1] = sp[-1] ? sp[0] : sp[1];
+			break;
+		}
+	}
+
+	dest = stack[0];
+	return true;
+}
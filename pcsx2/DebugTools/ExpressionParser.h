@@ -24,6 +24,35 @@ public:
 	virtual u64 getReferenceValue(u64 referenceIndex) = 0;
 	virtual ExpressionType getReferenceType(u64 referenceIndex) = 0;
 	virtual bool getMemoryValue(u32 address, int size, u64& dest, std::string& error) = 0;
+
+	// Where the value of a reference is stored, so compiled expressions can read it directly.
+	// Returns null for references which have to be computed through getReferenceValue.
+	virtual const void* getReferencePointer(u64 referenceIndex, int& size) { return nullptr; }
+};
+
+// A postfix expression checked and resolved once, for expressions evaluated over and over such as
+// breakpoint conditions. Evaluation gives the same results as parsePostfixExpression, without allocating.
+class CompiledExpression
+{
+public:
+	bool compile(const PostfixExpression& exp, IExpressionFunctions* funcs, std::string& error);
+	bool evaluate(IExpressionFunctions* funcs, u64& dest, std::string& error) const;
+
+	bool empty() const { return m_ops.empty(); }
+	void clear();
+
+private:
+	struct Op
+	{
+		u32 type;
+		u64 value;
+		const void* ptr;
+	};
+
+	bool run(u64* stack, IExpressionFunctions* funcs, u64& dest, std::string& error) const;
+
+	std::vector<Op> m_ops;
+	u32 m_stack_size = 0;
 };
 
 bool initPostfixExpression(const char* infix, IExpressionFunctions* funcs, PostfixExpression& dest, std::string& error);
@@ -9,6 +9,8 @@
 #include "R5900.h"
 #include "R5900OpcodeTables.h"
 
+#include <algorithm>
+
 #define MIPS_MAKE_J(addr)   (0x08000000 | ((addr)>>2))
 #define MIPS_MAKE_JAL(addr) (0x0C000000 | ((addr)>>2))
 #define MIPS_MAKE_JR_RA()   (0x03e00008)
@@ -175,18 +177,36 @@ namespace MIPSAnalyst
 		return furthestJumpbackAddr;
 	}
 
-	void ScanForFunctions(ccc::SymbolDatabase& database, MemoryInterface& reader, u32 startAddr, u32 endAddr, bool generateHashes) {
-		std::vector<MIPSAnalyst::AnalyzedFunction> functions;
-		AnalyzedFunction currentFunction = {startAddr};
-
-		u32 furthestBranch = 0;
-		bool looking = false;
-		bool end = false;
-		bool isStraightLeaf = true;
-		bool suspectedNoReturn = false;
-
+	struct FunctionScanState {
 		u32 addr;
-		for (addr = startAddr; addr < endAddr; addr += 4) {
+		AnalyzedFunction currentFunction;
+		u32 furthestBranch;
+		bool looking;
+		bool end;
+		bool isStraightLeaf;
+		bool suspectedNoReturn;
+	};
+
+	static FunctionScanState BeginFunctionScan(u32 startAddr) {
+		FunctionScanState state = {};
+		state.addr = startAddr;
+		state.currentFunction.start = startAddr;
+		state.isStraightLeaf = true;
+		return state;
+	}
+
+	// Scans up to endAddr. The state can be passed back in to carry on scanning past it.
+	static void ScanFunctionRange(const ccc::SymbolDatabase& database, MemoryInterface& reader, FunctionScanState& state,
+		u32 endAddr, std::vector<AnalyzedFunction>& functions) {
+		u32& addr = state.addr;
+		AnalyzedFunction& currentFunction = state.currentFunction;
+		u32& furthestBranch = state.furthestBranch;
+		bool& looking = state.looking;
+		bool& end = state.end;
+		bool& isStraightLeaf = state.isStraightLeaf;
+		bool& suspectedNoReturn = state.suspectedNoReturn;
+
+		for (; addr < endAddr; addr += 4) {
 			// Use pre-existing symbol map info if available. May be more reliable.
 			ccc::FunctionHandle existing_symbol_handle = database.functions.first_handle_from_starting_address(addr);
 			const ccc::Function* existing_symbol = database.functions.symbol_from_handle(existing_symbol_handle);
@@ -306,16 +326,106 @@ namespace MIPSAnalyst
 			}
 		}
 
-		currentFunction.end = addr + 4;
-		functions.push_back(currentFunction);
-		
+	}
+
+	// The scan starts over whenever it reaches an existing function, so the range is split at existing
+	// functions and each piece is scanned in parallel as if it started there. Pieces are then joined in
+	// order, and a piece the scan of the previous one doesn't arrive at cleanly gets scanned again.
+	static std::vector<u32> GetFunctionScanSplits(const ccc::SymbolDatabase& database, u32 startAddr, u32 endAddr,
+		u32 maxPieces) {
+		static constexpr u32 MIN_PIECE_SIZE = 0x4000;
+
+		std::vector<u32> splits = {startAddr};
+		if (endAddr <= startAddr || maxPieces <= 1)
+			return splits;
+
+		std::vector<u32> candidates;
+		for (auto [address, handle] : database.functions.handles_from_address_range(ccc::AddressRange(startAddr + 4, endAddr))) {
+			const ccc::Function* function = database.functions.symbol_from_handle(
+				database.functions.first_handle_from_starting_address(address));
+			if (function && function->size() > 0 && (candidates.empty() || candidates.back() != address))
+				candidates.push_back(address);
+		}
+
+		const u32 pieceSize = std::max(MIN_PIECE_SIZE, (endAddr - startAddr) / maxPieces);
+		for (u32 target = startAddr + pieceSize; target < endAddr && target > startAddr; target += pieceSize) {
+			auto candidate = std::lower_bound(candidates.begin(), candidates.end(), std::max(target, splits.back() + 4));
+			if (candidate == candidates.end())
+				break;
+			splits.push_back(*candidate);
+			if (splits.size() == maxPieces)
+				break;
+		}
+
+		return splits;
+	}
+
+	std::vector<AnalyzedFunction> AnalyzeFunctions(const ccc::SymbolDatabase& database, MemoryInterface& reader,
+		u32 startAddr, u32 endAddr, bool generateHashes, const std::atomic_bool* interrupt, u32 maxPieces) {
+		std::vector<u32> splits = GetFunctionScanSplits(database, startAddr, endAddr, maxPieces);
+		const size_t pieces = splits.size();
+		splits.push_back(endAddr);
+
+		std::vector<std::vector<AnalyzedFunction>> pieceFunctions(pieces);
+		std::vector<FunctionScanState> pieceStates(pieces);
+		SymbolGuardian::ParallelFor(pieces, 1, [&](size_t i) {
+			if (interrupt && *interrupt)
+				return;
+
+			pieceStates[i] = BeginFunctionScan(splits[i]);
+			ScanFunctionRange(database, reader, pieceStates[i], splits[i + 1], pieceFunctions[i]);
+		});
+
+		if (interrupt && *interrupt)
+			return {};
+
+		std::vector<AnalyzedFunction> functions = std::move(pieceFunctions[0]);
+		FunctionScanState state = pieceStates[0];
+		for (size_t i = 1; i < pieces; i++) {
+			// Reaching an existing function resets everything but these.
+			if (state.addr == splits[i] && state.isStraightLeaf && !state.suspectedNoReturn) {
+				if (pieceFunctions[i].empty()) {
+					pieceStates[i].currentFunction.isStraightLeaf = state.currentFunction.isStraightLeaf;
+					pieceStates[i].currentFunction.suspectedNoReturn = state.currentFunction.suspectedNoReturn;
+				}
+
+				functions.insert(functions.end(), pieceFunctions[i].begin(), pieceFunctions[i].end());
+				state = pieceStates[i];
+			} else {
+				ScanFunctionRange(database, reader, state, splits[i + 1], functions);
+			}
+		}
+
+		state.currentFunction.end = state.addr + 4;
+		functions.push_back(state.currentFunction);
+
+		// Only functions which are going to be created get hashed.
+		if (generateHashes) {
+			SymbolGuardian::ParallelFor(functions.size(), 256, [&](size_t i) {
+				AnalyzedFunction& function = functions[i];
+				if (database.functions.first_handle_from_starting_address(function.start).valid())
+					return;
+
+				std::optional<ccc::FunctionHash> hash = SymbolGuardian::HashFunction(
+					function.start, function.end - function.start + 4, reader);
+				function.hasHash = hash.has_value();
+				function.hash = hash.has_value() ? hash->get() : 0;
+			});
+		}
+
+		return functions;
+	}
+
+	void CreateFunctions(ccc::SymbolDatabase& database, MemoryInterface& reader, const AnalyzedFunction* functions,
+		size_t count, bool generateHashes) {
 		ccc::Result<ccc::SymbolSourceHandle> source = database.get_symbol_source("Function Scanner");
 		if (!source.success()) {
 			Console.Error("MIPSAnalyst: %s", source.error().message.c_str());
 			return;
 		}
 
-		for (const AnalyzedFunction& function : functions) {
+		for (size_t i = 0; i < count; i++) {
+			const AnalyzedFunction& function = functions[i];
 			ccc::FunctionHandle handle = database.functions.first_handle_from_starting_address(function.start);
 			ccc::Function* symbol = database.functions.symbol_from_handle(handle);
 			bool generateHash = false;
@@ -353,7 +463,9 @@ namespace MIPSAnalyst
 				symbol->set_size(function.end - function.start + 4);
 			}
 
-			if (generateHash) {
+			if (generateHash && function.hasHash) {
+				symbol->set_original_hash(static_cast<u32>(function.hash));
+			} else if (generateHash) {
 				std::optional<ccc::FunctionHash> hash = SymbolGuardian::HashFunction(*symbol, reader);
 				if (hash.has_value()) {
 					symbol->set_original_hash(hash->get());
@@ -364,6 +476,12 @@ namespace MIPSAnalyst
 		}
 	}
 
+
+	void ScanForFunctions(ccc::SymbolDatabase& database, MemoryInterface& reader, u32 startAddr, u32 endAddr, bool generateHashes) {
+		const std::vector<AnalyzedFunction> functions = AnalyzeFunctions(database, reader, startAddr, endAddr, generateHashes, nullptr);
+		CreateFunctions(database, reader, functions.data(), functions.size(), generateHashes);
+	}
+
 	MipsOpcodeInfo GetOpcodeInfo(DebugInterface* cpu, u32 address) {
 		MipsOpcodeInfo info;
 		memset(&info, 0, sizeof(info));
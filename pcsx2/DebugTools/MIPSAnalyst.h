@@ -31,6 +31,14 @@ namespace MIPSAnalyst
 
 	void ScanForFunctions(ccc::SymbolDatabase& database, MemoryInterface& reader, u32 startAddr, u32 endAddr, bool generateHashes);
 
+	// The two halves of ScanForFunctions. Analysis only reads the database and is split between worker
+	// threads, so it can run under a shared lock, creating the symbols can then be done in batches.
+	// With maxPieces set to 1 the range is scanned in one piece on the calling thread.
+	std::vector<AnalyzedFunction> AnalyzeFunctions(const ccc::SymbolDatabase& database, MemoryInterface& reader,
+		u32 startAddr, u32 endAddr, bool generateHashes, const std::atomic_bool* interrupt, u32 maxPieces = 64);
+	void CreateFunctions(ccc::SymbolDatabase& database, MemoryInterface& reader, const AnalyzedFunction* functions,
+		size_t count, bool generateHashes);
+
 	enum LoadStoreLRType { LOADSTORE_NORMAL, LOADSTORE_LEFT, LOADSTORE_RIGHT };
 
 	typedef struct {
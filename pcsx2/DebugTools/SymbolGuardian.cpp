@@ -6,9 +6,16 @@
 #include "DebugInterface.h"
 #include "Host.h"
 
+#include "common/Threading.h"
+
+#include <algorithm>
+
 SymbolGuardian R5900SymbolGuardian;
 SymbolGuardian R3000SymbolGuardian;
 
+static constexpr u32 MAX_WORKER_THREADS = 8;
+static constexpr size_t HASH_FUNCTIONS_PER_THREAD = 256;
+
 void SymbolGuardian::Read(ReadCallback callback) const noexcept
 {
 	std::shared_lock lock(m_big_symbol_lock);
@@ -154,29 +161,35 @@ FunctionInfo SymbolGuardian::FunctionOverlappingAddress(u32 address) const
 
 void SymbolGuardian::GenerateFunctionHashes(ccc::SymbolDatabase& database, MemoryInterface& reader)
 {
-	for (ccc::Function& function : database.functions)
-	{
+	// Each function is only touched by one thread.
+	const auto functions = database.functions.begin();
+	const size_t count = database.functions.end() - functions;
+	ParallelFor(count, HASH_FUNCTIONS_PER_THREAD, [&](size_t i) {
+		ccc::Function& function = functions[i];
+
 		std::optional<ccc::FunctionHash> hash = HashFunction(function, reader);
 		if (!hash.has_value())
-			continue;
+			return;
 
 		function.set_original_hash(hash->get());
-	}
+	});
 }
 
 void SymbolGuardian::UpdateFunctionHashes(ccc::SymbolDatabase& database, MemoryInterface& reader)
 {
-	for (ccc::Function& function : database.functions)
-	{
+	const auto functions = database.functions.begin();
+	const size_t count = database.functions.end() - functions;
+	ParallelFor(count, HASH_FUNCTIONS_PER_THREAD, [&](size_t i) {
+		ccc::Function& function = functions[i];
 		if (function.original_hash() == 0)
-			continue;
+			return;
 
 		std::optional<ccc::FunctionHash> hash = HashFunction(function, reader);
 		if (!hash.has_value())
-			continue;
+			return;
 
 		function.set_current_hash(*hash);
-	}
+	});
 
 	for (ccc::SourceFile& source_file : database.source_files)
 		source_file.check_functions_match(database);
@@ -187,15 +200,20 @@ std::optional<ccc::FunctionHash> SymbolGuardian::HashFunction(const ccc::Functio
 	if (!function.address().valid())
 		return std::nullopt;
 
-	if (function.size() == 0 || function.size() > _1mb)
+	return HashFunction(function.address().value, function.size(), reader);
+}
+
+std::optional<ccc::FunctionHash> SymbolGuardian::HashFunction(u32 address, u32 size, MemoryInterface& reader)
+{
+	if (size == 0 || size > _1mb)
 		return std::nullopt;
 
 	ccc::FunctionHash hash;
 
-	for (u32 i = 0; i < function.size() / 4; i++)
+	for (u32 i = 0; i < size / 4; i++)
 	{
 		bool valid;
-		u32 value = reader.Read32(function.address().value + i * 4, &valid);
+		u32 value = reader.Read32(address + i * 4, &valid);
 		if (!valid)
 			return std::nullopt;
 
@@ -205,6 +223,32 @@ std::optional<ccc::FunctionHash> SymbolGuardian::HashFunction(const ccc::Functio
 	return hash;
 }
 
+void SymbolGuardian::ParallelFor(size_t count, size_t min_per_thread, const std::function<void(size_t index)>& callback)
+{
+	const size_t thread_count = std::min<size_t>(
+		std::clamp<u32>(std::thread::hardware_concurrency(), 1, MAX_WORKER_THREADS), count / std::max<size_t>(min_per_thread, 1));
+
+	std::atomic<size_t> next_index = 0;
+	const auto work = [&]() {
+		for (size_t index = next_index++; index < count; index = next_index++)
+			callback(index);
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < thread_count; i++)
+	{
+		threads.emplace_back([&work]() {
+			Threading::SetNameOfCurrentThread("Symbol Worker");
+			work();
+		});
+	}
+
+	work();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
 void SymbolGuardian::ClearIrxModules()
 {
 	ReadWrite([&](ccc::SymbolDatabase& database) {
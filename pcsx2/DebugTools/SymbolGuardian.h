@@ -83,6 +83,11 @@ public:
 
 	// Hash a function and return the result.
 	static std::optional<ccc::FunctionHash> HashFunction(const ccc::Function& function, MemoryInterface& reader);
+	static std::optional<ccc::FunctionHash> HashFunction(u32 address, u32 size, MemoryInterface& reader);
+
+	// Call the callback for every index below count, spread over a few worker
+	// threads if there are at least min_per_thread indices for each of them.
+	static void ParallelFor(size_t count, size_t min_per_thread, const std::function<void(size_t index)>& callback);
 
 	// Delete all symbols from modules that have the "is_irx" flag set.
 	void ClearIrxModules();
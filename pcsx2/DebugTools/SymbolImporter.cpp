@@ -274,15 +274,15 @@ void SymbolImporter::AnalyseElf(
 				return;
 
 			database.merge_from(temp_database);
+		});
 
-			if (m_interrupt_import_thread)
-				return;
+		if (m_interrupt_import_thread)
+			return;
 
-			// The function scanner has to be run on the main database so that
-			// functions created before the importer was run are still
-			// considered. Otherwise, duplicate functions will be created.
-			ScanForFunctions(database, symbol_file, params.options);
-		});
+		// The function scanner has to be run on the main database so that
+		// functions created before the importer was run are still
+		// considered. Otherwise, duplicate functions will be created.
+		ScanForFunctions(m_guardian, symbol_file, params.options, &m_interrupt_import_thread);
 	});
 }
 
@@ -616,61 +616,78 @@ std::unique_ptr<ccc::ast::Node> SymbolImporter::GetBuiltInType(
 }
 
 void SymbolImporter::ScanForFunctions(
-	ccc::SymbolDatabase& database, const ccc::ElfSymbolFile& elf, const Pcsx2Config::DebugAnalysisOptions& options)
+	SymbolGuardian& guardian,
+	const ccc::ElfSymbolFile& elf,
+	const Pcsx2Config::DebugAnalysisOptions& options,
+	const std::atomic_bool* interrupt)
 {
-	MipsExpressionFunctions expression_functions(&r5900Debug, &database, true);
-
-	u32 start_address = 0;
-	u32 end_address = 0;
-	if (options.CustomFunctionScanRange)
+	ElfMemoryReader elf_reader(elf.elf());
+	MemoryInterface* reader = nullptr;
+	switch (options.FunctionScanMode)
 	{
-		u64 expression_result = 0;
-		std::string error;
-
-		if (!parseExpression(options.FunctionScanStartAddress.c_str(), &expression_functions, expression_result, error))
-		{
-			Console.Error("Failed to evaluate start address expression '%s' while scanning for functions: %s",
-				options.FunctionScanStartAddress.c_str(), error.c_str());
+		case DebugFunctionScanMode::SCAN_ELF:
+			reader = &elf_reader;
+			break;
+		case DebugFunctionScanMode::SCAN_MEMORY:
+			reader = &r5900Debug;
+			break;
+		case DebugFunctionScanMode::SKIP:
 			return;
-		}
+	}
 
-		start_address = static_cast<u32>(expression_result);
+	// Analysing the code only needs a shared lock, so readers on other
+	// threads can carry on in the meantime.
+	std::vector<MIPSAnalyst::AnalyzedFunction> functions;
+	guardian.Read([&](const ccc::SymbolDatabase& database) {
+		MipsExpressionFunctions expression_functions(&r5900Debug, &database, true);
 
-		if (!parseExpression(options.FunctionScanEndAddress.c_str(), &expression_functions, expression_result, error))
+		u32 start_address = 0;
+		u32 end_address = 0;
+		if (options.CustomFunctionScanRange)
 		{
-			Console.Error("Failed to evaluate end address expression '%s' while scanning for functions: %s",
-				options.FunctionScanEndAddress.c_str(), error.c_str());
-			return;
-		}
+			u64 expression_result = 0;
+			std::string error;
 
-		end_address = static_cast<u32>(expression_result);
-	}
-	else
-	{
-		const ccc::ElfProgramHeader* entry_segment = elf.elf().entry_point_segment();
-		if (!entry_segment)
-			return;
+			if (!parseExpression(options.FunctionScanStartAddress.c_str(), &expression_functions, expression_result, error))
+			{
+				Console.Error("Failed to evaluate start address expression '%s' while scanning for functions: %s",
+					options.FunctionScanStartAddress.c_str(), error.c_str());
+				return;
+			}
 
-		start_address = entry_segment->vaddr;
-		end_address = entry_segment->vaddr + entry_segment->filesz;
-	}
+			start_address = static_cast<u32>(expression_result);
 
-	switch (options.FunctionScanMode)
-	{
-		case DebugFunctionScanMode::SCAN_ELF:
-		{
-			ElfMemoryReader reader(elf.elf());
-			MIPSAnalyst::ScanForFunctions(database, reader, start_address, end_address, options.GenerateFunctionHashes);
-			break;
-		}
-		case DebugFunctionScanMode::SCAN_MEMORY:
-		{
-			MIPSAnalyst::ScanForFunctions(database, r5900Debug, start_address, end_address, options.GenerateFunctionHashes);
-			break;
+			if (!parseExpression(options.FunctionScanEndAddress.c_str(), &expression_functions, expression_result, error))
+			{
+				Console.Error("Failed to evaluate end address expression '%s' while scanning for functions: %s",
+					options.FunctionScanEndAddress.c_str(), error.c_str());
+				return;
+			}
+
+			end_address = static_cast<u32>(expression_result);
 		}
-		case DebugFunctionScanMode::SKIP:
+		else
 		{
-			break;
+			const ccc::ElfProgramHeader* entry_segment = elf.elf().entry_point_segment();
+			if (!entry_segment)
+				return;
+
+			start_address = entry_segment->vaddr;
+			end_address = entry_segment->vaddr + entry_segment->filesz;
 		}
+
+		functions = MIPSAnalyst::AnalyzeFunctions(
+			database, *reader, start_address, end_address, options.GenerateFunctionHashes, interrupt);
+	});
+
+	// Symbols are created in batches, the exclusive lock is only held for a
+	// short time before readers get a chance to run.
+	static constexpr size_t FUNCTIONS_PER_BATCH = 1024;
+	for (size_t i = 0; i < functions.size() && !*interrupt; i += FUNCTIONS_PER_BATCH)
+	{
+		guardian.ReadWrite([&](ccc::SymbolDatabase& database) {
+			MIPSAnalyst::CreateFunctions(database, *reader, &functions[i],
+				std::min(FUNCTIONS_PER_BATCH, functions.size() - i), options.GenerateFunctionHashes);
+		});
 	}
 }
@@ -73,7 +73,10 @@ public:
 		const std::map<std::string, ccc::DataTypeHandle>& builtin_types);
 
 	static void ScanForFunctions(
-		ccc::SymbolDatabase& database, const ccc::ElfSymbolFile& elf, const Pcsx2Config::DebugAnalysisOptions& options);
+		SymbolGuardian& guardian,
+		const ccc::ElfSymbolFile& elf,
+		const Pcsx2Config::DebugAnalysisOptions& options,
+		const std::atomic_bool* interrupt);
 
 protected:
 	SymbolGuardian& m_guardian;
@@ -686,11 +686,13 @@ void GSgetStats(SmallStringBase& info)
 			prefix = 'k';
 		}
 
-		info.format("{} SW | {} SYNP | {} PRIM | {} DRW | {:.2f} SWIZ | {:.2f} UNSWIZ | {:.2f} {}pps",
+		info.format("{} SW | {} SYNP | {} PRIM | {} DRW | {} TCH | {} TCM | {:.2f} SWIZ | {:.2f} UNSWIZ | {:.2f} {}pps",
 			api_name,
 			(int)pm.Get(GSPerfMon::SyncPoint),
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
+			(int)std::ceil(pm.Get(GSPerfMon::TextureCacheHits)),
+			(int)std::ceil(pm.Get(GSPerfMon::TextureCacheMisses)),
 			pm.Get(GSPerfMon::Swizzle) / _1kb,
 			pm.Get(GSPerfMon::Unswizzle) / _1kb,
 			pps, prefix);
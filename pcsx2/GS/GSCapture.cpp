@@ -19,7 +19,9 @@
 #include "common/SmallString.h"
 #include "common/StringUtil.h"
 #include "common/Threading.h"
+#include "common/Timer.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -136,7 +138,7 @@ extern "C" {
 namespace GSCapture
 {
 	static constexpr u32 NUM_FRAMES_IN_FLIGHT = 3;
-	static constexpr u32 MAX_PENDING_FRAMES = NUM_FRAMES_IN_FLIGHT * 2;
+	static constexpr u32 MAX_PENDING_FRAMES = NUM_FRAMES_IN_FLIGHT * 3; // map, conversion and encode stages
 	static constexpr u32 AUDIO_BUFFER_SIZE = Common::AlignUpPow2((MAX_PENDING_FRAMES * 48000) / 60, AudioStream::CHUNK_SIZE);
 	static constexpr u32 AUDIO_CHANNELS = 2;
 
@@ -146,12 +148,25 @@ namespace GSCapture
 		{
 			Unused,
 			NeedsMap,
+			NeedsConversion,
 			NeedsEncoding
 		};
 
 		std::unique_ptr<GSDownloadTexture> tex;
 		s64 pts;
 		State state;
+		bool converted;
+	};
+
+	// Only touched with s_lock held, reported when the capture ends.
+	struct PipelineStats
+	{
+		u64 frames;
+		u64 stalls;
+		u64 stall_ticks;
+		u64 conversion_ticks;
+		u64 encode_ticks;
+		u32 max_queue_depth;
 	};
 
 	static void LogAVError(int errnum, const char* format, ...);
@@ -161,10 +176,13 @@ namespace GSCapture
 	static bool IsUsingHardwareVideoEncoding();
 	static void ProcessFramePendingMap(std::unique_lock<std::mutex>& lock);
 	static void ProcessAllInFlightFrames(std::unique_lock<std::mutex>& lock);
+	static void ConversionThreadEntryPoint();
 	static void EncoderThreadEntryPoint();
 	static void StartEncoderThread();
 	static void StopEncoderThread(std::unique_lock<std::mutex>& lock);
-	static bool SendFrame(const PendingFrame& pf);
+	static bool ConvertFrame(const PendingFrame& pf, AVFrame* frame);
+	static bool SendFrame(AVFrame* frame, s64 pts);
+	static void LogPipelineStats();
 	static bool ReceivePackets(AVCodecContext* codec_context, AVStream* stream, AVPacket* packet);
 	static bool ProcessAudioPackets(s64 video_pts);
 	static void InternalEndCapture(std::unique_lock<std::mutex>& lock);
@@ -180,7 +198,7 @@ namespace GSCapture
 
 	static AVCodecContext* s_video_codec_context = nullptr;
 	static AVStream* s_video_stream = nullptr;
-	static AVFrame* s_converted_video_frame = nullptr; // YUV
+	static std::array<AVFrame*, MAX_PENDING_FRAMES> s_converted_video_frames = {}; // YUV, one per pending frame
 	static AVFrame* s_hw_video_frame = nullptr;
 	static AVPacket* s_video_packet = nullptr;
 	static SwsContext* s_sws_context = nullptr;
@@ -201,15 +219,20 @@ namespace GSCapture
 	static u32 s_audio_frame_pos = 0;
 	static bool s_audio_frame_planar = false;
 
+	static Threading::Thread s_conversion_thread;
 	static Threading::Thread s_encoder_thread;
+	static std::condition_variable s_frame_mapped_cv;
 	static std::condition_variable s_frame_ready_cv;
 	static std::condition_variable s_frame_encoded_cv;
 	static std::array<PendingFrame, MAX_PENDING_FRAMES> s_pending_frames = {};
 	static u32 s_pending_frames_pos = 0;
 	static u32 s_frames_pending_map = 0;
 	static u32 s_frames_map_consume_pos = 0;
+	static u32 s_frames_pending_conversion = 0;
+	static u32 s_frames_conversion_consume_pos = 0;
 	static u32 s_frames_pending_encode = 0;
 	static u32 s_frames_encode_consume_pos = 0;
+	static PipelineStats s_pipeline_stats = {};
 
 	// NOTE: So this doesn't need locking, we allocate it once, and leave it.
 	static std::unique_ptr<float[]> s_audio_buffer;
@@ -572,22 +595,33 @@ bool GSCapture::BeginCapture(float fps, GSVector2i recommendedResolution, float
 		if (has_pixel_format_override)
 			sw_pix_fmt = s_video_codec_context->pix_fmt;
 
-		s_converted_video_frame = wrap_av_frame_alloc();
-		s_hw_video_frame = IsUsingHardwareVideoEncoding() ? wrap_av_frame_alloc() : nullptr;
-		if (!s_converted_video_frame || (IsUsingHardwareVideoEncoding() && !s_hw_video_frame))
+		// Each pending frame gets its own converted frame, so conversion can run ahead of the encoder.
+		for (AVFrame*& frame : s_converted_video_frames)
 		{
-			LogAVError(AVERROR(ENOMEM), "Failed to allocate frame: ");
-			InternalEndCapture(lock);
-			return false;
+			frame = wrap_av_frame_alloc();
+			if (!frame)
+			{
+				LogAVError(AVERROR(ENOMEM), "Failed to allocate frame: ");
+				InternalEndCapture(lock);
+				return false;
+			}
+
+			frame->format = sw_pix_fmt;
+			frame->width = s_video_codec_context->width;
+			frame->height = s_video_codec_context->height;
+			res = wrap_av_frame_get_buffer(frame, 0);
+			if (res < 0)
+			{
+				LogAVError(res, "av_frame_get_buffer() for converted frame failed: ");
+				InternalEndCapture(lock);
+				return false;
+			}
 		}
 
-		s_converted_video_frame->format = sw_pix_fmt;
-		s_converted_video_frame->width = s_video_codec_context->width;
-		s_converted_video_frame->height = s_video_codec_context->height;
-		res = wrap_av_frame_get_buffer(s_converted_video_frame, 0);
-		if (res < 0)
+		s_hw_video_frame = IsUsingHardwareVideoEncoding() ? wrap_av_frame_alloc() : nullptr;
+		if (IsUsingHardwareVideoEncoding() && !s_hw_video_frame)
 		{
-			LogAVError(res, "av_frame_get_buffer() for converted frame failed: ");
+			LogAVError(AVERROR(ENOMEM), "Failed to allocate frame: ");
 			InternalEndCapture(lock);
 			return false;
 		}
@@ -868,11 +902,14 @@ bool GSCapture::DeliverVideoFrame(GSTexture* stex)
 
 	PendingFrame& pf = s_pending_frames[s_pending_frames_pos];
 
-	// It shouldn't be pending map, but the encode thread might be lagging.
+	// It shouldn't be pending map, but the conversion or encode threads might be lagging.
 	pxAssert(pf.state != PendingFrame::State::NeedsMap);
-	if (pf.state == PendingFrame::State::NeedsEncoding)
+	if (pf.state != PendingFrame::State::Unused)
 	{
+		const u64 stall_start = Common::Timer::GetCurrentValue();
 		s_frame_encoded_cv.wait(lock, [&pf]() { return pf.state == PendingFrame::State::Unused; });
+		s_pipeline_stats.stall_ticks += Common::Timer::GetCurrentValue() - stall_start;
+		s_pipeline_stats.stalls++;
 	}
 
 	if (!pf.tex || pf.tex->GetWidth() != static_cast<u32>(stex->GetWidth()) || pf.tex->GetHeight() != static_cast<u32>(stex->GetHeight()))
@@ -897,6 +934,10 @@ bool GSCapture::DeliverVideoFrame(GSTexture* stex)
 
 	s_pending_frames_pos = (s_pending_frames_pos + 1) % MAX_PENDING_FRAMES;
 	s_frames_pending_map++;
+
+	s_pipeline_stats.frames++;
+	s_pipeline_stats.max_queue_depth =
+		std::max(s_pipeline_stats.max_queue_depth, s_frames_pending_map + s_frames_pending_conversion + s_frames_pending_encode);
 	return true;
 }
 
@@ -921,12 +962,54 @@ void GSCapture::ProcessFramePendingMap(std::unique_lock<std::mutex>& lock)
 
 	lock.lock();
 
-	// Kick to encoder thread!
-	pf.state = PendingFrame::State::NeedsEncoding;
+	// Kick to conversion thread!
+	pf.state = PendingFrame::State::NeedsConversion;
 	s_frames_map_consume_pos = (s_frames_map_consume_pos + 1) % MAX_PENDING_FRAMES;
 	s_frames_pending_map--;
-	s_frames_pending_encode++;
-	s_frame_ready_cv.notify_one();
+	s_frames_pending_conversion++;
+	s_frame_mapped_cv.notify_one();
+}
+
+void GSCapture::ConversionThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("GS Capture Conversion");
+
+	std::unique_lock<std::mutex> lock(s_lock);
+
+	for (;;)
+	{
+		s_frame_mapped_cv.wait(lock, []() { return (s_frames_pending_conversion > 0 || !s_capturing.load(std::memory_order_acquire)); });
+		if (s_frames_pending_conversion == 0 && !s_capturing.load(std::memory_order_acquire))
+			break;
+
+		const u32 pos = s_frames_conversion_consume_pos;
+		PendingFrame& pf = s_pending_frames[pos];
+		pxAssert(pf.state == PendingFrame::State::NeedsConversion);
+
+		lock.unlock();
+
+		// If the frame failed to map, or the encoder already gave up, the encoder will skip it.
+		const u64 start = Common::Timer::GetCurrentValue();
+		const bool mapped = pf.tex->IsMapped();
+		const bool converted = (!s_encoding_error && mapped && ConvertFrame(pf, s_converted_video_frames[pos]));
+		const u64 ticks = Common::Timer::GetCurrentValue() - start;
+
+		lock.lock();
+
+		s_pipeline_stats.conversion_ticks += ticks;
+
+		// A mapped frame which can't be converted means there's no usable scaler, so give up on the capture.
+		if (mapped && !converted)
+			s_encoding_error = true;
+
+		// Kick to encoder thread!
+		pf.converted = converted;
+		pf.state = PendingFrame::State::NeedsEncoding;
+		s_frames_conversion_consume_pos = (s_frames_conversion_consume_pos + 1) % MAX_PENDING_FRAMES;
+		s_frames_pending_conversion--;
+		s_frames_pending_encode++;
+		s_frame_ready_cv.notify_one();
+	}
 }
 
 void GSCapture::EncoderThreadEntryPoint()
@@ -941,23 +1024,29 @@ void GSCapture::EncoderThreadEntryPoint()
 		if (s_frames_pending_encode == 0 && !s_capturing.load(std::memory_order_acquire))
 			break;
 
-		PendingFrame& pf = s_pending_frames[s_frames_encode_consume_pos];
+		const u32 pos = s_frames_encode_consume_pos;
+		PendingFrame& pf = s_pending_frames[pos];
 		pxAssert(pf.state == PendingFrame::State::NeedsEncoding);
 
 		lock.unlock();
 
+		const u64 start = Common::Timer::GetCurrentValue();
 		bool okay = !s_encoding_error;
 
-		// If the frame failed to map, this will be false, and we'll just skip it.
-		if (okay && s_video_stream && pf.tex->IsMapped())
-			okay = SendFrame(pf);
+		// If the frame failed to map or convert, this will be false, and we'll just skip it.
+		if (okay && s_video_stream && pf.converted)
+			okay = SendFrame(s_converted_video_frames[pos], pf.pts);
 
 		// Encode as many audio frames while the video is ahead.
 		if (okay && s_audio_stream)
 			okay = ProcessAudioPackets(pf.pts);
 
+		const u64 ticks = Common::Timer::GetCurrentValue() - start;
+
 		lock.lock();
 
+		s_pipeline_stats.encode_ticks += ticks;
+
 		// If we had an encoding error, tell the GS thread to shut down the capture (later).
 		if (!okay)
 			s_encoding_error = true;
@@ -973,8 +1062,12 @@ void GSCapture::EncoderThreadEntryPoint()
 void GSCapture::StartEncoderThread()
 {
 	Console.WriteLn("GSCapture: Starting encoder thread.");
-	pxAssert(s_capturing.load(std::memory_order_acquire) && !s_encoder_thread.Joinable());
+	pxAssert(s_capturing.load(std::memory_order_acquire) && !s_encoder_thread.Joinable() && !s_conversion_thread.Joinable());
 	s_encoder_thread.Start(EncoderThreadEntryPoint);
+
+	// Audio-only captures go straight to the encoder.
+	if (s_video_stream)
+		s_conversion_thread.Start(ConversionThreadEntryPoint);
 }
 
 void GSCapture::StopEncoderThread(std::unique_lock<std::mutex>& lock)
@@ -982,6 +1075,17 @@ void GSCapture::StopEncoderThread(std::unique_lock<std::mutex>& lock)
 	// Thread will exit when s_capturing is false.
 	pxAssert(!s_capturing.load(std::memory_order_acquire));
 
+	if (s_conversion_thread.Joinable())
+	{
+		Console.WriteLn("GSCapture: Stopping conversion thread.");
+
+		// Conversion feeds the encoder, so it has to go first.
+		s_frame_mapped_cv.notify_one();
+		lock.unlock();
+		s_conversion_thread.Join();
+		lock.lock();
+	}
+
 	if (s_encoder_thread.Joinable())
 	{
 		Console.WriteLn("GSCapture: Stopping encoder thread.");
@@ -994,7 +1098,7 @@ void GSCapture::StopEncoderThread(std::unique_lock<std::mutex>& lock)
 	}
 }
 
-bool GSCapture::SendFrame(const PendingFrame& pf)
+bool GSCapture::ConvertFrame(const PendingFrame& pf, AVFrame* frame)
 {
 	const AVPixelFormat source_format = AV_PIX_FMT_RGBA;
 	const u8* source_ptr = pf.tex->GetMapPointer();
@@ -1002,25 +1106,28 @@ bool GSCapture::SendFrame(const PendingFrame& pf)
 	const int source_height = static_cast<int>(pf.tex->GetHeight());
 	const int source_pitch = static_cast<int>(pf.tex->GetMapPitch());
 
-	// In case a previous frame is still using the frame.
-	wrap_av_frame_make_writable(s_converted_video_frame);
+	// In case the encoder is still holding a reference to the frame.
+	wrap_av_frame_make_writable(frame);
 
-	s_sws_context = wrap_sws_getCachedContext(s_sws_context, source_width, source_height, source_format, s_converted_video_frame->width,
-		s_converted_video_frame->height, static_cast<AVPixelFormat>(s_converted_video_frame->format), SWS_BICUBIC, nullptr, nullptr, nullptr);
+	s_sws_context = wrap_sws_getCachedContext(s_sws_context, source_width, source_height, source_format, frame->width,
+		frame->height, static_cast<AVPixelFormat>(frame->format), SWS_BICUBIC, nullptr, nullptr, nullptr);
 	if (!s_sws_context)
 	{
 		Console.Error("sws_getCachedContext() failed");
 		return false;
 	}
 
-	wrap_sws_scale(s_sws_context, reinterpret_cast<const u8**>(&source_ptr), &source_pitch, 0, source_height, s_converted_video_frame->data,
-		s_converted_video_frame->linesize);
+	wrap_sws_scale(s_sws_context, reinterpret_cast<const u8**>(&source_ptr), &source_pitch, 0, source_height, frame->data, frame->linesize);
+	return true;
+}
 
-	AVFrame* frame_to_send = s_converted_video_frame;
+bool GSCapture::SendFrame(AVFrame* frame, s64 pts)
+{
+	AVFrame* frame_to_send = frame;
 	if (IsUsingHardwareVideoEncoding())
 	{
 		// Need to transfer the frame to hardware.
-		const int res = wrap_av_hwframe_transfer_data(s_hw_video_frame, s_converted_video_frame, 0);
+		const int res = wrap_av_hwframe_transfer_data(s_hw_video_frame, frame, 0);
 		if (res < 0)
 		{
 			LogAVError(res, "av_hwframe_transfer_data() failed: ");
@@ -1031,7 +1138,7 @@ bool GSCapture::SendFrame(const PendingFrame& pf)
 	}
 
 	// Set the correct PTS before handing it off.
-	frame_to_send->pts = pf.pts;
+	frame_to_send->pts = pts;
 
 	const int res = wrap_avcodec_send_frame(s_video_codec_context, frame_to_send);
 	if (res < 0)
@@ -1048,12 +1155,26 @@ void GSCapture::ProcessAllInFlightFrames(std::unique_lock<std::mutex>& lock)
 	while (s_frames_pending_map > 0)
 		ProcessFramePendingMap(lock);
 
-	while (s_frames_pending_encode > 0)
+	while ((s_frames_pending_conversion + s_frames_pending_encode) > 0)
 	{
-		s_frame_encoded_cv.wait(lock, []() { return (s_frames_pending_encode == 0 || s_encoding_error); });
+		s_frame_encoded_cv.wait(lock, []() { return ((s_frames_pending_conversion + s_frames_pending_encode) == 0 || s_encoding_error); });
 	}
 }
 
+void GSCapture::LogPipelineStats()
+{
+	const PipelineStats& stats = s_pipeline_stats;
+	if (stats.frames == 0)
+		return;
+
+	const double frames = static_cast<double>(stats.frames);
+	Console.WriteLnFmt("GSCapture: {} frames, {} stalls waiting on the encoder ({:.2f} ms total), max queue depth {}/{}.",
+		stats.frames, stats.stalls, Common::Timer::ConvertValueToMilliseconds(stats.stall_ticks), stats.max_queue_depth, MAX_PENDING_FRAMES);
+	Console.WriteLnFmt("GSCapture: Average {:.2f} ms converting and {:.2f} ms encoding per frame.",
+		Common::Timer::ConvertValueToMilliseconds(stats.conversion_ticks) / frames,
+		Common::Timer::ConvertValueToMilliseconds(stats.encode_ticks) / frames);
+}
+
 bool GSCapture::ReceivePackets(AVCodecContext* codec_context, AVStream* stream, AVPacket* packet)
 {
 	for (;;)
@@ -1267,13 +1388,17 @@ void GSCapture::InternalEndCapture(std::unique_lock<std::mutex>& lock)
 
 		s_capturing.store(false, std::memory_order_release);
 		StopEncoderThread(lock);
+		LogPipelineStats();
 
 		s_pending_frames = {};
 		s_pending_frames_pos = 0;
 		s_frames_pending_map = 0;
 		s_frames_map_consume_pos = 0;
+		s_frames_pending_conversion = 0;
+		s_frames_conversion_consume_pos = 0;
 		s_frames_pending_encode = 0;
 		s_frames_encode_consume_pos = 0;
+		s_pipeline_stats = {};
 
 		s_audio_buffer_read_pos = 0;
 		s_audio_buffer_write_pos = 0;
@@ -1321,8 +1446,11 @@ void GSCapture::InternalEndCapture(std::unique_lock<std::mutex>& lock)
 	}
 	if (s_video_packet)
 		wrap_av_packet_free(&s_video_packet);
-	if (s_converted_video_frame)
-		wrap_av_frame_free(&s_converted_video_frame);
+	for (AVFrame*& frame : s_converted_video_frames)
+	{
+		if (frame)
+			wrap_av_frame_free(&frame);
+	}
 	if (s_hw_video_frame)
 		wrap_av_frame_free(&s_hw_video_frame);
 	if (s_video_hw_frames)
@@ -1412,6 +1540,11 @@ const Threading::ThreadHandle& GSCapture::GetEncoderThreadHandle()
 	return s_encoder_thread;
 }
 
+const Threading::ThreadHandle& GSCapture::GetConversionThreadHandle()
+{
+	return s_conversion_thread;
+}
+
 GSVector2i GSCapture::GetSize()
 {
 	return s_size;
@@ -29,6 +29,7 @@ namespace GSCapture
 	bool IsCapturingAudio();
 	TinyString GetElapsedTime();
 	const Threading::ThreadHandle& GetEncoderThreadHandle();
+	const Threading::ThreadHandle& GetConversionThreadHandle();
 	GSVector2i GetSize();
 	std::string GetNextCaptureFileName();
 	void Flush();
@@ -5,6 +5,7 @@
 #include "GS/GSLocalMemory.h"
 #include "GS/GSExtra.h"
 #include "GS/GSPng.h"
+#include <bitset>
 #include <unordered_set>
 
 template <typename Fn>
@@ -535,6 +536,106 @@ bool GSLocalMemory::HasOverlap(const u32 src_bp, const u32 src_bw, const u32 src
 	return false;
 }
 
+bool GSLocalMemory::MoveBlocks(const GIFRegBITBLTBUF& BITBLTBUF, int sx, int sy, int dx, int dy, int w, int h)
+{
+	// Within a block, pixels of the same format are always laid out the same way. So when both rects start on
+	// a block boundary, every destination block is a copy of one source block, swizzling doesn't matter.
+	if (BITBLTBUF.SPSM != BITBLTBUF.DPSM)
+		return false;
+
+	bool keep_alpha = false;
+	switch (BITBLTBUF.SPSM)
+	{
+		case PSMCT32:
+		case PSMZ32:
+		case PSMCT16:
+		case PSMCT16S:
+		case PSMZ16:
+		case PSMZ16S:
+		case PSMT8:
+		case PSMT4:
+			break;
+		case PSMCT24:
+		case PSMZ24:
+			keep_alpha = true;
+			break;
+		default:
+			return false;
+	}
+
+	const GSVector2i& bs = m_psm[BITBLTBUF.SPSM].bs;
+	if (w <= 0 || h <= 0 || ((sx | dx | w) & (bs.x - 1)) || ((sy | dy | h) & (bs.y - 1)))
+		return false;
+
+	// The pixel copy wraps around at 2048, don't bother with that here.
+	if (std::max(sx, dx) + w > 2048 || std::max(sy, dy) + h > 2048)
+		return false;
+
+	const GSOffset spo = GetOffset(BITBLTBUF.SBP, BITBLTBUF.SBW, BITBLTBUF.SPSM);
+	const GSOffset dpo = GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM);
+	const int bx = w >> spo.blockShiftX();
+	const int by = h >> spo.blockShiftY();
+
+	// A pixel copy reads each source pixel before anything is written over it only if the source and
+	// destination don't share any blocks, otherwise the order would matter. The same goes for blocks
+	// which appear twice in a rect wrapping around memory.
+	std::bitset<GS_MAX_BLOCKS> src_blocks;
+	std::bitset<GS_MAX_BLOCKS> dst_blocks;
+	GSOffset::BNHelper sbn = spo.bnMulti(sx, sy);
+	GSOffset::BNHelper dbn = dpo.bnMulti(dx, dy);
+	for (int y = 0; y < by; y++, sbn.nextBlockY(), dbn.nextBlockY())
+	{
+		for (int x = 0; x < bx; x++, sbn.nextBlockX(), dbn.nextBlockX())
+		{
+			const u32 sblock = sbn.value();
+			const u32 dblock = dbn.value();
+			if (src_blocks.test(sblock) || dst_blocks.test(dblock))
+				return false;
+			src_blocks.set(sblock);
+			dst_blocks.set(dblock);
+		}
+	}
+	if ((src_blocks & dst_blocks).any())
+		return false;
+
+	const GSVector4i mask = keep_alpha ? GSVector4i::xff000000() : GSVector4i::zero();
+	sbn = spo.bnMulti(sx, sy);
+	dbn = dpo.bnMulti(dx, dy);
+	for (int y = 0; y < by; y++, sbn.nextBlockY(), dbn.nextBlockY())
+	{
+		for (int x = 0; x < bx; x++, sbn.nextBlockX(), dbn.nextBlockX())
+		{
+			const u8* RESTRICT src = BlockPtr(sbn.value());
+			u8* RESTRICT dst = BlockPtr(dbn.value());
+			if (keep_alpha)
+			{
+				for (u32 i = 0; i < GS_BLOCK_SIZE; i += 16)
+				{
+					const GSVector4i s = GSVector4i::load<true>(src + i);
+					const GSVector4i d = GSVector4i::load<true>(dst + i);
+					GSVector4i::store<true>(dst + i, (d & mask) | s.andnot(mask));
+				}
+			}
+			else
+			{
+				for (u32 i = 0; i < GS_BLOCK_SIZE; i += 64)
+				{
+					const GSVector4i v0 = GSVector4i::load<true>(src + i);
+					const GSVector4i v1 = GSVector4i::load<true>(src + i + 16);
+					const GSVector4i v2 = GSVector4i::load<true>(src + i + 32);
+					const GSVector4i v3 = GSVector4i::load<true>(src + i + 48);
+					GSVector4i::store<true>(dst + i, v0);
+					GSVector4i::store<true>(dst + i + 16, v1);
+					GSVector4i::store<true>(dst + i + 32, v2);
+					GSVector4i::store<true>(dst + i + 48, v3);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
 ///////////////////
 
 void GSLocalMemory::ReadTexture(const GSOffset& off, const GSVector4i& r, u8* dst, int dstpitch, const GIFRegTEXA& TEXA)
@@ -1119,6 +1119,10 @@ public:
 
 	void ReadTexture(const GSOffset& off, const GSVector4i& r, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
 
+	/// Local to local transfer of a block aligned rect between two buffers of the same format, a whole block at a time.
+	/// Returns false without touching memory if the transfer can't be done that way, e.g. the blocks overlap.
+	bool MoveBlocks(const GIFRegBITBLTBUF& BITBLTBUF, int sx, int sy, int dx, int dy, int w, int h);
+
 	//
 
 	void SaveBMP(const std::string& fn, u32 bp, u32 bw, u32 psm, int w, int h, int x = 0, int y = 0);
@@ -231,23 +231,26 @@ void GSLocalMemoryFunctions::WriteImageColumn(GSLocalMemory& mem, int l, int r,
 template <int psm, int bsx, int bsy, int alignment>
 void GSLocalMemoryFunctions::WriteImageBlock(GSLocalMemory& mem, int l, int r, int y, int h, const u8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF)
 {
-	u32 bp = BITBLTBUF.DBP;
-	u32 bw = BITBLTBUF.DBW;
+	// Walk the blocks in order, only working out where a page starts when we cross into it,
+	// rather than going through the full swizzle for every block.
+	const GSOffset off = GSOffset::fromKnownPSM(BITBLTBUF.DBP, BITBLTBUF.DBW, static_cast<GS_PSM>(psm));
+	GSOffset::BNHelper bn = off.bnMulti(l, y);
 
-	for (int offset = srcpitch * bsy; h >= bsy; h -= bsy, y += bsy, src += offset)
+	for (int offset = srcpitch * bsy; h >= bsy; h -= bsy, src += offset, bn.nextBlockY())
 	{
-		for (int x = l; x < r; x += bsx)
+		for (int x = l; x < r; x += bsx, bn.nextBlockX())
 		{
+			u8* dst = mem.BlockPtr(bn.value());
 			switch (psm)
 			{
-				case PSMCT32: GSBlock::WriteBlock32<alignment, 0xffffffff>(mem.BlockPtr32(x, y, bp, bw), &src[x * 4], srcpitch); break;
-				case PSMCT16: GSBlock::WriteBlock16<alignment>(mem.BlockPtr16(x, y, bp, bw), &src[x * 2], srcpitch); break;
-				case PSMCT16S: GSBlock::WriteBlock16<alignment>(mem.BlockPtr16S(x, y, bp, bw), &src[x * 2], srcpitch); break;
-				case PSMT8: GSBlock::WriteBlock8<alignment>(mem.BlockPtr8(x, y, bp, bw), &src[x], srcpitch); break;
-				case PSMT4: GSBlock::WriteBlock4<alignment>(mem.BlockPtr4(x, y, bp, bw), &src[x >> 1], srcpitch); break;
-				case PSMZ32: GSBlock::WriteBlock32<alignment, 0xffffffff>(mem.BlockPtr32Z(x, y, bp, bw), &src[x * 4], srcpitch); break;
-				case PSMZ16: GSBlock::WriteBlock16<alignment>(mem.BlockPtr16Z(x, y, bp, bw), &src[x * 2], srcpitch); break;
-				case PSMZ16S: GSBlock::WriteBlock16<alignment>(mem.BlockPtr16SZ(x, y, bp, bw), &src[x * 2], srcpitch); break;
+				case PSMCT32: GSBlock::WriteBlock32<alignment, 0xffffffff>(dst, &src[x * 4], srcpitch); break;
+				case PSMCT16: GSBlock::WriteBlock16<alignment>(dst, &src[x * 2], srcpitch); break;
+				case PSMCT16S: GSBlock::WriteBlock16<alignment>(dst, &src[x * 2], srcpitch); break;
+				case PSMT8: GSBlock::WriteBlock8<alignment>(dst, &src[x], srcpitch); break;
+				case PSMT4: GSBlock::WriteBlock4<alignment>(dst, &src[x >> 1], srcpitch); break;
+				case PSMZ32: GSBlock::WriteBlock32<alignment, 0xffffffff>(dst, &src[x * 4], srcpitch); break;
+				case PSMZ16: GSBlock::WriteBlock16<alignment>(dst, &src[x * 2], srcpitch); break;
+				case PSMZ16S: GSBlock::WriteBlock16<alignment>(dst, &src[x * 2], srcpitch); break;
 				// TODO
 				default: ASSUME(0);
 			}
@@ -23,14 +23,16 @@ public:
 		SyncPoint,
 		Barriers,
 		RenderPasses,
+		TextureCacheHits,
+		TextureCacheMisses,
 		CounterLast,
 
 		// Reused counters for HW.
 		TextureCopies = Fillrate,
 		TextureUploads = SyncPoint,
 
-		CounterLastHW = CounterLast,
-		CounterLastSW = SyncPoint + 1
+		CounterLastHW = TextureCacheHits,
+		CounterLastSW = CounterLast
 	};
 
 protected:
@@ -2380,6 +2380,11 @@ void GSState::FlushWrite()
 	if (len <= 0)
 		return;
 
+	WriteTransferData(&m_tr.buff[m_tr.start], len);
+}
+
+void GSState::WriteTransferData(const u8* src, int len)
+{
 	GSVector4i r;
 
 	r = m_tr.rect;
@@ -2412,7 +2417,7 @@ void GSState::FlushWrite()
 
 	const GSLocalMemory::writeImage wi = GSLocalMemory::m_psm[m_env.BITBLTBUF.DPSM].wi;
 
-	wi(m_mem, m_tr.x, m_tr.y, &m_tr.buff[m_tr.start], len, m_tr.m_blit, m_tr.m_pos, m_tr.m_reg);
+	wi(m_mem, m_tr.x, m_tr.y, src, len, m_tr.m_blit, m_tr.m_pos, m_tr.m_reg);
 
 	m_tr.start += len;
 
@@ -2940,6 +2945,19 @@ void GSState::Write(const u8* mem, int len)
 		}
 	}
 
+	// Large pieces of a transfer which arrives over several GIF tags are swizzled straight out of
+	// the GIF packet instead of being staged in the transfer buffer. The packet is owned by the GIF
+	// path until we return, and nothing is buffered ahead of it, so the data is still written in order.
+	// The SW renderer only, since every piece invalidates video memory, which is costly for the HW cache.
+	// Pieces must hold whole pixels (24-bit formats), otherwise the remainder would be dropped.
+	if (len >= DIRECT_TRANSFER_WRITE_SIZE && m_tr.start == m_tr.end && ((len << 3) % psm.trbpp) == 0 &&
+		!GSIsHardwareRenderer())
+	{
+		m_tr.end += len;
+		WriteTransferData(mem, len);
+		return;
+	}
+
 	memcpy(&m_tr.buff[m_tr.end], mem, len);
 
 	m_tr.end += len;
@@ -3195,55 +3213,59 @@ void GSState::Move()
 		}
 	};
 
-	if (spsm.trbpp == dpsm.trbpp && spsm.trbpp >= 16)
+	// Whole blocks of the same format are copied without going through the swizzle for each pixel.
+	if (!m_mem.MoveBlocks(m_env.BITBLTBUF, m_env.TRXPOS.SSAX, m_env.TRXPOS.SSAY, m_env.TRXPOS.DSAX, m_env.TRXPOS.DSAY, w, h))
 	{
-		if (spsm.trbpp == 32)
+		if (spsm.trbpp == dpsm.trbpp && spsm.trbpp >= 16)
+		{
+			if (spsm.trbpp == 32)
+			{
+				u32* vm = m_mem.vm32();
+				copy(dpo.assertSizesMatch(GSLocalMemory::swizzle32), spo.assertSizesMatch(GSLocalMemory::swizzle32), [vm](u32 doff, u32 soff)
+				{
+					vm[doff] = vm[soff];
+				});
+			}
+			else if (spsm.trbpp == 24)
+			{
+				u32* vm = m_mem.vm32();
+				copy(dpo.assertSizesMatch(GSLocalMemory::swizzle32), spo.assertSizesMatch(GSLocalMemory::swizzle32), [vm](u32 doff, u32 soff)
+				{
+					vm[doff] = (vm[doff] & 0xff000000) | (vm[soff] & 0x00ffffff);
+				});
+			}
+			else // if (spsm.trbpp == 16)
+			{
+				u16* vm = m_mem.vm16();
+				copy(dpo.assertSizesMatch(GSLocalMemory::swizzle16), spo.assertSizesMatch(GSLocalMemory::swizzle16), [vm](u32 doff, u32 soff)
+				{
+					vm[doff] = vm[soff];
+				});
+			}
+		}
+		else if (m_env.BITBLTBUF.SPSM == PSMT8 && m_env.BITBLTBUF.DPSM == PSMT8)
 		{
-			u32* vm = m_mem.vm32();
-			copy(dpo.assertSizesMatch(GSLocalMemory::swizzle32), spo.assertSizesMatch(GSLocalMemory::swizzle32), [vm](u32 doff, u32 soff)
+			u8* vm = m_mem.m_vm8;
+			copy(GSOffset::fromKnownPSM(dbp, dbw, PSMT8), GSOffset::fromKnownPSM(sbp, sbw, PSMT8), [vm](u32 doff, u32 soff)
 			{
 				vm[doff] = vm[soff];
 			});
 		}
-		else if (spsm.trbpp == 24)
+		else if (m_env.BITBLTBUF.SPSM == PSMT4 && m_env.BITBLTBUF.DPSM == PSMT4)
 		{
-			u32* vm = m_mem.vm32();
-			copy(dpo.assertSizesMatch(GSLocalMemory::swizzle32), spo.assertSizesMatch(GSLocalMemory::swizzle32), [vm](u32 doff, u32 soff)
+			copy(GSOffset::fromKnownPSM(dbp, dbw, PSMT4), GSOffset::fromKnownPSM(sbp, sbw, PSMT4), [&](u32 doff, u32 soff)
 			{
-				vm[doff] = (vm[doff] & 0xff000000) | (vm[soff] & 0x00ffffff);
+				m_mem.WritePixel4(doff, m_mem.ReadPixel4(soff));
 			});
 		}
-		else // if (spsm.trbpp == 16)
+		else
 		{
-			u16* vm = m_mem.vm16();
-			copy(dpo.assertSizesMatch(GSLocalMemory::swizzle16), spo.assertSizesMatch(GSLocalMemory::swizzle16), [vm](u32 doff, u32 soff)
+			copy(dpo, spo, [&](u32 doff, u32 soff)
 			{
-				vm[doff] = vm[soff];
+				(m_mem.*dpsm.wpa)(doff, (m_mem.*spsm.rpa)(soff));
 			});
 		}
 	}
-	else if (m_env.BITBLTBUF.SPSM == PSMT8 && m_env.BITBLTBUF.DPSM == PSMT8)
-	{
-		u8* vm = m_mem.m_vm8;
-		copy(GSOffset::fromKnownPSM(dbp, dbw, PSMT8), GSOffset::fromKnownPSM(sbp, sbw, PSMT8), [vm](u32 doff, u32 soff)
-		{
-			vm[doff] = vm[soff];
-		});
-	}
-	else if (m_env.BITBLTBUF.SPSM == PSMT4 && m_env.BITBLTBUF.DPSM == PSMT4)
-	{
-		copy(GSOffset::fromKnownPSM(dbp, dbw, PSMT4), GSOffset::fromKnownPSM(sbp, sbw, PSMT4), [&](u32 doff, u32 soff)
-		{
-			m_mem.WritePixel4(doff, m_mem.ReadPixel4(soff));
-		});
-	}
-	else
-	{
-		copy(dpo, spo, [&](u32 doff, u32 soff)
-		{
-			(m_mem.*dpsm.wpa)(doff, (m_mem.*spsm.rpa)(soff));
-		});
-	}
 
 	m_env.TRXDIR.XDIR = 3;
 }
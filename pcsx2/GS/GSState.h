@@ -127,6 +127,7 @@ private:
 
 protected:
 	static constexpr int INVALID_ALPHA_MINMAX = 500;
+	static constexpr int DIRECT_TRANSFER_WRITE_SIZE = 64 * 1024;
 	static constexpr int MAX_DRAW_BUFFERS = 3;
 
 	GSVertex m_v = {};
@@ -498,6 +499,7 @@ public:
 	void FlushPrim();
 	bool TestDrawChanged();
 	void FlushWrite();
+	void WriteTransferData(const u8* src, int len);
 	virtual void Draw() = 0;
 	virtual void PurgeTextureCache(bool sources, bool targets, bool hash_cache);
 	virtual void ReadbackTextureCache();
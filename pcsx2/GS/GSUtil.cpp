@@ -204,7 +204,11 @@ const char* GSUtil::GetPerfMonCounterName(GSPerfMon::counter_t counter, bool hw)
 			"Swizzle",
 			"Unswizzle",
 			"Fillrate",
-			"SyncPoint"
+			"SyncPoint",
+			"Barriers",
+			"RenderPasses",
+			"TextureCacheHits",
+			"TextureCacheMisses"
 		};
 		return counter < std::size(names_sw) ? names_sw[counter] : "";
 	}
@@ -7,6 +7,8 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 
+#include <bit>
+
 GSTextureCacheSW::GSTextureCacheSW() = default;
 
 GSTextureCacheSW::~GSTextureCacheSW()
@@ -18,107 +20,205 @@ GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, cons
 {
 	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
 
-	auto& m = m_map[TEX0.TBP0 >> 5];
+	const u32 page = TEX0.TBP0 >> 5;
 
-	for (auto i = m.begin(); i != m.end(); ++i)
+	for (size_t word = 0; word < m_page_index.size(); word++)
 	{
-		Texture* t = *i;
-
-		if (((TEX0.U32[0] ^ t->m_TEX0.U32[0]) | ((TEX0.U32[1] ^ t->m_TEX0.U32[1]) & 3)) != 0) // TBP0 TBW PSM TW TH
+		for (u64 bits = m_page_index[word][page]; bits != 0; bits &= bits - 1)
 		{
-			continue;
-		}
+			Texture* t = m_slots[word * SLOTS_PER_WORD + std::countr_zero(bits)];
 
-		if ((psm.trbpp == 16 || psm.trbpp == 24) && TEX0.TCC && TEXA != t->m_TEXA)
-		{
-			continue;
-		}
+			if (((TEX0.U32[0] ^ t->m_TEX0.U32[0]) | ((TEX0.U32[1] ^ t->m_TEX0.U32[1]) & 3)) != 0) // TBP0 TBW PSM TW TH
+			{
+				continue;
+			}
 
-		if (tw0 != 0 && t->m_tw != tw0)
-		{
-			continue;
-		}
+			if ((psm.trbpp == 16 || psm.trbpp == 24) && TEX0.TCC && TEXA != t->m_TEXA)
+			{
+				continue;
+			}
+
+			if (tw0 != 0 && t->m_tw != tw0)
+			{
+				continue;
+			}
 
-		// Lookup hit
-		m.MoveFront(i.Index());
-		t->m_age = 0;
-		return t;
+			// Lookup hit
+			g_perfmon.Put(GSPerfMon::TextureCacheHits, 1);
+			t->m_age = 0;
+			return t;
+		}
 	}
 
 	// Lookup miss
+	g_perfmon.Put(GSPerfMon::TextureCacheMisses, 1);
+
 	Texture* t = new Texture(tw0, TEX0, TEXA);
 
-	m_textures.insert(t);
+	if (m_free_slots.empty())
+	{
+		const u32 slot = static_cast<u32>(m_slots.size());
+		if (slot % SLOTS_PER_WORD == 0)
+		{
+			m_page_index.emplace_back();
+			m_page_index.back().fill(0);
+		}
+
+		t->m_slot = slot;
+		m_slots.push_back(t);
+	}
+	else
+	{
+		t->m_slot = m_free_slots.back();
+		m_free_slots.pop_back();
+		m_slots[t->m_slot] = t;
+	}
 
-	t->m_pages.loopPages([this, t](u32 page)
+	std::array<u64, GS_MAX_PAGES>& index = m_page_index[t->m_slot / SLOTS_PER_WORD];
+	const u64 bit = 1ULL << (t->m_slot % SLOTS_PER_WORD);
+
+	t->m_pages.loopPages([&index, bit](u32 page)
 	{
-		t->m_erase_it[page] = m_map[page].InsertFront(t);
+		index[page] |= bit;
 	});
 
 	return t;
 }
 
+void GSTextureCacheSW::MarkDirty(u32 page, u32 blocks)
+{
+	m_dirty_blocks[page] |= blocks;
+	m_dirty_begin = std::min(m_dirty_begin, page);
+	m_dirty_end = std::max(m_dirty_end, page + 1);
+}
+
 void GSTextureCacheSW::InvalidatePages(const GSOffset::PageLooper& pages, u32 psm)
 {
-	pages.loopPages([this, psm](u32 page)
+	pages.loopPages([this](u32 page)
+	{
+		MarkDirty(page, 0xFFFFFFFF);
+	});
+
+	InvalidateDirty(psm);
+}
+
+void GSTextureCacheSW::InvalidateBlocks(const GSOffset& off, const GSVector4i& rect)
+{
+	if (off.isPageAligned(rect))
+	{
+		InvalidatePages(off.pageLooperForRect(rect), off.psm());
+		return;
+	}
+
+	off.loopBlocks(rect, [this](u32 block)
+	{
+		MarkDirty(block >> 5, 1u << (block & 31));
+	});
+
+	InvalidateDirty(off.psm());
+}
+
+void GSTextureCacheSW::InvalidateDirty(u32 psm)
+{
+	if (m_dirty_begin >= m_dirty_end)
+		return;
+
+	// Vectors of 4 pages, the dirty masks outside of the range are zero
+	const u32 begin = m_dirty_begin & ~3u;
+	const u32 end = (m_dirty_end + 3) & ~3u;
+
+	// Collect the textures on any of the dirty pages
+
+	m_affected.assign(m_page_index.size(), 0);
+
+	for (u32 page = m_dirty_begin; page < m_dirty_end; page++)
 	{
-		for (Texture* t : m_map[page])
+		if (m_dirty_blocks[page] == 0)
+			continue;
+
+		for (size_t word = 0; word < m_page_index.size(); word++)
 		{
-			if (GSUtil::HasSharedBits(psm, t->m_sharedbits))
-			{
-				u32* RESTRICT valid = t->m_valid;
+			m_affected[word] |= m_page_index[word][page];
+		}
+	}
+
+	for (size_t word = 0; word < m_affected.size(); word++)
+	{
+		for (u64 bits = m_affected[word]; bits != 0; bits &= bits - 1)
+		{
+			Texture* t = m_slots[word * SLOTS_PER_WORD + std::countr_zero(bits)];
 
-				if (t->m_repeating)
+			if (!GSUtil::HasSharedBits(psm, t->m_sharedbits))
+				continue;
+
+			u32* RESTRICT valid = t->m_valid;
+
+			if (t->m_repeating)
+			{
+				for (u32 page = m_dirty_begin; page < m_dirty_end; page++)
 				{
+					if (m_dirty_blocks[page] == 0)
+						continue;
+
 					for (const GSVector2i& j : t->m_p2t[page])
 					{
 						valid[j.x] &= j.y;
 					}
 				}
-				else
+			}
+			else
+			{
+				// Valid bits are indexed by block number, so the written blocks can be cleared directly
+				for (u32 page = begin; page < end; page += 4)
 				{
-					valid[page] = 0;
+					const GSVector4i v = GSVector4i::load<true>(&valid[page]);
+					const GSVector4i d = GSVector4i::load<true>(&m_dirty_blocks[page]);
+					GSVector4i::store<true>(&valid[page], v.andnot(d));
 				}
-
-				t->m_complete = false;
 			}
+
+			t->m_complete = false;
 		}
+	}
+
+	std::memset(&m_dirty_blocks[begin], 0, (end - begin) * sizeof(u32));
+	m_dirty_begin = GS_MAX_PAGES;
+	m_dirty_end = 0;
+}
+
+void GSTextureCacheSW::RemoveTexture(Texture* t)
+{
+	std::array<u64, GS_MAX_PAGES>& index = m_page_index[t->m_slot / SLOTS_PER_WORD];
+	const u64 bit = 1ULL << (t->m_slot % SLOTS_PER_WORD);
+
+	t->m_pages.loopPages([&index, bit](u32 page)
+	{
+		index[page] &= ~bit;
 	});
+
+	m_slots[t->m_slot] = nullptr;
+	m_free_slots.push_back(t->m_slot);
+
+	delete t;
 }
 
 void GSTextureCacheSW::RemoveAll()
 {
-	for (auto i : m_textures)
-		delete i;
-
-	m_textures.clear();
+	for (Texture* t : m_slots)
+		delete t;
 
-	for (auto& l : m_map)
-	{
-		l.clear();
-	}
+	m_slots.clear();
+	m_free_slots.clear();
+	m_page_index.clear();
 }
 
 void GSTextureCacheSW::IncAge()
 {
-	for (auto i = m_textures.begin(); i != m_textures.end();)
+	for (Texture* t : m_slots)
 	{
-		Texture* const t = *i;
-
-		if (++t->m_age > 10)
-		{
-			i = m_textures.erase(i);
-
-			t->m_pages.loopPages([this, t](u32 page)
-			{
-				m_map[page].EraseIndex(t->m_erase_it[page]);
-			});
-
-			delete t;
-		}
-		else
+		if (t && ++t->m_age > 10)
 		{
-			++i;
+			RemoveTexture(t);
 		}
 	}
 }
@@ -133,6 +233,7 @@ GSTextureCacheSW::Texture::Texture(u32 tw0, const GIFRegTEX0& TEX0, const GIFReg
 	, m_age(0)
 	, m_complete(false)
 	, m_p2t(nullptr)
+	, m_slot(0)
 {
 	if (m_tw == 0)
 	{
@@ -4,8 +4,8 @@
 #pragma once
 
 #include "GS/Renderers/Common/GSRenderer.h"
-#include "GS/Renderers/Common/GSFastList.h"
-#include <unordered_set>
+#include <array>
+#include <vector>
 
 class GSTextureCacheSW
 {
@@ -23,8 +23,8 @@ public:
 		bool m_complete;
 		bool m_repeating;
 		std::vector<GSVector2i>* m_p2t;
-		u32 m_valid[GS_MAX_PAGES];
-		std::array<u16, GS_MAX_PAGES> m_erase_it;
+		u32 m_slot;
+		alignas(16) u32 m_valid[GS_MAX_PAGES];
 		const u32* RESTRICT m_sharedbits;
 
 		// m_valid
@@ -41,8 +41,21 @@ public:
 	};
 
 protected:
-	std::unordered_set<Texture*> m_textures;
-	std::array<FastList<Texture*>, GS_MAX_PAGES> m_map;
+	// Each texture has a slot, and each page a bitset of the slots of the textures using it.
+	static constexpr u32 SLOTS_PER_WORD = 64;
+	std::vector<Texture*> m_slots; // nullptr for free slots
+	std::vector<u32> m_free_slots;
+	std::vector<std::array<u64, GS_MAX_PAGES>> m_page_index; // [slot / SLOTS_PER_WORD][page]
+	std::vector<u64> m_affected;
+
+	// Blocks written since the last invalidation, a mask of the 32 blocks of each page.
+	alignas(16) u32 m_dirty_blocks[GS_MAX_PAGES] = {};
+	u32 m_dirty_begin = GS_MAX_PAGES;
+	u32 m_dirty_end = 0;
+
+	void MarkDirty(u32 page, u32 blocks);
+	void InvalidateDirty(u32 psm);
+	void RemoveTexture(Texture* t);
 
 public:
 	GSTextureCacheSW();
@@ -51,6 +64,8 @@ public:
 	Texture* Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, u32 tw0 = 0);
 
 	void InvalidatePages(const GSOffset::PageLooper& pages, u32 psm);
+	// Only invalidates the blocks inside the rect, so the rest of a page doesn't need reloading.
+	void InvalidateBlocks(const GSOffset& off, const GSVector4i& rect);
 
 	void RemoveAll();
 	void IncAge();
@@ -19,9 +19,12 @@
 #include <sstream>
 #include "fmt/format.h"
 #include "fmt/ranges.h"
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <optional>
+#include <span>
+#include <unordered_set>
 
 namespace GameDatabaseSchema
 {
@@ -32,13 +35,226 @@ namespace GameDatabaseSchema
 
 namespace GameDatabase
 {
-	static void parseAndInsert(const std::string_view serial, const ryml::NodeRef& node);
+	static const GameDatabaseSchema::GameEntry* parseAndInsert(const std::string_view serial, const ryml::NodeRef& node);
 	static void initDatabase();
 } // namespace GameDatabase
 
+namespace
+{
+	/// Sorted index of the top level entries of a YAML database, built once and kept in the cache directory.
+	/// Lookups are a binary search over the mapped index, and only the matching entry's YAML is parsed.
+	class YAMLIndex
+	{
+	public:
+		struct BuildEntry
+		{
+			std::string key;
+			u32 offset;
+			u32 length;
+		};
+
+		/// Splits the source into entries, in file order. Duplicate keys are dropped after the first.
+		using BuildFunction = void (*)(std::string_view source, std::vector<BuildEntry>* entries);
+
+		~YAMLIndex() { Close(); }
+
+		bool Open(const char* source_path, const char* index_path, BuildFunction build);
+		void Close();
+
+		bool IsOpen() const { return !m_source.empty(); }
+		u32 GetEntryCount() const { return static_cast<u32>(m_entries.size()); }
+
+		/// Returns the offset of the entry's YAML in the source, or -1 if the key isn't indexed.
+		s64 Find(std::string_view key, std::string_view* yaml) const;
+
+	private:
+		enum : u32
+		{
+			INDEX_MAGIC = 0x58444259, // YBDX
+			INDEX_VERSION = 1,
+		};
+
+		struct Header
+		{
+			u32 magic;
+			u32 version;
+			u64 source_size;
+			s64 source_modification_time;
+			u32 num_entries;
+			u32 keys_size;
+		};
+
+		struct Entry
+		{
+			u32 key_offset;
+			u32 key_length;
+			u32 offset;
+			u32 length;
+		};
+
+		bool UseIndex(std::span<const u8> index, const FILESYSTEM_STAT_DATA& sd);
+		static std::vector<u8> BuildIndex(std::string_view source, const FILESYSTEM_STAT_DATA& sd, BuildFunction build);
+
+		std::span<const u8> m_source;
+		std::span<const u8> m_index;
+		std::vector<u8> m_index_storage;
+		std::span<const Entry> m_entries;
+		std::string_view m_keys;
+	};
+} // namespace
+
+bool YAMLIndex::Open(const char* source_path, const char* index_path, BuildFunction build)
+{
+	Close();
+
+	FILESYSTEM_STAT_DATA sd;
+	if (!FileSystem::StatFile(source_path, &sd))
+		return false;
+
+	m_source = FileSystem::MapBinaryFileForRead(source_path);
+	if (m_source.empty())
+		return false;
+
+	std::span<const u8> index = FileSystem::MapBinaryFileForRead(index_path);
+	if (!index.empty())
+	{
+		if (UseIndex(index, sd))
+		{
+			m_index = index;
+			return true;
+		}
+
+		FileSystem::UnmapFile(index);
+	}
+
+	Common::Timer timer;
+	m_index_storage = BuildIndex(std::string_view(reinterpret_cast<const char*>(m_source.data()), m_source.size()), sd, build);
+	if (!UseIndex(m_index_storage, sd))
+	{
+		Close();
+		return false;
+	}
+
+	// Keep using the built index even if it can't be saved, it just gets rebuilt next time.
+	if (!FileSystem::WriteBinaryFile(index_path, m_index_storage.data(), m_index_storage.size()))
+		Console.WarningFmt("Failed to write YAML index to '{}'", index_path);
+
+	DevCon.WriteLn("Built index of %u entries for '%s' in %.2fms", GetEntryCount(), source_path, timer.GetTimeMilliseconds());
+	return true;
+}
+
+void YAMLIndex::Close()
+{
+	if (!m_index.empty())
+		FileSystem::UnmapFile(m_index);
+	if (!m_source.empty())
+		FileSystem::UnmapFile(m_source);
+
+	m_source = {};
+	m_index = {};
+	m_index_storage = {};
+	m_entries = {};
+	m_keys = {};
+}
+
+bool YAMLIndex::UseIndex(std::span<const u8> index, const FILESYSTEM_STAT_DATA& sd)
+{
+	if (index.size() < sizeof(Header))
+		return false;
+
+	Header header;
+	std::memcpy(&header, index.data(), sizeof(header));
+	if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION ||
+		header.source_size != static_cast<u64>(sd.Size) || header.source_modification_time != static_cast<s64>(sd.ModificationTime) ||
+		index.size() != sizeof(Header) + static_cast<u64>(header.num_entries) * sizeof(Entry) + header.keys_size)
+	{
+		return false;
+	}
+
+	m_entries = std::span<const Entry>(reinterpret_cast<const Entry*>(index.data() + sizeof(Header)), header.num_entries);
+	m_keys = std::string_view(reinterpret_cast<const char*>(m_entries.data() + header.num_entries), header.keys_size);
+
+	for (const Entry& entry : m_entries)
+	{
+		if (static_cast<u64>(entry.key_offset) + entry.key_length > m_keys.size() ||
+			static_cast<u64>(entry.offset) + entry.length > m_source.size())
+		{
+			m_entries = {};
+			m_keys = {};
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::vector<u8> YAMLIndex::BuildIndex(std::string_view source, const FILESYSTEM_STAT_DATA& sd, BuildFunction build)
+{
+	std::vector<BuildEntry> build_entries;
+	build(source, &build_entries);
+
+	std::stable_sort(build_entries.begin(), build_entries.end(),
+		[](const BuildEntry& lhs, const BuildEntry& rhs) { return lhs.key < rhs.key; });
+	build_entries.erase(std::unique(build_entries.begin(), build_entries.end(),
+							[](const BuildEntry& lhs, const BuildEntry& rhs) { return lhs.key == rhs.key; }),
+		build_entries.end());
+
+	std::vector<Entry> entries;
+	std::string keys;
+	entries.reserve(build_entries.size());
+	for (const BuildEntry& be : build_entries)
+	{
+		entries.push_back({static_cast<u32>(keys.size()), static_cast<u32>(be.key.size()), be.offset, be.length});
+		keys.append(be.key);
+	}
+
+	const Header header = {INDEX_MAGIC, INDEX_VERSION, static_cast<u64>(sd.Size), static_cast<s64>(sd.ModificationTime),
+		static_cast<u32>(entries.size()), static_cast<u32>(keys.size())};
+
+	std::vector<u8> index(sizeof(Header) + entries.size() * sizeof(Entry) + keys.size());
+	std::memcpy(index.data(), &header, sizeof(header));
+	std::memcpy(index.data() + sizeof(Header), entries.data(), entries.size() * sizeof(Entry));
+	std::memcpy(index.data() + sizeof(Header) + entries.size() * sizeof(Entry), keys.data(), keys.size());
+	return index;
+}
+
+s64 YAMLIndex::Find(std::string_view key, std::string_view* yaml) const
+{
+	const auto get_key = [this](const Entry& entry) { return m_keys.substr(entry.key_offset, entry.key_length); };
+	const auto iter = std::lower_bound(m_entries.begin(), m_entries.end(), key,
+		[&get_key](const Entry& entry, std::string_view key) { return get_key(entry) < key; });
+	if (iter == m_entries.end() || get_key(*iter) != key)
+		return -1;
+
+	*yaml = std::string_view(reinterpret_cast<const char*>(m_source.data()) + iter->offset, iter->length);
+	return iter->offset;
+}
+
+/// Returns the next line of the source, advancing offset past it.
+static std::string_view getNextLine(std::string_view source, size_t* offset)
+{
+	const size_t start = *offset;
+	const size_t end = source.find('\n', start);
+	*offset = (end != std::string_view::npos) ? (end + 1) : source.size();
+	return source.substr(start, *offset - start);
+}
+
+/// Strips whitespace and quotes from a scalar.
+static std::string_view getScalar(std::string_view str)
+{
+	str = StringUtil::StripWhitespace(str);
+	if (str.size() >= 2 && (str.front() == '"' || str.front() == '\'') && str.back() == str.front())
+		str = str.substr(1, str.size() - 2);
+	return str;
+}
+
 static constexpr char GAMEDB_YAML_FILE_NAME[] = "GameIndex.yaml";
+static constexpr char GAMEDB_INDEX_FILE_NAME[] = "gameindex.idx";
 
+// Entries are parsed the first time they are looked up, and never removed, so pointers to them stay valid.
+static YAMLIndex s_game_db_index;
 static std::unordered_map<std::string, GameDatabaseSchema::GameEntry> s_game_db;
+static std::mutex s_game_db_mutex;
 static std::once_flag s_load_once_flag;
 
 std::string GameDatabaseSchema::GameEntry::memcardFiltersAsString() const
@@ -83,7 +299,7 @@ const char* GameDatabaseSchema::GameEntry::compatAsString() const
 	}
 }
 
-void GameDatabase::parseAndInsert(const std::string_view serial, const ryml::NodeRef& node)
+const GameDatabaseSchema::GameEntry* GameDatabase::parseAndInsert(const std::string_view serial, const ryml::NodeRef& node)
 {
 	GameDatabaseSchema::GameEntry gameEntry;
 	if (node.has_child("name"))
@@ -349,7 +565,7 @@ void GameDatabase::parseAndInsert(const std::string_view serial, const ryml::Nod
 		}
 	}
 
-	s_game_db.emplace(std::move(serial), std::move(gameEntry));
+	return &s_game_db.emplace(serial, std::move(gameEntry)).first->second;
 }
 
 static const char* s_round_modes[static_cast<u32>(FPRoundMode::MaxCount)] = {
@@ -971,50 +1187,44 @@ void GameDatabaseSchema::GameEntry::applyGSHardwareFixes(Pcsx2Config::GSOptions&
 	}
 }
 
-void GameDatabase::initDatabase()
+static void buildGameDatabaseIndex(std::string_view source, std::vector<YAMLIndex::BuildEntry>* entries)
 {
-	const std::string path(Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME));
-	const std::string name(GAMEDB_YAML_FILE_NAME);
-
-	const std::optional<std::string> buffer = FileSystem::ReadFileToString(path.c_str());
-	if (!buffer.has_value())
-	{
-		Console.Error("GameDB: Unable to open GameDB file, file does not exist.");
-		return;
-	}
-
-	const ryml::csubstr yaml = ryml::to_csubstr(*buffer);
-
-	Error error;
-	std::optional<ryml::Tree> tree = ParseYAMLFromString(yaml, ryml::to_csubstr(name), &error);
-	if (!tree.has_value())
+	// Every game is a map under a serial key at the start of a line, everything up to the next serial belongs to it.
+	std::unordered_set<std::string> serials;
+	size_t offset = 0;
+	while (offset < source.size())
 	{
-		Console.ErrorFmt("GameDB: Failed to parse game database file {}:", path);
-		Console.Error(error.GetDescription());
-		return;
-	}
-
-	ryml::NodeRef root = tree->rootref();
+		const size_t line_start = offset;
+		const std::string_view line = getNextLine(source, &offset);
+		const size_t colon = line.find(':');
+		if (line.empty() || std::strchr(" \t\r\n#-", line.front()) || colon == std::string_view::npos)
+			continue;
 
-	for (const ryml::NodeRef& n : root.children())
-	{
-		auto serial = StringUtil::toLower(std::string(n.key().str, n.key().len));
+		if (!entries->empty())
+			entries->back().length = static_cast<u32>(line_start - entries->back().offset);
 
 		// Serials and CRCs must be inserted as lower-case, as that is how they are retrieved
 		// this is because the application may pass a lowercase CRC or serial along
 		//
 		// However, YAML's keys are as expected case-sensitive, so we have to explicitly do our own duplicate checking
-		if (s_game_db.count(serial) == 1)
-		{
+		std::string serial = StringUtil::toLower(getScalar(line.substr(0, colon)));
+		if (!serials.insert(serial).second)
 			Console.ErrorFmt("GameDB: Duplicate serial '{}' found in GameDB. Skipping, Serials are case-insensitive!", serial);
-			continue;
-		}
 
-		if (n.is_map())
-		{
-			parseAndInsert(serial, n);
-		}
+		entries->push_back({std::move(serial), static_cast<u32>(line_start), 0});
 	}
+
+	if (!entries->empty())
+		entries->back().length = static_cast<u32>(source.size() - entries->back().offset);
+}
+
+void GameDatabase::initDatabase()
+{
+	const std::string path(Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME));
+	const std::string index_path(Path::Combine(EmuFolders::Cache, GAMEDB_INDEX_FILE_NAME));
+
+	if (!s_game_db_index.Open(path.c_str(), index_path.c_str(), buildGameDatabaseIndex))
+		Console.Error("GameDB: Unable to open GameDB file, file does not exist.");
 }
 
 void GameDatabase::ensureLoaded()
@@ -1023,7 +1233,7 @@ void GameDatabase::ensureLoaded()
 		Common::Timer timer;
 		Console.WriteLn(fmt::format("GameDB: Has not been initialized yet, initializing..."));
 		initDatabase();
-		Console.WriteLn("GameDB: %zu games on record (loaded in %.2fms)", s_game_db.size(), timer.GetTimeMilliseconds());
+		Console.WriteLn("GameDB: %u games on record (loaded in %.2fms)", s_game_db_index.GetEntryCount(), timer.GetTimeMilliseconds());
 	});
 }
 
@@ -1031,8 +1241,32 @@ const GameDatabaseSchema::GameEntry* GameDatabase::findGame(const std::string_vi
 {
 	GameDatabase::ensureLoaded();
 
-	auto iter = s_game_db.find(StringUtil::toLower(serial));
-	return (iter != s_game_db.end()) ? &iter->second : nullptr;
+	const std::string key = StringUtil::toLower(serial);
+
+	std::unique_lock lock(s_game_db_mutex);
+	auto iter = s_game_db.find(key);
+	if (iter != s_game_db.end())
+		return &iter->second;
+
+	std::string_view yaml;
+	if (s_game_db_index.Find(key, &yaml) < 0)
+		return nullptr;
+
+	Error error;
+	std::optional<ryml::Tree> tree = ParseYAMLFromString(
+		ryml::csubstr(yaml.data(), yaml.size()), ryml::to_csubstr(GAMEDB_YAML_FILE_NAME), &error);
+	if (!tree.has_value())
+	{
+		Console.ErrorFmt("GameDB: Failed to parse entry for {}:", serial);
+		Console.Error(error.GetDescription());
+		return nullptr;
+	}
+
+	ryml::NodeRef root = tree->rootref();
+	if (!root.is_map() || root.num_children() == 0 || !root.first_child().is_map())
+		return nullptr;
+
+	return parseAndInsert(key, root.first_child());
 }
 
 bool GameDatabase::TrackHash::parseHash(const std::string_view str)
@@ -1069,40 +1303,73 @@ std::string GameDatabase::TrackHash::toString() const
 		data[8], data[9], data[10], data[11], data[12], data[13], data[14], data[15]);
 }
 
-struct TrackHashHasher
+static constexpr char HASHDB_YAML_FILE_NAME[] = "RedumpDatabase.yaml";
+static constexpr char HASHDB_INDEX_FILE_NAME[] = "redumpdatabase.idx";
+
+// Keyed by every track's hash, entries are parsed on lookup and stored by their offset in the source.
+static YAMLIndex s_hash_database_index;
+static std::unordered_map<u32, GameDatabase::HashDatabaseEntry> s_hash_database;
+
+static void buildHashDatabaseIndex(std::string_view source, std::vector<YAMLIndex::BuildEntry>* entries)
 {
-	size_t operator()(const GameDatabase::TrackHash& hash) const
+	// Entries are list items at the start of a line, with the hashes of their tracks somewhere within.
+	std::unordered_set<std::string> first_track_hashes;
+	size_t entry_start = std::string_view::npos;
+	size_t entry_first_key = 0;
+	size_t offset = 0;
+
+	const auto finish_entry = [&](size_t entry_end) {
+		for (size_t i = entry_first_key; i < entries->size(); i++)
+			(*entries)[i].length = static_cast<u32>(entry_end - entry_start);
+	};
+
+	while (offset < source.size())
 	{
-		return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char*>(hash.data),
-			GameDatabase::TrackHash::SIZE));
+		const size_t line_start = offset;
+		const std::string_view line = getNextLine(source, &offset);
+		if (line.starts_with("- ") || line.starts_with("-\n") || line.starts_with("-\r"))
+		{
+			if (entry_start != std::string_view::npos)
+				finish_entry(line_start);
+
+			entry_start = line_start;
+			entry_first_key = entries->size();
+		}
+
+		const size_t md5 = line.find("md5:");
+		if (entry_start == std::string_view::npos || md5 == std::string_view::npos)
+			continue;
+
+		std::string hash = StringUtil::toLower(getScalar(line.substr(md5 + 4)));
+		if (entries->size() == entry_first_key && !first_track_hashes.insert(hash).second)
+			Console.WarningFmt("[HashDatabase] Duplicate first track hash {}", hash);
+
+		entries->push_back({std::move(hash), static_cast<u32>(entry_start), 0});
 	}
-};
 
-static constexpr char HASHDB_YAML_FILE_NAME[] = "RedumpDatabase.yaml";
-std::unordered_map<GameDatabase::TrackHash, u32, TrackHashHasher> s_track_hash_to_entry_map;
-std::vector<GameDatabase::HashDatabaseEntry> s_hash_database;
+	if (entry_start != std::string_view::npos)
+		finish_entry(source.size());
+}
 
-static bool parseHashDatabaseEntry(const ryml::NodeRef& node)
+static bool parseHashDatabaseEntry(const ryml::ConstNodeRef& node, GameDatabase::HashDatabaseEntry* entry)
 {
-	if (!node.has_child("name") || !node.has_child("hashes"))
+	if (!node.is_map() || !node.has_child("name") || !node.has_child("hashes"))
 	{
 		Console.Warning("[HashDatabase] Incomplete entry found.");
 		return false;
 	}
 
-	GameDatabase::HashDatabaseEntry entry;
-	node["name"] >> entry.name;
+	node["name"] >> entry->name;
 	if (node.has_child("version"))
-		node["version"] >> entry.version;
+		node["version"] >> entry->version;
 	if (node.has_child("serial"))
-		node["serial"] >> entry.serial;
+		node["serial"] >> entry->serial;
 
-	const u32 index = static_cast<u32>(s_hash_database.size());
 	for (const ryml::ConstNodeRef& n : node["hashes"].children())
 	{
 		if (!n.is_map() || !n.has_child("size") || !n.has_child("md5"))
 		{
-			Console.ErrorFmt("[HashDatabase] Incomplete hash definition in {}", entry.name);
+			Console.ErrorFmt("[HashDatabase] Incomplete hash definition in {}", entry->name);
 			return false;
 		}
 
@@ -1113,75 +1380,70 @@ static bool parseHashDatabaseEntry(const ryml::NodeRef& node)
 
 		if (!th.parseHash(md5))
 		{
-			Console.ErrorFmt("[HashDatabase] Failed to parse hash in {}: '{}'", entry.name, md5);
+			Console.ErrorFmt("[HashDatabase] Failed to parse hash in {}: '{}'", entry->name, md5);
 			return false;
 		}
 
-		if (entry.tracks.empty() && s_track_hash_to_entry_map.find(th) != s_track_hash_to_entry_map.end())
-			Console.WarningFmt("[HashDatabase] Duplicate first track hash in {}", entry.name);
-
-		entry.tracks.push_back(th);
-		s_track_hash_to_entry_map.emplace(th, index);
+		entry->tracks.push_back(th);
 	}
 
-	s_hash_database.push_back(std::move(entry));
 	return true;
 }
 
-bool GameDatabase::loadHashDatabase()
+/// Finds the entry containing the track, its id is the same for every track of the entry.
+static const GameDatabase::HashDatabaseEntry* findHashDatabaseEntry(const GameDatabase::TrackHash& track, u32* id)
 {
-	if (!s_hash_database.empty())
-		return true;
-
-	Common::Timer load_timer;
-
-	const std::string path(Path::Combine(EmuFolders::Resources, HASHDB_YAML_FILE_NAME));
-	const std::string name(HASHDB_YAML_FILE_NAME);
-
-	std::optional<std::string> buffer = FileSystem::ReadFileToString(path.c_str());
-	if (!buffer.has_value())
-	{
-		Console.Error("[HashDatabase] Unable to open hash database file, file does not exist.");
-		return false;
-	}
+	std::string_view yaml;
+	const s64 offset = s_hash_database_index.Find(track.toString(), &yaml);
+	if (offset < 0)
+		return nullptr;
 
-	ryml::csubstr yaml = ryml::to_csubstr(*buffer);
+	*id = static_cast<u32>(offset);
+	auto iter = s_hash_database.find(*id);
+	if (iter != s_hash_database.end())
+		return &iter->second;
 
 	Error error;
-	std::optional<ryml::Tree> tree = ParseYAMLFromString(yaml, ryml::to_csubstr(name), &error);
+	std::optional<ryml::Tree> tree = ParseYAMLFromString(
+		ryml::csubstr(yaml.data(), yaml.size()), ryml::to_csubstr(HASHDB_YAML_FILE_NAME), &error);
 	if (!tree.has_value())
 	{
-		Console.ErrorFmt("[HashDatabase] Failed to parse hash database file {}:", path);
+		Console.ErrorFmt("[HashDatabase] Failed to parse entry for {}:", track.toString());
 		Console.Error(error.GetDescription());
-		return false;
+		return nullptr;
 	}
 
-	ryml::NodeRef root = tree->rootref();
+	const ryml::ConstNodeRef root = tree->crootref();
+	GameDatabase::HashDatabaseEntry entry;
+	if (!root.is_seq() || root.num_children() == 0 || !parseHashDatabaseEntry(root.first_child(), &entry))
+		return nullptr;
 
-	bool okay = true;
-	for (const ryml::NodeRef& n : root.children())
-	{
-		if (!parseHashDatabaseEntry(n))
-		{
-			okay = false;
-			break;
-		}
-	}
+	return &s_hash_database.emplace(*id, std::move(entry)).first->second;
+}
+
+bool GameDatabase::loadHashDatabase()
+{
+	if (s_hash_database_index.IsOpen())
+		return true;
 
-	if (!okay)
+	Common::Timer load_timer;
+
+	const std::string path(Path::Combine(EmuFolders::Resources, HASHDB_YAML_FILE_NAME));
+	const std::string index_path(Path::Combine(EmuFolders::Cache, HASHDB_INDEX_FILE_NAME));
+
+	if (!s_hash_database_index.Open(path.c_str(), index_path.c_str(), buildHashDatabaseIndex))
 	{
-		s_track_hash_to_entry_map.clear();
-		s_hash_database.clear();
+		Console.Error("[HashDatabase] Unable to open hash database file, file does not exist.");
 		return false;
 	}
 
-	Console.WriteLn(Color_StrongGreen, "[HashDatabase] Loaded YAML in %.0f ms", load_timer.GetTimeMilliseconds());
+	Console.WriteLn(Color_StrongGreen, "[HashDatabase] Loaded index in %.0f ms", load_timer.GetTimeMilliseconds());
 	return true;
 }
 
 void GameDatabase::unloadHashDatabase()
 {
-	s_track_hash_to_entry_map.clear();
+	s_hash_database_index.Close();
 	s_hash_database.clear();
 }
 
@@ -1208,8 +1470,9 @@ const GameDatabase::HashDatabaseEntry* GameDatabase::lookupHash(
 	}
 
 	// match the first track, for DVDs this will be all there is anyway
-	const auto data_iter = s_track_hash_to_entry_map.find(tracks[0]);
-	if (data_iter == s_track_hash_to_entry_map.end())
+	u32 data_id;
+	const GameDatabase::HashDatabaseEntry* candidate = findHashDatabaseEntry(tracks[0], &data_id);
+	if (!candidate)
 	{
 		*match_error = fmt::format(TRANSLATE_FS("GameDatabase", "Hash {} is not in database."), tracks[0].toString());
 		std::memset(tracks_matched, 0, sizeof(bool) * num_tracks);
@@ -1217,7 +1480,6 @@ const GameDatabase::HashDatabaseEntry* GameDatabase::lookupHash(
 	}
 
 	// make sure they're not missing the data track
-	const GameDatabase::HashDatabaseEntry* candidate = &s_hash_database[data_iter->second];
 	if (getTrackIndex(candidate->tracks.data(), candidate->tracks.size(), tracks[0]) != 0)
 	{
 		*match_error = TRANSLATE_STR("GameDatabase", "Data track number does not match data track in database.");
@@ -1233,8 +1495,9 @@ const GameDatabase::HashDatabaseEntry* GameDatabase::lookupHash(
 	bool all_okay = true;
 	for (size_t track = 1; track < num_tracks; track++)
 	{
-		const auto audio_iter = s_track_hash_to_entry_map.find(tracks[track]);
-		if (audio_iter != s_track_hash_to_entry_map.end())
+		u32 audio_id;
+		const GameDatabase::HashDatabaseEntry* audio_entry = findHashDatabaseEntry(tracks[track], &audio_id);
+		if (!audio_entry)
 		{
 			fmt::format_to(std::back_inserter(*match_error),
 				TRANSLATE_FS("GameDatabase", "Track {0} with hash {1} is not found in database.\n"), track + 1,
@@ -1245,11 +1508,11 @@ const GameDatabase::HashDatabaseEntry* GameDatabase::lookupHash(
 		}
 
 		// same game?
-		if (audio_iter->second != data_iter->second)
+		if (audio_id != data_id)
 		{
 			fmt::format_to(std::back_inserter(*match_error),
 				TRANSLATE_FS("GameDatabase", "Track {0} with hash {1} is for a different game ({2}).\n"), track + 1,
-				tracks[track].toString(), s_hash_database[audio_iter->second].name);
+				tracks[track].toString(), audio_entry->name);
 			tracks_matched[track] = false;
 			all_okay = false;
 			continue;
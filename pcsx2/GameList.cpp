@@ -14,18 +14,23 @@
 #include "common/Error.h"
 #include "common/HTTPDownloader.h"
 #include "common/HeterogeneousContainers.h"
+#include "common/MD5Digest.h"
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <string_view>
+#include <thread>
 #include <utility>
 
 #ifdef _WIN32
@@ -37,8 +42,12 @@ namespace GameList
 	enum : u32
 	{
 		GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-		GAME_LIST_CACHE_VERSION = 34,
+		GAME_LIST_CACHE_VERSION = 35,
 
+		FINGERPRINT_CHUNK_SIZE = 64 * 1024,
+		FINGERPRINT_MIN_SIZE = 4 * 1024 * 1024,
+		MAX_SCAN_WORKERS = 8,
+		MAX_FINGERPRINTS_AHEAD = 2 * MAX_SCAN_WORKERS,
 
 		PLAYED_TIME_SERIAL_LENGTH = 32,
 		PLAYED_TIME_LAST_TIME_LENGTH = 20, // uint64
@@ -53,6 +62,7 @@ namespace GameList
 	};
 
 	using CacheMap = UnorderedStringMap<Entry>;
+	using FingerprintCacheMap = std::unordered_map<u64, Entry>;
 	using PlayedTimeMap = UnorderedStringMap<PlayedTimeEntry>;
 
 	static bool IsScannableFilename(const std::string_view path);
@@ -62,11 +72,14 @@ namespace GameList
 	static bool GetElfListEntry(const std::string& path, GameList::Entry* entry);
 	static bool GetIsoListEntry(const std::string& path, GameList::Entry* entry);
 
+	static u64 GetFileFingerprint(const std::string& path, s64 size);
 	static bool GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry);
+	static bool GetGameListEntryFromFingerprint(const std::string& path, u64 fingerprint, std::time_t timestamp, GameList::Entry* entry);
+	static bool IsPathInCache(const std::string& path, std::time_t timestamp);
 	static void ScanDirectory(const char* path, bool recursive, bool only_cache, const std::vector<std::string>& excluded_paths,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress);
 	static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
-	static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
+	static bool ScanFile(std::string path, std::time_t timestamp, u64 fingerprint, std::unique_lock<std::recursive_mutex>& lock,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
 
 	static void LoadCache();
@@ -92,6 +105,7 @@ namespace GameList
 static std::vector<GameList::Entry> s_entries;
 static std::recursive_mutex s_mutex;
 static GameList::CacheMap s_cache_map;
+static GameList::FingerprintCacheMap s_cache_fingerprint_map;
 static std::FILE* s_cache_write_stream = nullptr;
 
 const char* GameList::EntryTypeToString(EntryType type, bool translate)
@@ -445,6 +459,40 @@ bool GameList::PopulateEntryFromPath(const std::string& path, GameList::Entry* e
 		return GetIsoListEntry(path, entry);
 }
 
+u64 GameList::GetFileFingerprint(const std::string& path, s64 size)
+{
+	// Small files, like cue sheets, can be identical between games.
+	if (size < FINGERPRINT_MIN_SIZE)
+		return 0;
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "rb");
+	if (!fp)
+		return 0;
+
+	// The start holds the image header or the volume descriptors, and reading it also
+	// warms the OS cache for the serial detection if the file does need scanning.
+	const std::unique_ptr<u8[]> buffer = std::make_unique<u8[]>(FINGERPRINT_CHUNK_SIZE);
+	MD5Digest digest;
+	digest.Update(&size, sizeof(size));
+	for (const s64 offset : {static_cast<s64>(0), size - FINGERPRINT_CHUNK_SIZE})
+	{
+		if (FileSystem::FSeek64(fp.get(), offset, SEEK_SET) != 0 ||
+			std::fread(buffer.get(), FINGERPRINT_CHUNK_SIZE, 1, fp.get()) != 1)
+		{
+			return 0;
+		}
+
+		digest.Update(buffer.get(), FINGERPRINT_CHUNK_SIZE);
+	}
+
+	u8 hash[16];
+	digest.Final(hash);
+
+	u64 fingerprint;
+	std::memcpy(&fingerprint, hash, sizeof(fingerprint));
+	return (fingerprint != 0) ? fingerprint : 1;
+}
+
 bool GameList::GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry)
 {
 	auto iter = s_cache_map.find(path);
@@ -456,6 +504,29 @@ bool GameList::GetGameListEntryFromCache(const std::string& path, GameList::Entr
 	return true;
 }
 
+bool GameList::GetGameListEntryFromFingerprint(const std::string& path, u64 fingerprint, std::time_t timestamp, GameList::Entry* entry)
+{
+	if (fingerprint == 0)
+		return false;
+
+	// Only the start and end of the file are hashed, so a patched image can keep its fingerprint.
+	// Matching the timestamp too limits reuse to files which were moved, not modified.
+	// Entries are copied, the same image may be in more than one place.
+	auto iter = s_cache_fingerprint_map.find(fingerprint);
+	if (iter == s_cache_fingerprint_map.end() || iter->second.last_modified_time != timestamp)
+		return false;
+
+	*entry = iter->second;
+	entry->path = path;
+	return true;
+}
+
+bool GameList::IsPathInCache(const std::string& path, std::time_t timestamp)
+{
+	auto iter = s_cache_map.find(path);
+	return (iter != s_cache_map.end() && iter->second.last_modified_time == timestamp);
+}
+
 static bool ReadString(std::FILE* stream, std::string* dest)
 {
 	u32 size;
@@ -530,7 +601,7 @@ bool GameList::LoadEntriesFromCache(std::FILE* stream)
 
 		if (!ReadString(stream, &path) || !ReadString(stream, &ge.serial) || !ReadString(stream, &ge.title) || !ReadString(stream, &ge.title_sort) ||
 			!ReadString(stream, &ge.title_en) || !ReadU8(stream, &type) || !ReadU8(stream, &region) || !ReadU64(stream, &ge.total_size) ||
-			!ReadU64(stream, &last_modified_time) || !ReadU32(stream, &ge.crc) || !ReadU8(stream, &compatibility_rating) ||
+			!ReadU64(stream, &last_modified_time) || !ReadU32(stream, &ge.crc) || !ReadU64(stream, &ge.fingerprint) || !ReadU8(stream, &compatibility_rating) ||
 			region >= static_cast<u8>(Region::Count) || type >= static_cast<u8>(EntryType::Count) ||
 			compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
 		{
@@ -544,6 +615,9 @@ bool GameList::LoadEntriesFromCache(std::FILE* stream)
 		ge.compatibility_rating = static_cast<CompatibilityRating>(compatibility_rating);
 		ge.last_modified_time = static_cast<std::time_t>(last_modified_time);
 
+		if (ge.fingerprint != 0)
+			s_cache_fingerprint_map.insert_or_assign(ge.fingerprint, ge);
+
 		auto iter = s_cache_map.find(ge.path);
 		if (iter != s_cache_map.end())
 			iter->second = std::move(ge);
@@ -571,6 +645,7 @@ void GameList::LoadCache()
 		Console.Warning("Deleting corrupted cache file '%s'", cache_filename.c_str());
 		stream.reset();
 		s_cache_map.clear();
+		s_cache_fingerprint_map.clear();
 		DeleteCacheFile();
 		return;
 	}
@@ -631,6 +706,7 @@ bool GameList::WriteEntryToCache(const Entry* entry)
 	result &= WriteU64(s_cache_write_stream, entry->total_size);
 	result &= WriteU64(s_cache_write_stream, static_cast<u64>(entry->last_modified_time));
 	result &= WriteU32(s_cache_write_stream, entry->crc);
+	result &= WriteU64(s_cache_write_stream, entry->fingerprint);
 	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->compatibility_rating));
 
 	// flush after each entry, that way we don't end up with a corrupted file if we crash scanning.
@@ -702,7 +778,81 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 					(FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES),
 		&files, progress);
 
+	// Files which can't be found in the cache by their path get fingerprinted ahead of time by a pool of
+	// workers. Serial detection goes through the global CDVD state, so it stays on this thread, in order.
+	std::vector<u32> pending;
+	{
+		std::unique_lock lock(s_mutex);
+		for (u32 i = 0; i < static_cast<u32>(files.size()); i++)
+		{
+			const FILESYSTEM_FIND_DATA& ffd = files[i];
+			if (!only_cache && GameList::IsScannableFilename(ffd.FileName) && !IsPathExcluded(excluded_paths, ffd.FileName) &&
+				!GetEntryForPath(ffd.FileName.c_str()) && !IsPathInCache(ffd.FileName, ffd.ModificationTime))
+			{
+				pending.push_back(i);
+			}
+		}
+	}
+
+	std::mutex fingerprint_mutex;
+	std::condition_variable fingerprint_cv;
+	std::vector<u64> fingerprints(pending.size());
+	std::vector<bool> fingerprints_done(pending.size());
+	size_t next_fingerprint = 0;
+	size_t fingerprints_consumed = 0;
+	bool cancel_fingerprints = false;
+
+	std::vector<std::thread> workers;
+	const u32 num_workers = std::min<u32>(std::clamp<u32>(std::thread::hardware_concurrency(), 1, MAX_SCAN_WORKERS), static_cast<u32>(pending.size()));
+	for (u32 i = 0; i < num_workers; i++)
+	{
+		workers.emplace_back([&]() {
+			Threading::SetNameOfCurrentThread("Game List Scan");
+
+			std::unique_lock lock(fingerprint_mutex);
+			while (!cancel_fingerprints && next_fingerprint < pending.size())
+			{
+				// Stay a few files ahead of the scan, rather than reading the whole directory while it waits on serial detection.
+				if (next_fingerprint >= fingerprints_consumed + MAX_FINGERPRINTS_AHEAD)
+				{
+					fingerprint_cv.wait(lock);
+					continue;
+				}
+
+				if (progress->IsCancelled())
+				{
+					cancel_fingerprints = true;
+					fingerprint_cv.notify_all();
+					break;
+				}
+
+				const size_t index = next_fingerprint++;
+				const FILESYSTEM_FIND_DATA& ffd = files[pending[index]];
+
+				lock.unlock();
+				const u64 fingerprint = GetFileFingerprint(ffd.FileName, ffd.Size);
+				lock.lock();
+
+				fingerprints[index] = fingerprint;
+				fingerprints_done[index] = true;
+				fingerprint_cv.notify_all();
+			}
+		});
+	}
+
+	ScopedGuard join_workers([&]() {
+		{
+			std::unique_lock lock(fingerprint_mutex);
+			cancel_fingerprints = true;
+			fingerprint_cv.notify_all();
+		}
+
+		for (std::thread& worker : workers)
+			worker.join();
+	});
+
 	u32 files_scanned = 0;
+	size_t pending_index = 0;
 	progress->SetProgressRange(static_cast<u32>(files.size()));
 	progress->SetProgressValue(0);
 
@@ -715,15 +865,43 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 			continue;
 		}
 
-		std::unique_lock lock(s_mutex);
-		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
+		const bool is_pending = (pending_index < pending.size() && pending[pending_index] == files_scanned - 1);
+		if (is_pending)
 		{
-			continue;
+			std::unique_lock fingerprint_lock(fingerprint_mutex);
+			fingerprints_consumed = ++pending_index;
+			fingerprint_cv.notify_all();
+		}
+
+		{
+			std::unique_lock lock(s_mutex);
+			if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
+			{
+				continue;
+			}
+		}
+
+		// Fingerprinting reads the file, so the list isn't locked while waiting for it.
+		u64 fingerprint;
+		if (is_pending)
+		{
+			std::unique_lock fingerprint_lock(fingerprint_mutex);
+			fingerprint_cv.wait(fingerprint_lock, [&]() { return fingerprints_done[pending_index - 1] || cancel_fingerprints; });
+			if (!fingerprints_done[pending_index - 1])
+				continue;
+
+			fingerprint = fingerprints[pending_index - 1];
+		}
+		else
+		{
+			fingerprint = GetFileFingerprint(ffd.FileName, ffd.Size);
 		}
 
 		const std::string_view filename = Path::GetFileName(ffd.FileName);
 		progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename.data()).c_str());
-		ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini);
+
+		std::unique_lock lock(s_mutex);
+		ScanFile(std::move(ffd.FileName), ffd.ModificationTime, fingerprint, lock, played_time_map, custom_attributes_ini);
 		progress->SetProgressValue(files_scanned);
 	}
 
@@ -752,19 +930,27 @@ bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp,
 	return true;
 }
 
-bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
+bool GameList::ScanFile(std::string path, std::time_t timestamp, u64 fingerprint, std::unique_lock<std::recursive_mutex>& lock,
 	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini)
 {
 	// don't block UI while scanning
 	lock.unlock();
 
-	DevCon.WriteLn("Scanning '%s'...", path.c_str());
-
 	Entry entry;
-	if (!PopulateEntryFromPath(path, &entry))
-		return false;
+	if (GetGameListEntryFromFingerprint(path, fingerprint, timestamp, &entry))
+	{
+		DevCon.WriteLn("Found moved '%s' in cache", path.c_str());
+	}
+	else
+	{
+		DevCon.WriteLn("Scanning '%s'...", path.c_str());
+
+		if (!PopulateEntryFromPath(path, &entry))
+			return false;
+	}
 
 	entry.last_modified_time = timestamp;
+	entry.fingerprint = fingerprint;
 
 	if (s_cache_write_stream || OpenCacheForWriting())
 	{
@@ -923,6 +1109,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 	// don't need unused cache entries
 	CloseCacheFileStream();
 	s_cache_map.clear();
+	s_cache_fingerprint_map.clear();
 }
 
 bool GameList::RescanPath(const std::string& path)
@@ -944,8 +1131,8 @@ bool GameList::RescanPath(const std::string& path)
 			return false;
 	}
 
-	// re-scan!
-	if (!ScanFile(path, sd.ModificationTime, lock, played_time, custom_attributes_ini))
+	// re-scan! the fingerprint cache only exists during a refresh, so there's nothing to match against.
+	if (!ScanFile(path, sd.ModificationTime, 0, lock, played_time, custom_attributes_ini))
 		return true;
 
 	// update cache.. this is far from ideal, but since everything's variable length, all we can do.
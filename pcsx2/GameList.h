@@ -99,6 +99,9 @@ namespace GameList
 
 		u32 crc = 0;
 
+		/// Hash of the size and the start and end of the file, used to find moved files in the cache. 0 if unknown.
+		u64 fingerprint = 0;
+
 		CompatibilityRating compatibility_rating = CompatibilityRating::Unknown;
 
 		__fi bool IsDisc() const { return (type == EntryType::PS1Disc || type == EntryType::PS2Disc); }
@@ -199,7 +199,7 @@ struct Gif_Path_MTVU
 	// Set a size based on MTGS but keep a factor 2 to avoid too waste to much
 	// memory overhead. Note the struct is instantied 3 times (for each gif
 	// path)
-	ringbuffer_base<GS_Packet, MTGS::RingBufferSize / 2> gsPackQueue;
+	ringbuffer_base<GS_Packet, MTGS::DefaultRingBufferSize / 2> gsPackQueue;
 	Gif_Path_MTVU() { Reset(); }
 	void Reset()
 	{
@@ -56,6 +56,7 @@ AudioStream::AudioStream(u32 sample_rate, const AudioStreamParameters& parameter
 
 AudioStream::~AudioStream()
 {
+	StopStretchThread();
 	DestroyBuffer();
 }
 
@@ -227,12 +228,35 @@ u32 AudioStream::GetBufferedFramesRelaxed() const
 	return (wpos + m_buffer_size - rpos) % m_buffer_size;
 }
 
+AudioStream::Statistics AudioStream::GetStatistics() const
+{
+	Statistics stats;
+	stats.frames_written = m_frames_written.load(std::memory_order_relaxed);
+	stats.frames_read = m_frames_read.load(std::memory_order_relaxed);
+	stats.underruns = m_underruns.load(std::memory_order_relaxed);
+	stats.overruns = m_overruns.load(std::memory_order_relaxed);
+	stats.max_latency_frames = m_max_latency.load(std::memory_order_relaxed);
+
+	const u64 latency_samples = m_latency_samples.load(std::memory_order_relaxed);
+	stats.average_latency_frames =
+		(latency_samples > 0) ? static_cast<u32>(m_latency_sum.load(std::memory_order_relaxed) / latency_samples) : 0;
+	return stats;
+}
+
 void AudioStream::ReadFrames(SampleType* samples, u32 num_frames)
 {
-	const u32 available_frames = GetBufferedFramesRelaxed();
+	// Acquire the write position, or the frames written before it moved might not be visible yet.
+	const u32 wpos = m_wpos.load(std::memory_order_acquire);
+	const u32 available_frames = (wpos + m_buffer_size - m_rpos.load(std::memory_order_relaxed)) % m_buffer_size;
 	u32 frames_to_read = num_frames;
 	u32 silence_frames = 0;
 
+	// Only this thread writes the latency counters.
+	m_latency_sum.store(m_latency_sum.load(std::memory_order_relaxed) + available_frames, std::memory_order_relaxed);
+	m_latency_samples.store(m_latency_samples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	if (available_frames > m_max_latency.load(std::memory_order_relaxed))
+		m_max_latency.store(available_frames, std::memory_order_relaxed);
+
 	if (m_filling)
 	{
 		u32 toFill = m_buffer_size / (IsStretchEnabled() ? 32 : 400);
@@ -256,8 +280,10 @@ void AudioStream::ReadFrames(SampleType* samples, u32 num_frames)
 		frames_to_read = available_frames;
 		m_filling = true;
 
-		if (IsStretchEnabled())
-			StretchUnderrun();
+		// The stretch thread picks this up, and resets the stretcher if it keeps happening. Whatever it's holding
+		// back waiting for a whole batch is better played now.
+		m_underruns.fetch_add(1, std::memory_order_relaxed);
+		FlushStretchInput();
 	}
 
 	if (frames_to_read > 0)
@@ -285,6 +311,7 @@ void AudioStream::ReadFrames(SampleType* samples, u32 num_frames)
 		}
 
 		m_rpos.store(rpos, std::memory_order_release);
+		m_frames_read.fetch_add(frames_to_read, std::memory_order_relaxed);
 	}
 
 	if (silence_frames > 0)
@@ -341,21 +368,31 @@ void AudioStream::StereoSampleReaderImpl(SampleType* dest, const SampleType* src
 
 void AudioStream::InternalWriteFrames(const SampleType* data, u32 num_frames)
 {
-	const u32 free = m_buffer_size - GetBufferedFramesRelaxed();
+	u32 wpos = m_wpos.load(std::memory_order_relaxed);
+
+	// Only look at the backend's position again when the last one we saw doesn't leave enough space.
+	u32 free = m_buffer_size - ((wpos + m_buffer_size - m_cached_rpos) % m_buffer_size);
 	if (free <= num_frames)
 	{
-		if (IsStretchEnabled())
-		{
-			StretchOverrun();
-		}
-		else
+		m_cached_rpos = m_rpos.load(std::memory_order_acquire);
+		free = m_buffer_size - ((wpos + m_buffer_size - m_cached_rpos) % m_buffer_size);
+	}
+
+	if (free <= num_frames)
+	{
+		m_overruns.fetch_add(1, std::memory_order_relaxed);
+		if (!IsStretchEnabled())
 		{
 			LOG_UNDERRUN("Buffer overrun, chunk dropped");
 			return;
 		}
-	}
 
-	u32 wpos = m_wpos.load(std::memory_order_acquire);
+		// Keep what fits, the stretcher will slow down.
+		StretchOverrun();
+		num_frames = free - 1;
+		if (num_frames == 0)
+			return;
+	}
 
 	// wrapping around the end of the buffer?
 	if ((m_buffer_size - wpos) <= num_frames)
@@ -378,6 +415,7 @@ void AudioStream::InternalWriteFrames(const SampleType* data, u32 num_frames)
 		wpos += num_frames;
 	}
 
+	m_frames_written.fetch_add(num_frames, std::memory_order_relaxed);
 	m_wpos.store(wpos, std::memory_order_release);
 }
 
@@ -390,6 +428,7 @@ void AudioStream::BaseInitialize(SampleReader sample_reader, bool stretch_enable
 	AllocateBuffer();
 	ExpandAllocate();
 	StretchAllocate();
+	StartStretchThread();
 }
 
 void AudioStream::AllocateBuffer()
@@ -405,6 +444,12 @@ void AudioStream::AllocateBuffer()
 	if (IsExpansionEnabled())
 		m_expand_buffer = std::make_unique<float[]>(m_parameters.expand_block_size * NUM_INPUT_CHANNELS);
 
+	if (UsesStretchThread())
+	{
+		m_stretch_input = std::make_unique<float[]>(STRETCH_INPUT_BUFFER_SIZE * NUM_INPUT_CHANNELS);
+		m_stretch_output = std::make_unique<float[]>(STRETCH_OUTPUT_BUFFER_SIZE * m_internal_channels);
+	}
+
 	DEV_LOG(
 		"Allocated buffer of {} frames for buffer of {} ms [expansion {} (block size {}), stretch {}, target size {}].",
 		m_buffer_size, m_parameters.buffer_ms, GetExpansionModeName(m_parameters.expansion_mode),
@@ -413,16 +458,33 @@ void AudioStream::AllocateBuffer()
 
 void AudioStream::DestroyBuffer()
 {
+	m_stretch_output.reset();
+	m_stretch_input.reset();
+	m_stretch_output_pos = 0;
+	m_stretch_input_wpos.store(0, std::memory_order_release);
+	m_stretch_input_rpos.store(0, std::memory_order_release);
 	m_expand_buffer.reset();
 	m_staging_buffer.reset();
 	m_buffer.reset();
 	m_buffer_size = 0;
+	m_cached_rpos = 0;
 	m_wpos.store(0, std::memory_order_release);
 	m_rpos.store(0, std::memory_order_release);
 }
 
 void AudioStream::EmptyBuffer()
 {
+	// The stretch thread owns the expansion and stretching state, and the write side of the buffer. Waiting for it
+	// to go idle isn't enough, an underrun on the backend's thread can wake it again at any point, so stop it.
+	const bool restart_stretch_thread = m_stretch_thread.Joinable();
+	StopStretchThread();
+
+	if (UsesStretchThread())
+	{
+		m_stretch_input_rpos.store(m_stretch_input_wpos.load(std::memory_order_relaxed), std::memory_order_release);
+		m_stretch_output_pos = 0;
+	}
+
 	if (IsExpansionEnabled())
 	{
 		m_expander->Flush();
@@ -434,15 +496,19 @@ void AudioStream::EmptyBuffer()
 	{
 		m_soundtouch->clear();
 		if (IsStretchEnabled())
-			m_soundtouch->setTempo(m_nominal_rate);
+			m_soundtouch->setTempo(m_nominal_rate.load(std::memory_order_relaxed));
 	}
 
 	m_wpos.store(m_rpos.load(std::memory_order_acquire), std::memory_order_release);
+
+	if (restart_stretch_thread)
+		StartStretchThread();
 }
 
 void AudioStream::SetNominalRate(float tempo)
 {
-	m_nominal_rate = tempo;
+	// Read by the stretch thread at the next chunk.
+	m_nominal_rate.store(tempo, std::memory_order_relaxed);
 }
 
 void AudioStream::UpdateTargetTempo(float tempo)
@@ -450,7 +516,19 @@ void AudioStream::UpdateTargetTempo(float tempo)
 	if (!IsStretchEnabled())
 		return;
 
+	// The stretcher's state belongs to the stretch thread, it applies this before its next batch.
+	m_target_tempo.store(tempo, std::memory_order_relaxed);
+	m_target_tempo_pending.store(true, std::memory_order_release);
+	m_stretch_sema.NotifyOfWork();
+}
+
+void AudioStream::StretchApplyTargetTempo()
+{
+	if (!m_target_tempo_pending.exchange(false, std::memory_order_acquire))
+		return;
+
 	// undo sqrt()
+	float tempo = m_target_tempo.load(std::memory_order_relaxed);
 	if (tempo)
 		tempo *= tempo;
 
@@ -461,7 +539,7 @@ void AudioStream::UpdateTargetTempo(float tempo)
 	m_stretch_reset = 0;
 	m_stretch_inactive = false;
 	m_stretch_ok_count = 0;
-	m_dynamic_target_usage = static_cast<float>(m_target_buffer_size) * m_nominal_rate;
+	m_dynamic_target_usage = static_cast<float>(m_target_buffer_size) * m_nominal_rate.load(std::memory_order_relaxed);
 }
 
 void AudioStream::SetStretchEnabled(bool enabled)
@@ -474,12 +552,14 @@ void AudioStream::SetStretchEnabled(bool enabled)
 	if (!paused)
 		SetPaused(true);
 
+	StopStretchThread();
 	DestroyBuffer();
 	StretchDestroy();
 	m_stretch_enabled = enabled;
 
 	AllocateBuffer();
 	StretchAllocate();
+	StartStretchThread();
 
 	if (!paused)
 		SetPaused(false);
@@ -487,6 +567,9 @@ void AudioStream::SetStretchEnabled(bool enabled)
 
 void AudioStream::SetPaused(bool paused)
 {
+	if (paused)
+		FlushStretchInput();
+
 	m_paused = paused;
 }
 
@@ -557,32 +640,130 @@ void AudioStream::EndWrite(u32 num_frames)
 
 void AudioStream::WriteChunk(const SampleType* chunk)
 {
-	if (!IsExpansionEnabled() && !IsStretchEnabled())
+	if (!UsesStretchThread())
 	{
 		InternalWriteFrames(chunk, CHUNK_SIZE);
 		return;
 	}
 
-	if (IsExpansionEnabled())
+	static_assert(std::has_single_bit(STRETCH_INPUT_BUFFER_SIZE) && (STRETCH_BATCH_SIZE % CHUNK_SIZE) == 0);
+
+	const u32 wpos = m_stretch_input_wpos.load(std::memory_order_relaxed);
+	const u32 pending = wpos - m_stretch_input_rpos.load(std::memory_order_acquire);
+	if ((STRETCH_INPUT_BUFFER_SIZE - pending) < CHUNK_SIZE)
 	{
-		// StretchWriteBlock() overwrites the staging buffer on output, so we need to copy into the expand buffer first.
-		std::memcpy(m_expand_buffer.get() + m_expand_buffer_pos * NUM_INPUT_CHANNELS, chunk, CHUNK_SIZE * NUM_INPUT_CHANNELS * sizeof(SampleType));
+		m_overruns.fetch_add(1, std::memory_order_relaxed);
+		LOG_UNDERRUN("Stretch thread overrun, chunk dropped");
+		return;
+	}
 
-		// Output the corresponding block.
-		if (m_expand_output_buffer)
-			StretchWriteBlock(m_expand_output_buffer + m_expand_buffer_pos * m_internal_channels);
+	std::memcpy(&m_stretch_input[(wpos % STRETCH_INPUT_BUFFER_SIZE) * NUM_INPUT_CHANNELS], chunk,
+		CHUNK_SIZE * NUM_INPUT_CHANNELS * sizeof(SampleType));
+	m_stretch_input_wpos.store(wpos + CHUNK_SIZE, std::memory_order_release);
 
-		// Decode the next block if we buffered enough.
-		m_expand_buffer_pos += CHUNK_SIZE;
-		if (m_expand_buffer_pos == m_parameters.expand_block_size)
-		{
-			m_expand_buffer_pos = 0;
-			m_expand_output_buffer = m_expander->Decode(m_expand_buffer.get());
-		}
+	// Don't bother waking the stretch thread until it has a whole batch to work on.
+	if ((pending + CHUNK_SIZE) >= STRETCH_BATCH_SIZE)
+		m_stretch_sema.NotifyOfWork();
+}
+
+void AudioStream::ExpandWriteChunk(const SampleType* chunk)
+{
+	// The decoder works on whole blocks, so gather the chunks first.
+	std::memcpy(m_expand_buffer.get() + m_expand_buffer_pos * NUM_INPUT_CHANNELS, chunk, CHUNK_SIZE * NUM_INPUT_CHANNELS * sizeof(SampleType));
+
+	// Output the corresponding block.
+	if (m_expand_output_buffer)
+		StretchWriteBlock(m_expand_output_buffer + m_expand_buffer_pos * m_internal_channels);
+
+	// Decode the next block if we buffered enough.
+	m_expand_buffer_pos += CHUNK_SIZE;
+	if (m_expand_buffer_pos == m_parameters.expand_block_size)
+	{
+		m_expand_buffer_pos = 0;
+		m_expand_output_buffer = m_expander->Decode(m_expand_buffer.get());
 	}
-	else
+}
+
+void AudioStream::StartStretchThread()
+{
+	if (!UsesStretchThread())
+		return;
+
+	pxAssert(!m_stretch_thread.Joinable());
+	m_stretch_thread_shutdown.store(false, std::memory_order_relaxed);
+	m_stretch_thread.Start([this]() { StretchThreadEntryPoint(); });
+}
+
+void AudioStream::StopStretchThread()
+{
+	if (!m_stretch_thread.Joinable())
+		return;
+
+	m_stretch_thread_shutdown.store(true, std::memory_order_release);
+	m_stretch_sema.NotifyOfWork();
+	m_stretch_thread.Join();
+	m_stretch_sema.Reset();
+}
+
+void AudioStream::FlushStretchInput()
+{
+	// Called from the backend's thread, which mustn't look at the thread handle. If the thread is stopped, it
+	// picks this up when it's started again.
+	if (!UsesStretchThread())
+		return;
+
+	m_stretch_flush.store(true, std::memory_order_release);
+	m_stretch_sema.NotifyOfWork();
+}
+
+void AudioStream::StretchThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Audio Stretch");
+
+	for (;;)
+	{
+		m_stretch_sema.WaitForWork();
+		if (m_stretch_thread_shutdown.load(std::memory_order_acquire))
+			break;
+
+		StretchProcessInput();
+	}
+}
+
+void AudioStream::StretchProcessInput()
+{
+	// Underruns are counted by the backend, but they feed into the stretcher's state.
+	const u32 underruns = m_underruns.load(std::memory_order_relaxed);
+	m_stretch_reset += underruns - m_stretch_last_underruns;
+	m_stretch_last_underruns = underruns;
+
+	if (IsStretchEnabled())
+		StretchApplyTargetTempo();
+
+	// Input short of a whole batch only gets processed when it's not going to be followed by more any time soon.
+	const bool flush = m_stretch_flush.exchange(false, std::memory_order_acquire);
+
+	u32 rpos = m_stretch_input_rpos.load(std::memory_order_relaxed);
+	for (;;)
 	{
-		StretchWriteBlock(chunk);
+		const u32 batch_size = std::min(m_stretch_input_wpos.load(std::memory_order_acquire) - rpos, STRETCH_BATCH_SIZE);
+		if (batch_size == 0 || (batch_size < STRETCH_BATCH_SIZE && !flush))
+			break;
+
+		for (u32 i = 0; i < batch_size; i += CHUNK_SIZE)
+		{
+			const SampleType* chunk = &m_stretch_input[((rpos + i) % STRETCH_INPUT_BUFFER_SIZE) * NUM_INPUT_CHANNELS];
+			if (IsExpansionEnabled())
+				ExpandWriteChunk(chunk);
+			else
+				StretchWriteBlock(chunk);
+		}
+
+		// The whole batch goes into the output buffer at once.
+		StretchFlushOutput();
+
+		rpos += batch_size;
+		m_stretch_input_rpos.store(rpos, std::memory_order_release);
 	}
 }
 
@@ -608,7 +789,7 @@ void AudioStream::StretchAllocate()
 	m_soundtouch->setSetting(SETTING_SEEKWINDOW_MS, m_parameters.stretch_seekwindow_ms);
 	m_soundtouch->setSetting(SETTING_OVERLAP_MS, m_parameters.stretch_overlap_ms);
 
-	m_soundtouch->setTempo(m_nominal_rate);
+	m_soundtouch->setTempo(m_nominal_rate.load(std::memory_order_relaxed));
 
 	m_stretch_reset = STRETCH_RESET_THRESHOLD;
 	m_stretch_inactive = false;
@@ -616,6 +797,7 @@ void AudioStream::StretchAllocate()
 	m_dynamic_target_usage = 0.0f;
 	m_average_position = 0;
 	m_average_available = 0;
+	m_stretch_last_underruns = m_underruns.load(std::memory_order_relaxed);
 
 	m_staging_buffer_pos = 0;
 }
@@ -632,20 +814,37 @@ void AudioStream::StretchWriteBlock(const float* block)
 		m_soundtouch->putSamples(block, CHUNK_SIZE);
 
 		u32 tempProgress;
-		while (tempProgress = m_soundtouch->receiveSamples(m_staging_buffer.get(), CHUNK_SIZE), tempProgress != 0)
+		while (tempProgress = m_soundtouch->receiveSamples(&m_stretch_output[m_stretch_output_pos * m_internal_channels],
+				   STRETCH_OUTPUT_BUFFER_SIZE - m_stretch_output_pos),
+			   tempProgress != 0)
 		{
-			InternalWriteFrames(m_staging_buffer.get(), tempProgress);
+			m_stretch_output_pos += tempProgress;
+			if (m_stretch_output_pos == STRETCH_OUTPUT_BUFFER_SIZE)
+				StretchFlushOutput();
 		}
 
-		if (IsStretchEnabled())
-			UpdateStretchTempo();
+		// Still adjusted for every chunk, the averaging window and thresholds are in chunks.
+		UpdateStretchTempo();
 	}
 	else
 	{
-		InternalWriteFrames(block, CHUNK_SIZE);
+		std::memcpy(&m_stretch_output[m_stretch_output_pos * m_internal_channels], block,
+			CHUNK_SIZE * m_internal_channels * sizeof(SampleType));
+		m_stretch_output_pos += CHUNK_SIZE;
+		if (m_stretch_output_pos == STRETCH_OUTPUT_BUFFER_SIZE)
+			StretchFlushOutput();
 	}
 }
 
+void AudioStream::StretchFlushOutput()
+{
+	if (m_stretch_output_pos == 0)
+		return;
+
+	InternalWriteFrames(m_stretch_output.get(), m_stretch_output_pos);
+	m_stretch_output_pos = 0;
+}
+
 float AudioStream::AddAndGetAverageTempo(float val)
 {
 	if (m_stretch_reset >= STRETCH_RESET_THRESHOLD)
@@ -678,7 +877,8 @@ void AudioStream::UpdateStretchTempo()
 	static constexpr u32 INACTIVE_MIN_OK_COUNT = 50;
 	static constexpr u32 COMPENSATION_DIVIDER = 100;
 
-	float base_target_usage = static_cast<float>(m_target_buffer_size) * m_nominal_rate;
+	const float nominal_rate = m_nominal_rate.load(std::memory_order_relaxed);
+	float base_target_usage = static_cast<float>(m_target_buffer_size) * nominal_rate;
 
 	// state vars
 	if (m_stretch_reset >= STRETCH_RESET_THRESHOLD)
@@ -689,7 +889,8 @@ void AudioStream::UpdateStretchTempo()
 		m_dynamic_target_usage = base_target_usage;
 	}
 
-	const u32 ibuffer_usage = GetBufferedFramesRelaxed();
+	// Frames stretched in this batch count too, they're just not in the buffer yet.
+	const u32 ibuffer_usage = GetBufferedFramesRelaxed() + m_stretch_output_pos;
 	float buffer_usage = static_cast<float>(ibuffer_usage);
 	float tempo = buffer_usage / m_dynamic_target_usage;
 	tempo = AddAndGetAverageTempo(tempo);
@@ -732,7 +933,7 @@ void AudioStream::UpdateStretchTempo()
 	}
 
 	if (m_stretch_inactive)
-		tempo = m_nominal_rate;
+		tempo = nominal_rate;
 
 	if constexpr (LOG_TIMESTRETCH_STATS)
 	{
@@ -760,20 +961,11 @@ void AudioStream::UpdateStretchTempo()
 		m_stretch_reset = 0;
 }
 
-void AudioStream::StretchUnderrun()
-{
-	// Didn't produce enough frames in time.
-	m_stretch_reset++;
-}
-
 void AudioStream::StretchOverrun()
 {
-	// Produced more frames than can fit in the buffer.
+	// Produced more frames than can fit in the buffer. The read position belongs to the backend, so the caller
+	// drops the newest frames instead of the oldest.
 	m_stretch_reset++;
-
-	// Drop two packets to give the time stretcher a bit more time to slow things down.
-	const u32 discard = CHUNK_SIZE * 2;
-	m_rpos.store((m_rpos.load(std::memory_order_acquire) + discard) % m_buffer_size, std::memory_order_release);
 }
 
 void AudioStreamParameters::LoadSave(SettingsWrapper& wrap, const char* section)
@@ -5,6 +5,8 @@
 
 #include "Host/AudioStreamTypes.h"
 
+#include "common/Threading.h"
+
 #include <array>
 #include <atomic>
 #include <memory>
@@ -42,6 +44,16 @@ public:
 		~DeviceInfo();
 	};
 
+	struct Statistics
+	{
+		u64 frames_written; ///< Frames committed to the output buffer.
+		u64 frames_read; ///< Frames handed to the backend, not counting silence.
+		u32 underruns; ///< Reads which ran out of buffered frames.
+		u32 overruns; ///< Writes which were dropped or cut short because the buffer was full.
+		u32 average_latency_frames; ///< Frames buffered when the backend reads, on average.
+		u32 max_latency_frames;
+	};
+
 public:
 	virtual ~AudioStream();
 
@@ -63,13 +75,14 @@ public:
 	__fi u32 GetBufferSize() const { return m_buffer_size; }
 	__fi u32 GetTargetBufferSize() const { return m_target_buffer_size; }
 	__fi u32 GetOutputVolume() const { return m_volume; }
-	__fi float GetNominalTempo() const { return m_nominal_rate; }
+	__fi float GetNominalTempo() const { return m_nominal_rate.load(std::memory_order_relaxed); }
 	__fi AudioExpansionMode GetExpansionMode() const { return m_parameters.expansion_mode; }
 	__fi bool IsExpansionEnabled() const { return m_parameters.expansion_mode != AudioExpansionMode::Disabled; }
 	__fi bool IsStretchEnabled() const { return m_stretch_enabled; }
 	__fi bool IsPaused() const { return m_paused; }
 
 	u32 GetBufferedFramesRelaxed() const;
+	Statistics GetStatistics() const;
 
 	/// Temporarily pauses the stream, preventing it from requesting data.
 	virtual void SetPaused(bool paused);
@@ -96,6 +109,11 @@ public:
 		const char* driver_name, const char* device_name, bool stretch_enabled, Error* error = nullptr);
 	static std::unique_ptr<AudioStream> CreateNullStream(u32 sample_rate, u32 buffer_ms);
 
+	/// Reads at the rate a device would and discards the output, for benchmarks and tests which need the whole
+	/// pipeline to run without a device. Not used for the Null backend, which doesn't process anything.
+	static std::unique_ptr<AudioStream> CreatePacingNullStream(u32 sample_rate, const AudioStreamParameters& parameters,
+		bool stretch_enabled);
+
 protected:
 	enum ReadChannel : u8
 	{
@@ -117,6 +135,9 @@ protected:
 
 	void ReadFrames(SampleType* samples, u32 num_frames);
 
+	/// Has the stretch thread process input short of a whole batch, for when the producer stops feeding it.
+	void FlushStretchInput();
+
 	template <AudioExpansionMode mode, ReadChannel c0 = READ_CHANNEL_NONE, ReadChannel c1 = READ_CHANNEL_NONE,
 		ReadChannel c2 = READ_CHANNEL_NONE, ReadChannel c3 = READ_CHANNEL_NONE, ReadChannel c4 = READ_CHANNEL_NONE,
 		ReadChannel c5 = READ_CHANNEL_NONE, ReadChannel c6 = READ_CHANNEL_NONE, ReadChannel c7 = READ_CHANNEL_NONE>
@@ -147,19 +168,33 @@ private:
 	static std::unique_ptr<AudioStream> CreateSDLAudioStream(u32 sample_rate, const AudioStreamParameters& parameters,
 		bool stretch_enabled, Error* error);
 
+	// Input frames handed to the stretch thread at once, and the size of its input buffer.
+	static constexpr u32 STRETCH_BATCH_SIZE = 512;
+	static constexpr u32 STRETCH_INPUT_BUFFER_SIZE = STRETCH_BATCH_SIZE * 8;
+	static constexpr u32 STRETCH_OUTPUT_BUFFER_SIZE = STRETCH_BATCH_SIZE * 2;
+
+	__fi bool UsesStretchThread() const { return (IsStretchEnabled() || IsExpansionEnabled()); }
+
 	void AllocateBuffer();
 	void DestroyBuffer();
 
 	void InternalWriteFrames(const SampleType* samples, u32 num_frames);
 
 	void ExpandAllocate();
+	void ExpandWriteChunk(const SampleType* chunk);
 
 	void StretchAllocate();
 	void StretchDestroy();
 	void StretchWriteBlock(const float* block);
-	void StretchUnderrun();
+	void StretchFlushOutput();
 	void StretchOverrun();
 
+	void StartStretchThread();
+	void StopStretchThread();
+	void StretchThreadEntryPoint();
+	void StretchProcessInput();
+	void StretchApplyTargetTempo();
+
 	float AddAndGetAverageTempo(float val);
 	void UpdateStretchTempo();
 
@@ -167,8 +202,38 @@ private:
 	std::unique_ptr<float[]> m_buffer;
 	SampleReader m_sample_reader = nullptr;
 
-	std::atomic<u32> m_rpos{0};
-	std::atomic<u32> m_wpos{0};
+	// The output buffer is a single producer, single consumer ring. The producer is the thread calling EndWrite(),
+	// or the stretch thread when it is running, and the consumer is the backend. Each side's position and counters
+	// live on their own cache line, so they don't bounce between cores.
+	alignas(__cachelinesize) std::atomic<u32> m_wpos{0};
+	u32 m_cached_rpos = 0;
+	std::atomic<u64> m_frames_written{0};
+	std::atomic<u32> m_overruns{0};
+
+	alignas(__cachelinesize) std::atomic<u32> m_rpos{0};
+	std::atomic<u64> m_frames_read{0};
+	std::atomic<u32> m_underruns{0};
+	std::atomic<u32> m_max_latency{0};
+	std::atomic<u64> m_latency_sum{0};
+	std::atomic<u64> m_latency_samples{0};
+
+	// Stretching and expansion run on their own thread, fed through another ring of input chunks. The positions
+	// count frames without wrapping, the buffer size being a power of two.
+	alignas(__cachelinesize) std::atomic<u32> m_stretch_input_wpos{0};
+	alignas(__cachelinesize) std::atomic<u32> m_stretch_input_rpos{0};
+	std::unique_ptr<SampleType[]> m_stretch_input;
+	std::unique_ptr<SampleType[]> m_stretch_output;
+	u32 m_stretch_output_pos = 0;
+	u32 m_stretch_last_underruns = 0;
+	Threading::Thread m_stretch_thread;
+	Threading::WorkSema m_stretch_sema;
+	std::atomic_bool m_stretch_thread_shutdown{false};
+	std::atomic_bool m_stretch_flush{false};
+
+	// Tempo changes are picked up by the stretch thread, rather than waiting for it to go idle.
+	std::atomic_bool m_target_tempo_pending{false};
+	std::atomic<float> m_target_tempo{1.0f};
+	std::atomic<float> m_nominal_rate{1.0f};
 
 	std::unique_ptr<soundtouch::SoundTouch> m_soundtouch;
 
@@ -176,7 +241,6 @@ private:
 	u32 m_stretch_reset = STRETCH_RESET_THRESHOLD;
 
 	u32 m_stretch_ok_count = 0;
-	float m_nominal_rate = 1.0f;
 	float m_dynamic_target_usage = 0.0f;
 
 	u32 m_average_position = 0;
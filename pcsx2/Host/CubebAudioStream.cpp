@@ -287,6 +287,9 @@ void CubebAudioStream::SetPaused(bool paused)
 	if (paused == m_paused || !stream)
 		return;
 
+	if (paused)
+		FlushStretchInput();
+
 	const int rv = paused ? cubeb_stream_stop(stream) : cubeb_stream_start(stream);
 	if (rv != CUBEB_OK)
 	{
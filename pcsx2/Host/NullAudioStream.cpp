@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Host/AudioStream.h"
+
+#include "common/Assertions.h"
+#include "common/Console.h"
+#include "common/HostSys.h"
+#include "common/Threading.h"
+
+#include <algorithm>
+
+namespace
+{
+	// Pulls frames at the rate a real device would, and throws them away. Unlike the sink returned by
+	// CreateNullStream(), the whole pipeline runs, so benchmarks and tests see the same stretching cost and counters.
+	class NullAudioStream final : public AudioStream
+	{
+	public:
+		NullAudioStream(u32 sample_rate, const AudioStreamParameters& parameters);
+		~NullAudioStream();
+
+		void SetPaused(bool paused) override;
+
+		void OpenDevice(bool stretch_enabled);
+
+	private:
+		void StartThread();
+		void StopThread();
+		void ThreadEntryPoint();
+
+		Threading::Thread m_thread;
+		std::atomic_bool m_thread_shutdown{false};
+		std::unique_ptr<SampleType[]> m_output_buffer;
+		u32 m_period_frames = 0;
+	};
+} // namespace
+
+NullAudioStream::NullAudioStream(u32 sample_rate, const AudioStreamParameters& parameters)
+	: AudioStream(sample_rate, parameters)
+{
+}
+
+NullAudioStream::~NullAudioStream()
+{
+	StopThread();
+}
+
+std::unique_ptr<AudioStream> AudioStream::CreatePacingNullStream(u32 sample_rate, const AudioStreamParameters& parameters,
+	bool stretch_enabled)
+{
+	std::unique_ptr<NullAudioStream> stream = std::make_unique<NullAudioStream>(sample_rate, parameters);
+	stream->OpenDevice(stretch_enabled);
+	return stream;
+}
+
+void NullAudioStream::OpenDevice(bool stretch_enabled)
+{
+	static constexpr const std::array<SampleReader, static_cast<size_t>(AudioExpansionMode::Count)> sample_readers = {{
+		// Disabled
+		&StereoSampleReaderImpl,
+		// StereoLFE
+		&SampleReaderImpl<AudioExpansionMode::StereoLFE, READ_CHANNEL_FRONT_LEFT, READ_CHANNEL_FRONT_RIGHT,
+			READ_CHANNEL_LFE>,
+		// Quadraphonic
+		&SampleReaderImpl<AudioExpansionMode::Quadraphonic, READ_CHANNEL_FRONT_LEFT, READ_CHANNEL_FRONT_RIGHT,
+			READ_CHANNEL_REAR_LEFT, READ_CHANNEL_REAR_RIGHT>,
+		// QuadraphonicLFE
+		&SampleReaderImpl<AudioExpansionMode::QuadraphonicLFE, READ_CHANNEL_FRONT_LEFT, READ_CHANNEL_FRONT_RIGHT,
+			READ_CHANNEL_LFE, READ_CHANNEL_REAR_LEFT, READ_CHANNEL_REAR_RIGHT>,
+		// Surround51
+		&SampleReaderImpl<AudioExpansionMode::Surround51, READ_CHANNEL_FRONT_LEFT, READ_CHANNEL_FRONT_RIGHT,
+			READ_CHANNEL_FRONT_CENTER, READ_CHANNEL_LFE, READ_CHANNEL_REAR_LEFT, READ_CHANNEL_REAR_RIGHT>,
+		// Surround71
+		&SampleReaderImpl<AudioExpansionMode::Surround71, READ_CHANNEL_FRONT_LEFT, READ_CHANNEL_FRONT_RIGHT,
+			READ_CHANNEL_FRONT_CENTER, READ_CHANNEL_LFE, READ_CHANNEL_SIDE_LEFT, READ_CHANNEL_SIDE_RIGHT,
+			READ_CHANNEL_REAR_LEFT, READ_CHANNEL_REAR_RIGHT>,
+	}};
+
+	m_period_frames = GetBufferSizeForMS(
+		m_sample_rate, (m_parameters.minimal_output_latency) ? m_parameters.buffer_ms : m_parameters.output_latency_ms);
+	m_period_frames = std::max(m_period_frames, CHUNK_SIZE);
+	m_output_buffer = std::make_unique<SampleType[]>(m_period_frames * m_output_channels);
+	DEV_LOG("Null audio output reading {} frames at a time", m_period_frames);
+
+	BaseInitialize(sample_readers[static_cast<size_t>(m_parameters.expansion_mode)], stretch_enabled);
+	StartThread();
+}
+
+void NullAudioStream::SetPaused(bool paused)
+{
+	if (m_paused == paused)
+		return;
+
+	if (paused)
+	{
+		FlushStretchInput();
+		StopThread();
+	}
+	else
+		StartThread();
+
+	m_paused = paused;
+}
+
+void NullAudioStream::StartThread()
+{
+	pxAssert(!m_thread.Joinable());
+	m_thread_shutdown.store(false, std::memory_order_relaxed);
+	m_thread.Start([this]() { ThreadEntryPoint(); });
+}
+
+void NullAudioStream::StopThread()
+{
+	if (!m_thread.Joinable())
+		return;
+
+	m_thread_shutdown.store(true, std::memory_order_release);
+	m_thread.Join();
+}
+
+void NullAudioStream::ThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Null Audio Output");
+
+	const u64 period_ticks = (static_cast<u64>(m_period_frames) * GetTickFrequency()) / m_sample_rate;
+	u64 next_read = GetCPUTicks();
+
+	while (!m_thread_shutdown.load(std::memory_order_acquire))
+	{
+		ReadFrames(m_output_buffer.get(), m_period_frames);
+
+		// If we fell behind by more than a period, don't try to catch up, a real device wouldn't either.
+		next_read += period_ticks;
+		const u64 now = GetCPUTicks();
+		if (now > (next_read + period_ticks))
+			next_read = now;
+
+		Threading::SleepUntil(next_read);
+	}
+}
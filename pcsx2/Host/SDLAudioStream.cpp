@@ -130,7 +130,10 @@ void SDLAudioStream::SetPaused(bool paused)
 		return;
 
 	if (paused)
+	{
+		FlushStretchInput();
 		SDL_PauseAudioDevice(SDL_GetAudioStreamDevice(m_stream));
+	}
 	else
 		SDL_ResumeAudioDevice(SDL_GetAudioStreamDevice(m_stream));
 
@@ -10,6 +10,8 @@
 #include <limits.h>
 #include "Config.h"
 
+#include "common/Timer.h"
+
 // the BP doesn't advance and returns -1 if there is no data to be read
 alignas(16) tIPU_cmd ipu_cmd;
 alignas(16) tIPU_BP g_BP;
@@ -18,6 +20,8 @@ IPUStatus IPUCoreStatus;
 
 static void (*IPUWorker)();
 
+static IPUCommandStats s_command_stats[16] = {};
+
 // Color conversion stuff, the memory layout is a total hack
 // convert_data_buffer is a pointer to the internal rgb struct (the first param in convert_init_t)
 //char convert_data_buffer[sizeof(convert_rgb_t)];
@@ -78,10 +82,50 @@ void tIPU_cmd::clear()
 	current = 0xffffffff;
 }
 
+// Runs the worker for the current command, accounting the time spent to the command type.
+static void RunIPUWorker()
+{
+	IPUCommandStats& stats = s_command_stats[ipu_cmd.CMD];
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+
+	IPUWorker();
+
+	stats.time_ns += static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue() - start));
+	stats.runs++;
+	if (!ipuRegs.ctrl.BUSY)
+		stats.commands++;
+}
+
+static void LogCommandStats()
+{
+	static constexpr const char* names[] = {"BCLR", "IDEC", "BDEC", "VDEC", "FDEC", "SETIQ", "SETVQ", "CSC", "PACK", "SETTH"};
+
+	for (u32 i = 0; i < std::size(names); i++)
+	{
+		const IPUCommandStats& stats = s_command_stats[i];
+		if (stats.runs == 0)
+			continue;
+
+		DevCon.WriteLn("IPU: %-5s %llu commands in %llu runs, %.2f ms (%.2f us per command)", names[i], stats.commands,
+			stats.runs, static_cast<double>(stats.time_ns) / 1000000.0,
+			stats.commands ? (static_cast<double>(stats.time_ns) / static_cast<double>(stats.commands) / 1000.0) : 0.0);
+	}
+}
+
+const IPUCommandStats& ipuGetCommandStats(u32 cmd)
+{
+	return s_command_stats[cmd & 15];
+}
+
+void ipuResetCommandStats()
+{
+	std::memset(s_command_stats, 0, sizeof(s_command_stats));
+}
+
 __fi void IPUProcessInterrupt()
 {
 	if (ipuRegs.ctrl.BUSY)
-		IPUWorker();
+		RunIPUWorker();
 }
 
 /////////////////////////////////////////////////////////
@@ -89,6 +133,9 @@ __fi void IPUProcessInterrupt()
 
 void ipuReset()
 {
+	LogCommandStats();
+	ipuResetCommandStats();
+
 	IPUWorker = MULTI_ISA_SELECT(IPUWorker);
 	std::memset(&ipuRegs, 0, sizeof(ipuRegs));
 	std::memset(&g_BP, 0, sizeof(g_BP));
@@ -536,5 +583,5 @@ __fi void IPUCMD_WRITE(u32 val)
 		IPU_INT_PROCESS(64);
 	}
 	else
-		IPUWorker();
+		RunIPUWorker();
 }
@@ -286,7 +286,17 @@ extern bool EnableFMV;
 alignas(16) extern tIPU_cmd ipu_cmd;
 extern u64 eecount_on_last_vdec;
 
+// Host time spent running each type of IPU command on the EE thread.
+struct IPUCommandStats
+{
+	u64 commands; // Commands completed
+	u64 runs; // Calls into the worker, including the ones which stopped on an empty/full FIFO
+	u64 time_ns;
+};
+
 extern void ipuReset();
+extern const IPUCommandStats& ipuGetCommandStats(u32 cmd);
+extern void ipuResetCommandStats();
 
 extern u32 ipuRead32(u32 mem);
 extern u64 ipuRead64(u32 mem);
@@ -0,0 +1,389 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-2.0+
+
+// The reference IDCT is based on the mpeg2dec library,
+//
+// Copyright (C) 2000-2002 Michel Lespinasse <walken@zoy.org>
+// Copyright (C) 1999-2000 Aaron Holtzman <aholtzma@ess.engr.uvic.ca>
+//
+// under the GPL license.
+
+#pragma once
+
+#include "GS/GSVector.h"
+#include "IPU/mpeg2_vlc.h"
+
+#include <bit>
+
+// IDCT and DCT coefficient VLC kernels, shared by the decoder and the tests. Everything here
+// has internal linkage, since the decoder is compiled once per ISA.
+
+// --------------------------------------------------------------------------------------
+//  IDCT
+// --------------------------------------------------------------------------------------
+
+static constexpr int IDCT_W1 = 2841; // 2048*sqrt (2)*cos (1*pi/16)
+static constexpr int IDCT_W2 = 2676; // 2048*sqrt (2)*cos (2*pi/16)
+static constexpr int IDCT_W3 = 2408; // 2048*sqrt (2)*cos (3*pi/16)
+static constexpr int IDCT_W5 = 1609; // 2048*sqrt (2)*cos (5*pi/16)
+static constexpr int IDCT_W6 = 1108; // 2048*sqrt (2)*cos (6*pi/16)
+static constexpr int IDCT_W7 = 565; // 2048*sqrt (2)*cos (7*pi/16)
+
+/*
+ * In legal streams, the IDCT output should be between -384 and +384.
+ * In corrupted streams, it is possible to force the IDCT output to go
+ * to +-3826 - this is the worst case for a column IDCT where the
+ * column inputs are 16-bit values.
+ */
+
+static __forceinline void IDCT_Butterfly(int& t0, int& t1, int w0, int w1, int d0, int d1)
+{
+	int tmp = w0 * (d0 + d1);
+	t0 = tmp + (w1 - w0) * d1;
+	t1 = tmp - (w1 + w0) * d0;
+}
+
+static __forceinline void IDCT_Block_reference(s16* block)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		s16* const rblock = block + 8 * i;
+		if (!(rblock[1] | ((s32*)rblock)[1] | ((s32*)rblock)[2] |
+				((s32*)rblock)[3]))
+		{
+			u32 tmp = (u16)(rblock[0] << 3);
+			tmp |= tmp << 16;
+			((s32*)rblock)[0] = tmp;
+			((s32*)rblock)[1] = tmp;
+			((s32*)rblock)[2] = tmp;
+			((s32*)rblock)[3] = tmp;
+			continue;
+		}
+
+		int a0, a1, a2, a3;
+		{
+			const int d0 = (rblock[0] << 11) + 128;
+			const int d1 = rblock[1];
+			const int d2 = rblock[2] << 11;
+			const int d3 = rblock[3];
+			int t0 = d0 + d2;
+			int t1 = d0 - d2;
+			int t2, t3;
+			IDCT_Butterfly(t2, t3, IDCT_W6, IDCT_W2, d3, d1);
+			a0 = t0 + t2;
+			a1 = t1 + t3;
+			a2 = t1 - t3;
+			a3 = t0 - t2;
+		}
+
+		int b0, b1, b2, b3;
+		{
+			const int d0 = rblock[4];
+			const int d1 = rblock[5];
+			const int d2 = rblock[6];
+			const int d3 = rblock[7];
+			int t0, t1, t2, t3;
+			IDCT_Butterfly(t0, t1, IDCT_W7, IDCT_W1, d3, d0);
+			IDCT_Butterfly(t2, t3, IDCT_W3, IDCT_W5, d1, d2);
+			b0 = t0 + t2;
+			b3 = t1 + t3;
+			t0 -= t2;
+			t1 -= t3;
+			b1 = ((t0 + t1) * 181) >> 8;
+			b2 = ((t0 - t1) * 181) >> 8;
+		}
+
+		rblock[0] = (a0 + b0) >> 8;
+		rblock[1] = (a1 + b1) >> 8;
+		rblock[2] = (a2 + b2) >> 8;
+		rblock[3] = (a3 + b3) >> 8;
+		rblock[4] = (a3 - b3) >> 8;
+		rblock[5] = (a2 - b2) >> 8;
+		rblock[6] = (a1 - b1) >> 8;
+		rblock[7] = (a0 - b0) >> 8;
+	}
+
+	for (int i = 0; i < 8; i++)
+	{
+		s16* const cblock = block + i;
+
+		int a0, a1, a2, a3;
+		{
+			const int d0 = (cblock[8 * 0] << 11) + 65536;
+			const int d1 = cblock[8 * 1];
+			const int d2 = cblock[8 * 2] << 11;
+			const int d3 = cblock[8 * 3];
+			const int t0 = d0 + d2;
+			const int t1 = d0 - d2;
+			int t2;
+			int t3;
+			IDCT_Butterfly(t2, t3, IDCT_W6, IDCT_W2, d3, d1);
+			a0 = t0 + t2;
+			a1 = t1 + t3;
+			a2 = t1 - t3;
+			a3 = t0 - t2;
+		}
+
+		int b0, b1, b2, b3;
+		{
+			const int d0 = cblock[8 * 4];
+			const int d1 = cblock[8 * 5];
+			const int d2 = cblock[8 * 6];
+			const int d3 = cblock[8 * 7];
+			int t0, t1, t2, t3;
+			IDCT_Butterfly(t0, t1, IDCT_W7, IDCT_W1, d3, d0);
+			IDCT_Butterfly(t2, t3, IDCT_W3, IDCT_W5, d1, d2);
+			b0 = t0 + t2;
+			b3 = t1 + t3;
+			t0 = (t0 - t2) >> 8;
+			t1 = (t1 - t3) >> 8;
+			b1 = (t0 + t1) * 181;
+			b2 = (t0 - t1) * 181;
+		}
+
+		cblock[8 * 0] = (a0 + b0) >> 17;
+		cblock[8 * 1] = (a1 + b1) >> 17;
+		cblock[8 * 2] = (a2 + b2) >> 17;
+		cblock[8 * 3] = (a3 + b3) >> 17;
+		cblock[8 * 4] = (a3 - b3) >> 17;
+		cblock[8 * 5] = (a2 - b2) >> 17;
+		cblock[8 * 6] = (a1 - b1) >> 17;
+		cblock[8 * 7] = (a0 - b0) >> 17;
+	}
+}
+
+// Packs a pair of 16-bit weights for madd(), w0 multiplies the first element of each pair.
+static constexpr int IDCT_Weights(int w0, int w1)
+{
+	return static_cast<int>((static_cast<u32>(w1) << 16) | (static_cast<u32>(w0) & 0xFFFF));
+}
+
+// One pass of the IDCT above, on 32-bit lanes. The 16-bit inputs come interleaved in pairs,
+// (x0, x2), (x1, x3), (x4, x7) and (x5, x6), so every butterfly is a pair of madds. Since the
+// inputs always fit in 16 bits, the products are the same as the scalar int math, and the
+// remaining wrapping 32-bit adds and multiplies match it too.
+template <bool Row, class V>
+static __forceinline void IDCT_Pass(const V (&x)[4], V (&out)[8])
+{
+	constexpr int bias = Row ? 128 : 65536;
+
+	V a0, a1, a2, a3;
+	{
+		const V t0 = x[0].madd(V(IDCT_Weights(2048, 2048))).add32(V(bias));
+		const V t1 = x[0].madd(V(IDCT_Weights(2048, -2048))).add32(V(bias));
+		const V t2 = x[1].madd(V(IDCT_Weights(IDCT_W2, IDCT_W6)));
+		const V t3 = x[1].madd(V(IDCT_Weights(IDCT_W6, -IDCT_W2)));
+		a0 = t0.add32(t2);
+		a1 = t1.add32(t3);
+		a2 = t1.sub32(t3);
+		a3 = t0.sub32(t2);
+	}
+
+	V b0, b1, b2, b3;
+	{
+		V t0 = x[2].madd(V(IDCT_Weights(IDCT_W1, IDCT_W7)));
+		V t1 = x[2].madd(V(IDCT_Weights(IDCT_W7, -IDCT_W1)));
+		const V t2 = x[3].madd(V(IDCT_Weights(IDCT_W3, IDCT_W5)));
+		const V t3 = x[3].madd(V(IDCT_Weights(-IDCT_W5, IDCT_W3)));
+		b0 = t0.add32(t2);
+		b3 = t1.add32(t3);
+		t0 = t0.sub32(t2);
+		t1 = t1.sub32(t3);
+		if constexpr (Row)
+		{
+			b1 = t0.add32(t1).mul32l(V(181)).template sra32<8>();
+			b2 = t0.sub32(t1).mul32l(V(181)).template sra32<8>();
+		}
+		else
+		{
+			t0 = t0.template sra32<8>();
+			t1 = t1.template sra32<8>();
+			b1 = t0.add32(t1).mul32l(V(181));
+			b2 = t0.sub32(t1).mul32l(V(181));
+		}
+	}
+
+	// Row results are truncated to 16 bits, the same as the scalar stores. Column results
+	// always fit after the shift by 17.
+	const auto result = [](const V& v) {
+		if constexpr (Row)
+			return v.template sll32<8>().template sra32<16>();
+		else
+			return v.template sra32<17>();
+	};
+	out[0] = result(a0.add32(b0));
+	out[1] = result(a1.add32(b1));
+	out[2] = result(a2.add32(b2));
+	out[3] = result(a3.add32(b3));
+	out[4] = result(a3.sub32(b3));
+	out[5] = result(a2.sub32(b2));
+	out[6] = result(a1.sub32(b1));
+	out[7] = result(a0.sub32(b0));
+}
+
+static __forceinline void IDCT_Transpose(GSVector4i (&r)[8])
+{
+	const GSVector4i t0 = r[0].upl16(r[1]);
+	const GSVector4i t1 = r[0].uph16(r[1]);
+	const GSVector4i t2 = r[2].upl16(r[3]);
+	const GSVector4i t3 = r[2].uph16(r[3]);
+	const GSVector4i t4 = r[4].upl16(r[5]);
+	const GSVector4i t5 = r[4].uph16(r[5]);
+	const GSVector4i t6 = r[6].upl16(r[7]);
+	const GSVector4i t7 = r[6].uph16(r[7]);
+
+	const GSVector4i u0 = t0.upl32(t2);
+	const GSVector4i u1 = t0.uph32(t2);
+	const GSVector4i u2 = t1.upl32(t3);
+	const GSVector4i u3 = t1.uph32(t3);
+	const GSVector4i u4 = t4.upl32(t6);
+	const GSVector4i u5 = t4.uph32(t6);
+	const GSVector4i u6 = t5.upl32(t7);
+	const GSVector4i u7 = t5.uph32(t7);
+
+	r[0] = u0.upl64(u4);
+	r[1] = u0.uph64(u4);
+	r[2] = u1.upl64(u5);
+	r[3] = u1.uph64(u5);
+	r[4] = u2.upl64(u6);
+	r[5] = u2.uph64(u6);
+	r[6] = u3.upl64(u7);
+	r[7] = u3.uph64(u7);
+}
+
+// Runs a pass over r[k], which holds element k of each of the 8 rows (or columns).
+template <bool Row>
+static __forceinline void IDCT_Pass16(GSVector4i (&r)[8])
+{
+#if _M_SSE >= 0x501
+	const GSVector8i x[4] = {
+		GSVector8i(r[0].upl16(r[2]), r[0].uph16(r[2])),
+		GSVector8i(r[1].upl16(r[3]), r[1].uph16(r[3])),
+		GSVector8i(r[4].upl16(r[7]), r[4].uph16(r[7])),
+		GSVector8i(r[5].upl16(r[6]), r[5].uph16(r[6])),
+	};
+
+	GSVector8i out[8];
+	IDCT_Pass<Row>(x, out);
+
+	for (int i = 0; i < 8; i++)
+		r[i] = out[i].extract<0>().ps32(out[i].extract<1>());
+#else
+	const GSVector4i lo[4] = {r[0].upl16(r[2]), r[1].upl16(r[3]), r[4].upl16(r[7]), r[5].upl16(r[6])};
+	const GSVector4i hi[4] = {r[0].uph16(r[2]), r[1].uph16(r[3]), r[4].uph16(r[7]), r[5].uph16(r[6])};
+
+	GSVector4i out_lo[8], out_hi[8];
+	IDCT_Pass<Row>(lo, out_lo);
+	IDCT_Pass<Row>(hi, out_hi);
+
+	for (int i = 0; i < 8; i++)
+		r[i] = out_lo[i].ps32(out_hi[i]);
+#endif
+}
+
+// Bit-exact with IDCT_Block_reference. The row pass runs on the transposed block, so both
+// passes work on all 8 rows/columns at once. The reference's shortcut for rows with only
+// a DC coefficient is not needed, as the full row pass gives the same result for them.
+static __forceinline void IDCT_Block_vector(s16* block)
+{
+	GSVector4i r[8];
+	for (int i = 0; i < 8; i++)
+		r[i] = GSVector4i::load<true>(block + 8 * i);
+
+	// Blocks with only a DC coefficient are common, and come out flat.
+	if ((r[0].srl<2>() | r[1] | r[2] | r[3] | r[4] | r[5] | r[6] | r[7]).allfalse())
+	{
+		const GSVector4i dc = GSVector4i::broadcast16(static_cast<u16>((static_cast<s16>(block[0] << 3) + 32) >> 6));
+		for (int i = 0; i < 8; i++)
+			GSVector4i::store<true>(block + 8 * i, dc);
+		return;
+	}
+
+	IDCT_Transpose(r);
+	IDCT_Pass16<true>(r);
+	IDCT_Transpose(r);
+	IDCT_Pass16<false>(r);
+
+	for (int i = 0; i < 8; i++)
+		GSVector4i::store<true>(block + 8 * i, r[i]);
+}
+
+static __forceinline void IDCT_Block(s16* block)
+{
+	// With 4 lanes, the vector version only breaks even with the reference on typical blocks,
+	// since most of their rows take the reference's DC shortcut.
+#if _M_SSE >= 0x501
+	IDCT_Block_vector(block);
+#else
+	IDCT_Block_reference(block);
+#endif
+}
+
+// --------------------------------------------------------------------------------------
+//  DCT coefficient VLC
+// --------------------------------------------------------------------------------------
+
+enum class DCTTable : u8
+{
+	Intra, // Table B-14, any coefficient of an intra block
+	IntraAlt, // Table B-15, intra_vlc_format set on MPEG2
+	NonIntraFirst, // Table B-14, first coefficient of a non-intra block
+	NonIntraNext, // Table B-14, other coefficients of a non-intra block
+	Count
+};
+
+// Finds the table entry for the 16 bits at the head of the bitstream, or nullptr if the code
+// is invalid. This is the chain of range checks the decoder has always used.
+static __forceinline const DCTtab* DCT_Lookup_reference(u16 code, DCTTable table)
+{
+	const bool alt = (table == DCTTable::IntraAlt);
+
+	if (code >= 16384 && !alt)
+		return (table == DCTTable::NonIntraFirst) ? &DCT.first[(code >> 12) - 4] : &DCT.next[(code >> 12) - 4];
+	else if (code >= 1024)
+		return alt ? &DCT.tab0a[(code >> 8) - 4] : &DCT.tab0[(code >> 8) - 4];
+	else if (code >= 512)
+		return alt ? &DCT.tab1a[(code >> 6) - 8] : &DCT.tab1[(code >> 6) - 8];
+	else if (code >= 256)
+		return &DCT.tab2[(code >> 4) - 16];
+	else if (code >= 128)
+		return &DCT.tab3[(code >> 3) - 16];
+	else if (code >= 64)
+		return &DCT.tab4[(code >> 2) - 16];
+	else if (code >= 32)
+		return &DCT.tab5[(code >> 1) - 16];
+	else if (code >= 16)
+		return &DCT.tab6[code - 16];
+	else
+		return nullptr;
+}
+
+struct DCTLookupEntry
+{
+	const DCTtab* table;
+	u8 shift;
+	u8 offset;
+};
+
+// Every range above starts at a power of two, so the number of leading zeros of the code picks
+// the table, shift and offset. Codes with 12 or more leading zeros are invalid.
+static constexpr DCTLookupEntry DCTLookupTable[static_cast<int>(DCTTable::Count)][12] = {
+	{{DCT.next, 12, 4}, {DCT.next, 12, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4},
+		{DCT.tab1, 6, 8}, {DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16}},
+	{{DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4}, {DCT.tab0a, 8, 4},
+		{DCT.tab1a, 6, 8}, {DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16}},
+	{{DCT.first, 12, 4}, {DCT.first, 12, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4},
+		{DCT.tab1, 6, 8}, {DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16}},
+	{{DCT.next, 12, 4}, {DCT.next, 12, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4}, {DCT.tab0, 8, 4},
+		{DCT.tab1, 6, 8}, {DCT.tab2, 4, 16}, {DCT.tab3, 3, 16}, {DCT.tab4, 2, 16}, {DCT.tab5, 1, 16}, {DCT.tab6, 0, 16}},
+};
+
+static __forceinline const DCTtab* DCT_Lookup(u16 code, DCTTable table)
+{
+	const int zeros = std::countl_zero(code);
+	if (zeros >= 12)
+		return nullptr;
+
+	const DCTLookupEntry& entry = DCTLookupTable[static_cast<int>(table)][zeros];
+	return &entry.table[(code >> entry.shift) - entry.offset];
+}
@@ -13,20 +13,13 @@
 #include "IPU/IPUdma.h"
 #include "IPU/yuv2rgb.h"
 #include "IPU/IPU_MultiISA.h"
+#include "IPU/IPU_DCT.h"
 
 // the IPU is fixed to 16 byte strides (128-bit / QWC resolution):
 static const uint decoder_stride = 16;
 
 #if MULTI_ISA_COMPILE_ONCE
 
-static constexpr std::array<u8, 1024> make_clip_lut()
-{
-	std::array<u8, 1024> lut = {};
-	for (int i = -384; i < 640; i++)
-		lut[i+384] = (i < 0) ? 0 : ((i > 255) ? 255 : i);
-	return lut;
-}
-
 static constexpr mpeg2_scan_pack make_scan_pack()
 {
 	constexpr u8 mpeg2_scan_norm[64] = {
@@ -57,7 +50,6 @@ static constexpr mpeg2_scan_pack make_scan_pack()
 	return pack;
 }
 
-alignas(16) const std::array<u8, 1024> g_idct_clip_lut = make_clip_lut();
 alignas(16) const mpeg2_scan_pack mpeg2_scan = make_scan_pack();
 
 #endif
@@ -192,152 +184,16 @@ __ri static u8 getBits8(u8 *address, bool advance)
 }
 
 
-#define W1 2841 /* 2048*sqrt (2)*cos (1*pi/16) */
-#define W2 2676 /* 2048*sqrt (2)*cos (2*pi/16) */
-#define W3 2408 /* 2048*sqrt (2)*cos (3*pi/16) */
-#define W5 1609 /* 2048*sqrt (2)*cos (5*pi/16) */
-#define W6 1108 /* 2048*sqrt (2)*cos (6*pi/16) */
-#define W7 565  /* 2048*sqrt (2)*cos (7*pi/16) */
-
-/*
- * In legal streams, the IDCT output should be between -384 and +384.
- * In corrupted streams, it is possible to force the IDCT output to go
- * to +-3826 - this is the worst case for a column IDCT where the
- * column inputs are 16-bit values.
- */
-
-__fi static void BUTTERFLY(int& t0, int& t1, int w0, int w1, int d0, int d1)
-{
-	int tmp = w0 * (d0 + d1);
-	t0 = tmp + (w1 - w0) * d1;
-	t1 = tmp - (w1 + w0) * d0;
-}
-
-__ri static void IDCT_Block(s16* block)
-{
-	for (int i = 0; i < 8; i++)
-	{
-		s16* const rblock = block + 8 * i;
-		if (!(rblock[1] | ((s32*)rblock)[1] | ((s32*)rblock)[2] |
-				((s32*)rblock)[3]))
-		{
-			u32 tmp = (u16)(rblock[0] << 3);
-			tmp |= tmp << 16;
-			((s32*)rblock)[0] = tmp;
-			((s32*)rblock)[1] = tmp;
-			((s32*)rblock)[2] = tmp;
-			((s32*)rblock)[3] = tmp;
-			continue;
-		}
-
-		int a0, a1, a2, a3;
-		{
-			const int d0 = (rblock[0] << 11) + 128;
-			const int d1 = rblock[1];
-			const int d2 = rblock[2] << 11;
-			const int d3 = rblock[3];
-			int t0 = d0 + d2;
-			int t1 = d0 - d2;
-			int t2, t3;
-			BUTTERFLY(t2, t3, W6, W2, d3, d1);
-			a0 = t0 + t2;
-			a1 = t1 + t3;
-			a2 = t1 - t3;
-			a3 = t0 - t2;
-		}
-
-		int b0, b1, b2, b3;
-		{
-			const int d0 = rblock[4];
-			const int d1 = rblock[5];
-			const int d2 = rblock[6];
-			const int d3 = rblock[7];
-			int t0, t1, t2, t3;
-			BUTTERFLY(t0, t1, W7, W1, d3, d0);
-			BUTTERFLY(t2, t3, W3, W5, d1, d2);
-			b0 = t0 + t2;
-			b3 = t1 + t3;
-			t0 -= t2;
-			t1 -= t3;
-			b1 = ((t0 + t1) * 181) >> 8;
-			b2 = ((t0 - t1) * 181) >> 8;
-		}
-
-		rblock[0] = (a0 + b0) >> 8;
-		rblock[1] = (a1 + b1) >> 8;
-		rblock[2] = (a2 + b2) >> 8;
-		rblock[3] = (a3 + b3) >> 8;
-		rblock[4] = (a3 - b3) >> 8;
-		rblock[5] = (a2 - b2) >> 8;
-		rblock[6] = (a1 - b1) >> 8;
-		rblock[7] = (a0 - b0) >> 8;
-	}
-
-	for (int i = 0; i < 8; i++)
-	{
-		s16* const cblock = block + i;
-
-		int a0, a1, a2, a3;
-		{
-			const int d0 = (cblock[8 * 0] << 11) + 65536;
-			const int d1 = cblock[8 * 1];
-			const int d2 = cblock[8 * 2] << 11;
-			const int d3 = cblock[8 * 3];
-			const int t0 = d0 + d2;
-			const int t1 = d0 - d2;
-			int t2;
-			int t3;
-			BUTTERFLY(t2, t3, W6, W2, d3, d1);
-			a0 = t0 + t2;
-			a1 = t1 + t3;
-			a2 = t1 - t3;
-			a3 = t0 - t2;
-		}
-
-		int b0, b1, b2, b3;
-		{
-			const int d0 = cblock[8 * 4];
-			const int d1 = cblock[8 * 5];
-			const int d2 = cblock[8 * 6];
-			const int d3 = cblock[8 * 7];
-			int t0, t1, t2, t3;
-			BUTTERFLY(t0, t1, W7, W1, d3, d0);
-			BUTTERFLY(t2, t3, W3, W5, d1, d2);
-			b0 = t0 + t2;
-			b3 = t1 + t3;
-			t0 = (t0 - t2) >> 8;
-			t1 = (t1 - t3) >> 8;
-			b1 = (t0 + t1) * 181;
-			b2 = (t0 - t1) * 181;
-		}
-
-		cblock[8 * 0] = (a0 + b0) >> 17;
-		cblock[8 * 1] = (a1 + b1) >> 17;
-		cblock[8 * 2] = (a2 + b2) >> 17;
-		cblock[8 * 3] = (a3 + b3) >> 17;
-		cblock[8 * 4] = (a3 - b3) >> 17;
-		cblock[8 * 5] = (a2 - b2) >> 17;
-		cblock[8 * 6] = (a1 - b1) >> 17;
-		cblock[8 * 7] = (a0 - b0) >> 17;
-	}
-}
-
 __ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
 {
 	IDCT_Block(block);
 
+	// Legal streams stay within -384..+384, saturating to 0..255 clips them.
+	const GSVector4i zero = GSVector4i::zero();
 	for (int i = 0; i < 8; i++)
 	{
-		dest[0] = (g_idct_clip_lut.data() + 384)[block[0]];
-		dest[1] = (g_idct_clip_lut.data() + 384)[block[1]];
-		dest[2] = (g_idct_clip_lut.data() + 384)[block[2]];
-		dest[3] = (g_idct_clip_lut.data() + 384)[block[3]];
-		dest[4] = (g_idct_clip_lut.data() + 384)[block[4]];
-		dest[5] = (g_idct_clip_lut.data() + 384)[block[5]];
-		dest[6] = (g_idct_clip_lut.data() + 384)[block[6]];
-		dest[7] = (g_idct_clip_lut.data() + 384)[block[7]];
-
-		std::memset(block, 0, 16);
+		GSVector4i::storel(dest, GSVector4i::load<true>(block).pu16());
+		GSVector4i::store<true>(block, zero);
 
 		dest += stride;
 		block += 8;
@@ -631,60 +487,8 @@ __ri static bool get_intra_block()
 		}
 
 		code = UBITS(16);
-
-		if (code >= 16384 && (!decoder.intra_vlc_format || decoder.mpeg1))
-		{
-		  tab = &DCT.next[(code >> 12) - 4];
-		}
-		else if (code >= 1024)
-		{
-			if (decoder.intra_vlc_format && !decoder.mpeg1)
-			{
-				tab = &DCT.tab0a[(code >> 8) - 4];
-			}
-			else
-			{
-				tab = &DCT.tab0[(code >> 8) - 4];
-			}
-		}
-		else if (code >= 512)
-		{
-			if (decoder.intra_vlc_format && !decoder.mpeg1)
-			{
-				tab = &DCT.tab1a[(code >> 6) - 8];
-			}
-			else
-			{
-				tab = &DCT.tab1[(code >> 6) - 8];
-			}
-		}
-
-		// [TODO] Optimization: Following codes can all be done by a single "expedited" lookup
-		// that should use a single unrolled DCT table instead of five separate tables used
-		// here.  Multiple conditional statements are very slow, while modern CPU data caches
-		// have lots of room to spare.
-
-		else if (code >= 256)
-		{
-			tab = &DCT.tab2[(code >> 4) - 16];
-		}
-		else if (code >= 128)
-		{
-			tab = &DCT.tab3[(code >> 3) - 16];
-		}
-		else if (code >= 64)
-		{
-			tab = &DCT.tab4[(code >> 2) - 16];
-		}
-		else if (code >= 32)
-		{
-			tab = &DCT.tab5[(code >> 1) - 16];
-		}
-		else if (code >= 16)
-		{
-			tab = &DCT.tab6[code - 16];
-		}
-		else
+		tab = DCT_Lookup(code, (decoder.intra_vlc_format && !decoder.mpeg1) ? DCTTable::IntraAlt : DCTTable::Intra);
+		if (!tab)
 		{
 		  ipu_cmd.pos[4] = 0;
 		  return true;
@@ -789,53 +593,8 @@ __ri static bool get_non_intra_block(int * last)
 			}
 
 			code = UBITS(16);
-
-			if (code >= 16384)
-			{
-				if (i==0)
-				{
-					tab = &DCT.first[(code >> 12) - 4];
-				}
-				else
-				{
-					tab = &DCT.next[(code >> 12)- 4];
-				}
-			}
-			else if (code >= 1024)
-			{
-				tab = &DCT.tab0[(code >> 8) - 4];
-			}
-			else if (code >= 512)
-			{
-				tab = &DCT.tab1[(code >> 6) - 8];
-			}
-
-			// [TODO] Optimization: Following codes can all be done by a single "expedited" lookup
-			// that should use a single unrolled DCT table instead of five separate tables used
-			// here.  Multiple conditional statements are very slow, while modern CPU data caches
-			// have lots of room to spare.
-
-			else if (code >= 256)
-			{
-				tab = &DCT.tab2[(code >> 4) - 16];
-			}
-			else if (code >= 128)
-			{
-				tab = &DCT.tab3[(code >> 3) - 16];
-			}
-			else if (code >= 64)
-			{
-				tab = &DCT.tab4[(code >> 2) - 16];
-			}
-			else if (code >= 32)
-			{
-				tab = &DCT.tab5[(code >> 1) - 16];
-			}
-			else if (code >= 16)
-			{
-				tab = &DCT.tab6[code - 16];
-			}
-			else
+			tab = DCT_Lookup(code, (i == 0) ? DCTTable::NonIntraFirst : DCTTable::NonIntraNext);
+			if (!tab)
 			{
 				ipu_cmd.pos[4] = 0;
 				return true;
@@ -551,6 +551,9 @@ static void intReset()
 {
 	cpuRegs.branch = 0;
 	branch2 = 0;
+
+	// Memchecks are checked per instruction here, the recompiler's page watches aren't needed.
+	vtlb_ClearWatches();
 }
 
 void intEventTest()
@@ -9,11 +9,15 @@
 #include "IconsFontAwesome.h"
 #include "VMManager.h"
 
+#include "common/AlignedMalloc.h"
 #include "common/FPControl.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/WrappedMemCopy.h"
 
+#include <algorithm>
+#include <bit>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -32,14 +36,20 @@
 
 namespace MTGS
 {
+	// Size of the ring in simd128s, and the mask to apply to ring buffer indices to wrap the
+	// pointer from end to start (the wrapping is what makes it a ringbuffer, yo!)
+	// Only changed by AllocateRingBuffer(), while the GS thread isn't running.
+	static uint s_RingBufferSize = 0;
+	static uint s_RingBufferMask = 0;
+
 	struct BufferedData
 	{
-		u128 m_Ring[RingBufferSize];
+		u128* m_Ring = nullptr;
 		u8 Regs[Ps2MemSize::GSregs];
 
 		u128& operator[](uint idx)
 		{
-			pxAssert(idx < RingBufferSize);
+			pxAssert(idx < s_RingBufferSize);
 			return m_Ring[idx];
 		}
 	};
@@ -47,6 +57,8 @@ namespace MTGS
 	static void ThreadEntryPoint();
 	static void MainLoop();
 
+	static void AllocateRingBuffer();
+	static void FreeRingBuffer();
 	static void GenericStall(uint size);
 
 	static void PrepDataPacket(Command cmd, u32 size);
@@ -89,6 +101,20 @@ namespace MTGS
 	// has more than one command in it when the thread is kicked.
 	static int s_CopyDataTally;
 
+	// EE stall telemetry, only touched by the EE thread.
+	static u64 s_StallCount;
+	static u64 s_StallSleepCount;
+	static u64 s_StallNs;
+	static uint s_PeakOccupancy;
+
+	// Moving average of how fast the GS thread drains the ring while the EE is stalled,
+	// in simd128s per microsecond. Zero until the first stall has been measured.
+	static float s_GSThroughput;
+
+	// How long the EE thread takes to resume after being woken, used to pick a wake point
+	// which leaves the GS thread with enough queued work to cover it.
+	static constexpr float STALL_WAKE_LATENCY_US = 200.0f;
+
 #ifdef RINGBUF_DEBUG_STACK
 	static std::mutex s_lock_Stack;
 	static std::list<uint> ringposStack;
@@ -121,6 +147,7 @@ void MTGS::StartThread()
 		return;
 
 	pxAssertRel(!s_open_flag.load(), "GS thread should not be opened when starting");
+	AllocateRingBuffer();
 	s_sem_event.Reset();
 	s_shutdown_flag.store(false, std::memory_order_release);
 	s_thread.Start(&MTGS::ThreadEntryPoint);
@@ -139,6 +166,68 @@ void MTGS::ShutdownThread()
 	// make sure the thread actually exits
 	s_sem_event.NotifyOfWork();
 	s_thread.Join();
+
+	if (s_StallCount > 0)
+	{
+		DevCon.WriteLn("MTGS: %llu EE stalls (%llu slept), %.2f ms stalled, peak occupancy %u/%u, GS throughput %.1f qwc/us",
+			s_StallCount, s_StallSleepCount, static_cast<double>(s_StallNs) / 1000000.0, s_PeakOccupancy,
+			s_RingBufferSize, s_GSThroughput);
+	}
+
+	FreeRingBuffer();
+}
+
+void MTGS::AllocateRingBuffer()
+{
+	// Can't be resized while the GS thread is reading from it.
+	if (s_thread.Joinable())
+		return;
+
+	const u32 size_mb = static_cast<u32>(std::max(EmuConfig.GS.MTGSRingBufferSizeMB, 1));
+	const uint size_factor = std::clamp<uint>(16 + std::bit_width(size_mb - 1), MinRingBufferSizeFactor, MaxRingBufferSizeFactor);
+	const uint size = 1u << size_factor;
+	if (RingBuffer.m_Ring && s_RingBufferSize == size)
+		return;
+
+	FreeRingBuffer();
+
+	RingBuffer.m_Ring = static_cast<u128*>(_aligned_malloc(size * sizeof(u128), __pagesize));
+	if (!RingBuffer.m_Ring)
+		pxFailRel("Failed to allocate MTGS ring buffer");
+
+	s_RingBufferSize = size;
+	s_RingBufferMask = size - 1;
+	s_ReadPos.store(0, std::memory_order_relaxed);
+	s_WritePos.store(0, std::memory_order_relaxed);
+	s_GSThroughput = 0.0f;
+	DevCon.WriteLn("MTGS: Allocated %u KB ring buffer", static_cast<u32>((size * sizeof(u128)) / _1kb));
+}
+
+void MTGS::FreeRingBuffer()
+{
+	safe_aligned_free(RingBuffer.m_Ring);
+	s_RingBufferSize = 0;
+	s_RingBufferMask = 0;
+}
+
+MTGS::StallStats MTGS::GetStallStats()
+{
+	StallStats stats;
+	stats.stalls = s_StallCount;
+	stats.sleeps = s_StallSleepCount;
+	stats.stall_ns = s_StallNs;
+	stats.peak_occupancy = s_PeakOccupancy;
+	stats.ring_size = s_RingBufferSize;
+	stats.gs_throughput = s_GSThroughput;
+	return stats;
+}
+
+void MTGS::ResetStallStats()
+{
+	s_StallCount = 0;
+	s_StallSleepCount = 0;
+	s_StallNs = 0;
+	s_PeakOccupancy = 0;
 }
 
 void MTGS::ThreadEntryPoint()
@@ -207,6 +296,8 @@ void MTGS::ResetGS(bool hardware_reset)
 
 	if (hardware_reset)
 	{
+		// Picks up a changed ring size if the GS thread hasn't been started yet.
+		AllocateRingBuffer();
 		s_ReadPos = s_WritePos.load();
 		s_QueuedFrameCount = 0;
 		s_VsyncSignalListener = 0;
@@ -245,14 +336,14 @@ void MTGS::PostVsyncStart(bool registers_written)
 
 	uint packsize = sizeof(RingCmdPacket_Vsync) / 16;
 	PrepDataPacket(Command::VSync, packsize);
-	MemCopy_WrappedDest((u128*)PS2MEM_GS, RingBuffer.m_Ring, s_packet_writepos, RingBufferSize, 0xf);
+	MemCopy_WrappedDest((u128*)PS2MEM_GS, RingBuffer.m_Ring, s_packet_writepos, s_RingBufferSize, 0xf);
 
 	u32* remainder = (u32*)GetDataPacketPtr();
 	remainder[0] = GSCSRr;
 	remainder[1] = GSIMR._u32;
 	(GSRegSIGBLID&)remainder[2] = GSSIGLBLID;
 	remainder[4] = static_cast<u32>(registers_written);
-	s_packet_writepos = (s_packet_writepos + 2) & RingBufferMask;
+	s_packet_writepos = (s_packet_writepos + 2) & s_RingBufferMask;
 
 	SendDataPacket();
 
@@ -348,7 +439,7 @@ void MTGS::MainLoop()
 		{
 			const unsigned int local_ReadPos = s_ReadPos.load(std::memory_order_relaxed);
 
-			pxAssert(local_ReadPos < RingBufferSize);
+			pxAssert(local_ReadPos < s_RingBufferSize);
 
 			const PacketTagType& tag = (PacketTagType&)RingBuffer[local_ReadPos];
 			u32 ringposinc = 1;
@@ -373,18 +464,18 @@ void MTGS::MainLoop()
 #if COPY_GS_PACKET_TO_MTGS == 1
 				case Command::GIFPath1:
 				{
-					uint datapos = (local_ReadPos + 1) & RingBufferMask;
+					uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
 					const int qsize = tag.data[0];
 					const u128* data = &RingBuffer[datapos];
 
 					MTGS_LOG("(MTGS Packet Read) ringtype=P1, qwc=%u", qsize);
 
 					uint endpos = datapos + qsize;
-					if (endpos >= RingBufferSize)
+					if (endpos >= s_RingBufferSize)
 					{
-						uint firstcopylen = RingBufferSize - datapos;
+						uint firstcopylen = s_RingBufferSize - datapos;
 						GSgifTransfer((u8*)data, firstcopylen);
-						datapos = endpos & RingBufferMask;
+						datapos = endpos & s_RingBufferMask;
 						GSgifTransfer((u8*)RingBuffer.m_Ring, datapos);
 					}
 					else
@@ -398,18 +489,18 @@ void MTGS::MainLoop()
 
 				case Command::GIFPath2:
 				{
-					uint datapos = (local_ReadPos + 1) & RingBufferMask;
+					uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
 					const int qsize = tag.data[0];
 					const u128* data = &RingBuffer[datapos];
 
 					MTGS_LOG("(MTGS Packet Read) ringtype=P2, qwc=%u", qsize);
 
 					uint endpos = datapos + qsize;
-					if (endpos >= RingBufferSize)
+					if (endpos >= s_RingBufferSize)
 					{
-						uint firstcopylen = RingBufferSize - datapos;
+						uint firstcopylen = s_RingBufferSize - datapos;
 						GSgifTransfer2((u32*)data, firstcopylen);
-						datapos = endpos & RingBufferMask;
+						datapos = endpos & s_RingBufferMask;
 						GSgifTransfer2((u32*)RingBuffer.m_Ring, datapos);
 					}
 					else
@@ -423,18 +514,18 @@ void MTGS::MainLoop()
 
 				case Command::GIFPath3:
 				{
-					uint datapos = (local_ReadPos + 1) & RingBufferMask;
+					uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
 					const int qsize = tag.data[0];
 					const u128* data = &RingBuffer[datapos];
 
 					MTGS_LOG("(MTGS Packet Read) ringtype=P3, qwc=%u", qsize);
 
 					uint endpos = datapos + qsize;
-					if (endpos >= RingBufferSize)
+					if (endpos >= s_RingBufferSize)
 					{
-						uint firstcopylen = RingBufferSize - datapos;
+						uint firstcopylen = s_RingBufferSize - datapos;
 						GSgifTransfer3((u32*)data, firstcopylen);
-						datapos = endpos & RingBufferMask;
+						datapos = endpos & s_RingBufferMask;
 						GSgifTransfer3((u32*)RingBuffer.m_Ring, datapos);
 					}
 					else
@@ -491,8 +582,8 @@ void MTGS::MainLoop()
 							// This seemingly obtuse system is needed in order to handle cases where the vsync data wraps
 							// around the edge of the ringbuffer.  If not for that I'd just use a struct. >_<
 
-							uint datapos = (local_ReadPos + 1) & RingBufferMask;
-							MemCopy_WrappedSrc(RingBuffer.m_Ring, datapos, RingBufferSize, (u128*)RingBuffer.Regs, 0xf);
+							uint datapos = (local_ReadPos + 1) & s_RingBufferMask;
+							MemCopy_WrappedSrc(RingBuffer.m_Ring, datapos, s_RingBufferSize, (u128*)RingBuffer.Regs, 0xf);
 
 							u32* remainder = (u32*)&RingBuffer[datapos];
 							((u32&)RingBuffer.Regs[0x1000]) = remainder[0];
@@ -560,7 +651,7 @@ void MTGS::MainLoop()
 				}
 			}
 
-			uint newringpos = (s_ReadPos.load(std::memory_order_relaxed) + ringposinc) & RingBufferMask;
+			uint newringpos = (s_ReadPos.load(std::memory_order_relaxed) + ringposinc) & s_RingBufferMask;
 
 			if (IsDevBuild && EmuConfig.GS.SynchronousMTGS) [[unlikely]]
 			{
@@ -668,7 +759,7 @@ void MTGS::SetEvent()
 
 u8* MTGS::GetDataPacketPtr()
 {
-	return (u8*)&RingBuffer[s_packet_writepos & RingBufferMask];
+	return (u8*)&RingBuffer[s_packet_writepos & s_RingBufferMask];
 }
 
 // Closes the data packet send command, and initiates the gs thread (if needed).
@@ -677,9 +768,9 @@ void MTGS::SendDataPacket()
 	// make sure a previous copy block has been started somewhere.
 	pxAssert(s_packet_size != 0);
 
-	uint actualSize = ((s_packet_writepos - s_packet_startpos) & RingBufferMask) - 1;
+	uint actualSize = ((s_packet_writepos - s_packet_startpos) & s_RingBufferMask) - 1;
 	pxAssert(actualSize <= s_packet_size);
-	pxAssert(s_packet_writepos < RingBufferSize);
+	pxAssert(s_packet_writepos < s_RingBufferSize);
 
 	PacketTagType& tag = (PacketTagType&)RingBuffer[s_packet_startpos];
 	tag.data[0] = actualSize;
@@ -710,8 +801,8 @@ void MTGS::GenericStall(uint size)
 	const uint writepos = s_WritePos.load(std::memory_order_relaxed);
 
 	// Sanity checks! (within the confines of our ringbuffer please!)
-	pxAssert(size < RingBufferSize);
-	pxAssert(writepos < RingBufferSize);
+	pxAssert(size < s_RingBufferSize);
+	pxAssert(writepos < s_RingBufferSize);
 
 	// generic gs wait/stall.
 	// if the writepos is past the readpos then we're safe.
@@ -724,10 +815,17 @@ void MTGS::GenericStall(uint size)
 	if (writepos < readpos)
 		freeroom = readpos - writepos;
 	else
-		freeroom = RingBufferSize - (writepos - readpos);
+		freeroom = s_RingBufferSize - (writepos - readpos);
+
+	const uint used = s_RingBufferSize - freeroom;
+	s_PeakOccupancy = std::max(s_PeakOccupancy, std::min(used + size, s_RingBufferSize));
 
 	if (freeroom <= size)
 	{
+		const Common::Timer::Value stall_start = Common::Timer::GetCurrentValue();
+		const uint stall_readpos = readpos;
+		s_StallCount++;
+
 		// writepos will overlap readpos if we commit the data, so we need to wait until
 		// readpos is out past the end of the future write pos, or until it wraps around
 		// (in which case writepos will be >= readpos).
@@ -736,7 +834,7 @@ void MTGS::GenericStall(uint size)
 		// the next packet will likely stall up too.  So lets set a condition for the MTGS
 		// thread to wake up the EE once there's a sizable chunk of the ringbuffer emptied.
 
-		uint somedone = (RingBufferSize - freeroom) / 4;
+		uint somedone = used / 4;
 		if (somedone < size + 1)
 			somedone = size + 1;
 
@@ -744,10 +842,29 @@ void MTGS::GenericStall(uint size)
 		// every other frame is nothing more than a page swap.  Sleeping the EEcore is a
 		// waste of time, and we get better results using a spinwait.
 
-		if (somedone > 0x80)
+		// Once we know how fast the GS thread drains the ring, spin only if the space we
+		// need should be free within the spin time, and don't wait for so much to drain
+		// that the GS thread runs dry before we're back up. Until then, use a fixed threshold.
+		bool sleep;
+		if (s_GSThroughput > 0.0f)
+		{
+			const float needed_us = static_cast<float>(size + 1 - freeroom) / s_GSThroughput;
+			sleep = (needed_us * 1000.0f) > static_cast<float>(SPIN_TIME_NS);
+
+			const uint wake_margin = static_cast<uint>(s_GSThroughput * STALL_WAKE_LATENCY_US);
+			if (used > wake_margin)
+				somedone = std::max(std::min(somedone, used - wake_margin), size + 1);
+		}
+		else
+		{
+			sleep = (somedone > 0x80);
+		}
+
+		if (sleep)
 		{
 			pxAssertMsg(s_SignalRingEnable == 0, "MTGS Thread Synchronization Error");
 			s_SignalRingPosition.store(somedone, std::memory_order_release);
+			s_StallSleepCount++;
 
 			//Console.WriteLn( Color_Blue, "(EEcore Sleep) PrepDataPacker \tringpos=0x%06x, writepos=0x%06x, signalpos=0x%06x", readpos, writepos, m_SignalRingPosition );
 
@@ -762,7 +879,7 @@ void MTGS::GenericStall(uint size)
 				if (writepos < readpos)
 					freeroom = readpos - writepos;
 				else
-					freeroom = RingBufferSize - (writepos - readpos);
+					freeroom = s_RingBufferSize - (writepos - readpos);
 
 				if (freeroom > size)
 					break;
@@ -782,12 +899,21 @@ void MTGS::GenericStall(uint size)
 				if (writepos < readpos)
 					freeroom = readpos - writepos;
 				else
-					freeroom = RingBufferSize - (writepos - readpos);
+					freeroom = s_RingBufferSize - (writepos - readpos);
 
 				if (freeroom > size)
 					break;
 			}
 		}
+
+		const double stall_ns = Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue() - stall_start);
+		const uint consumed = (readpos - stall_readpos) & s_RingBufferMask;
+		s_StallNs += static_cast<u64>(stall_ns);
+		if (stall_ns > 0.0 && consumed > 0)
+		{
+			const float rate = static_cast<float>(consumed / (stall_ns / 1000.0));
+			s_GSThroughput = (s_GSThroughput > 0.0f) ? (s_GSThroughput * 0.75f + rate * 0.25f) : rate;
+		}
 	}
 }
 
@@ -805,7 +931,7 @@ void MTGS::PrepDataPacket(Command cmd, u32 size)
 	tag.command = static_cast<u32>(cmd);
 	tag.data[0] = s_packet_size;
 	s_packet_startpos = local_WritePos;
-	s_packet_writepos = (local_WritePos + 1) & RingBufferMask;
+	s_packet_writepos = (local_WritePos + 1) & s_RingBufferMask;
 }
 
 // Returns the amount of giftag data processed (in simd128 values).
@@ -822,7 +948,7 @@ void MTGS::PrepDataPacket(GIF_PATH pathidx, u32 size)
 
 __fi void MTGS::_FinishSimplePacket()
 {
-	uint future_writepos = (s_WritePos.load(std::memory_order_relaxed) + 1) & RingBufferMask;
+	uint future_writepos = (s_WritePos.load(std::memory_order_relaxed) + 1) & s_RingBufferMask;
 	pxAssert(future_writepos != s_ReadPos.load(std::memory_order_acquire));
 	s_WritePos.store(future_writepos, std::memory_order_release);
 
@@ -1061,7 +1187,7 @@ void Gif_AddCompletedGSPacket(GS_Packet& gsPack, GIF_PATH path)
 	{
 		MTGS::PrepDataPacket(path, gsPack.size / 16);
 		MemCopy_WrappedDest((u128*)&gifUnit.gifPath[path].buffer[gsPack.offset], MTGS::RingBuffer.m_Ring,
-							MTGS::s_packet_writepos, MTGS::RingBufferSize, gsPack.size / 16);
+							MTGS::s_packet_writepos, MTGS::s_RingBufferSize, gsPack.size / 16);
 		MTGS::SendDataPacket();
 	}
 	else
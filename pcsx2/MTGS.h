@@ -79,16 +79,29 @@ namespace MTGS
 		u32* width, u32* height, std::vector<u32>* pixels);
 	void SetRunIdle(bool enabled);
 
+	struct StallStats
+	{
+		u64 stalls; // Number of times the EE thread waited for ring space
+		u64 sleeps; // Number of those waits which slept instead of spinning
+		u64 stall_ns; // Total time the EE thread spent waiting for ring space
+		uint peak_occupancy; // Highest number of simd128s queued at once
+		uint ring_size; // Size of the ring in simd128s
+		float gs_throughput; // Estimated GS thread consumption while the EE is stalled, in simd128s per microsecond
+	};
+
+	/// Returns the EE thread's ring buffer stall counters. Should only be called from the CPU thread.
+	StallStats GetStallStats();
+	void ResetStallStats();
+
 	// Size of the ringbuffer as a power of 2 -- size is a multiple of simd128s.
 	// (actual size is 1<<m_RingBufferSizeFactor simd vectors [128-bit values])
 	// A value of 19 is a 8meg ring buffer.  18 would be 4 megs, and 20 would be 16 megs.
 	// Default was 2mb, but some games with lots of MTGS activity want 8mb to run fast (rama)
-	static const uint RingBufferSizeFactor = 19;
-
-	// size of the ringbuffer in simd128's.
-	static const uint RingBufferSize = 1 << RingBufferSizeFactor;
+	// The size actually used comes from GSOptions::MTGSRingBufferSizeMB, clamped to the limits below.
+	static const uint DefaultRingBufferSizeFactor = 19;
+	static const uint MinRingBufferSizeFactor = 16;
+	static const uint MaxRingBufferSizeFactor = 22;
 
-	// Mask to apply to ring buffer indices to wrap the pointer from end to
-	// start (the wrapping is what makes it a ringbuffer, yo!)
-	static const uint RingBufferMask = RingBufferSize - 1;
+	// default size of the ringbuffer in simd128's.
+	static const uint DefaultRingBufferSize = 1 << DefaultRingBufferSizeFactor;
 }
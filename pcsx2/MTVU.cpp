@@ -7,6 +7,9 @@
 #include "VMManager.h"
 #include "Vif_Dynarec.h"
 
+#include "common/HostSys.h"
+#include "common/Timer.h"
+
 #include <thread>
 
 VU_Thread vu1Thread;
@@ -52,12 +55,14 @@ bool SaveStateBase::mtvuFreeze()
 	if (!IsSaving())
 	{
 		vu1Thread.Reset();
+		vu1Thread.BeginBatch();
 		vu1Thread.WriteCol(vif1);
 		vu1Thread.WriteRow(vif1);
 		vu1Thread.WriteMicroMem(0, VU1.Micro, 0x4000);
 		vu1Thread.WriteDataMem(0, VU1.Mem, 0x4000);
 		vu1Thread.WriteVIRegs(&VU1.VI[0]);
 		vu1Thread.WriteVFRegs(&VU1.VF[0]);
+		vu1Thread.EndBatch();
 	}
 	for (size_t i = 0; i < 4; ++i)
 	{
@@ -109,6 +114,15 @@ void VU_Thread::Close()
 	m_shutdown_flag.store(true, std::memory_order_release);
 	semaEvent.NotifyOfWork();
 	m_thread.Join();
+
+	const Stats stats = GetStats();
+	if (stats.commands > 0)
+	{
+		DevCon.WriteLn("MTVU: %llu commands in %llu submissions, %llu idle waits, peak occupancy %u words",
+			stats.commands, stats.submissions, stats.idle_waits, stats.peak_occupancy);
+		DevCon.WriteLn("MTVU: ring full %llu times (%llu parked), %.2f ms stalled",
+			stats.full_stalls, stats.full_parks, static_cast<double>(stats.full_stall_ns) / 1000000.0);
+	}
 }
 
 void VU_Thread::Reset()
@@ -118,6 +132,9 @@ void VU_Thread::Reset()
 	m_write_pos = 0;
 	m_ato_read_pos = 0;
 	m_read_pos = 0;
+	m_batch_depth = 0;
+	m_batch_pending = false;
+	ResetStats();
 	std::memset(&vif, 0, sizeof(vif));
 	std::memset(&vifRegs, 0, sizeof(vifRegs));
 	for (size_t i = 0; i < 4; ++i)
@@ -132,6 +149,7 @@ void VU_Thread::ExecuteRingBuffer()
 	for (;;)
 	{
 		semaEvent.WaitForWork();
+		m_idle_waits.fetch_add(1, std::memory_order_relaxed);
 		if (m_shutdown_flag.load(std::memory_order_acquire))
 			break;
 
@@ -201,7 +219,15 @@ void VU_Thread::ExecuteRingBuffer()
 			}
 
 			CommitReadPos();
+			NotifyOfSpace();
+			m_commands.fetch_add(1, std::memory_order_relaxed);
 		}
+
+		// The checks above aren't ordered against our read position stores, so the EE thread can
+		// have missed the last one and parked. Once the ring is drained, nothing else would wake it.
+		// Pairs with the fence in WaitOnSize(), so either we see the flag or it sees our read position.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		NotifyOfSpace();
 	}
 
 	semaEvent.Kill();
@@ -211,6 +237,8 @@ void VU_Thread::ExecuteRingBuffer()
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+	Common::Timer::Value start = 0;
+	u32 waited = 0;
 	for (;;)
 	{
 		s32 readPos = GetReadPos();
@@ -223,14 +251,41 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 		// Note: a wait lock instead of a yield also helps to avoid the bug.
 		if (readPos > m_write_pos + size + _4kb)
 			break; // Enough free front space
-		{          // Let MTVU run to free up buffer space
+
+		// Let MTVU run to free up buffer space
+		if (start == 0)
+		{
+			start = Common::Timer::GetCurrentValue();
+			m_full_stalls++;
+			FlushBatch();
 			KickStart();
-			// Locking might trigger a full flush of the ring buffer. Yield
-			// will be more aggressive, and only flush the minimal size.
-			// Performance will be smoother but it will consume extra CPU cycle
-			// on the EE thread (not an issue on 4 cores).
-			std::this_thread::yield();
 		}
+
+		// Spin first, the VU thread usually only needs to retire a packet or
+		// two. Sleeping straight away would flush far more of the ring than
+		// needed, but spinning for longer burns a core on a stalled VU program.
+		if (waited < SPIN_TIME_NS)
+		{
+			waited += ShortSpin();
+			continue;
+		}
+
+		// Publish that we're waiting, then check again before sleeping, the VU
+		// thread may have made space before it saw the flag.
+		if (!m_space_waiting.exchange(true, std::memory_order_relaxed))
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			continue;
+		}
+
+		m_full_parks++;
+		semaSpace.Wait();
+	}
+
+	if (start != 0)
+	{
+		m_space_waiting.store(false, std::memory_order_relaxed);
+		m_full_stall_ns += static_cast<u64>(Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue() - start));
 	}
 }
 
@@ -276,6 +331,9 @@ __fi u32* VU_Thread::GetWritePtr()
 __fi void VU_Thread::CommitWritePos()
 {
 	m_ato_write_pos.store(m_write_pos, std::memory_order_release);
+	m_batch_pending = false;
+	m_submissions++;
+	m_peak_occupancy = std::max(m_peak_occupancy, GetRingOccupancy());
 
 	if (MTVU_ALWAYS_KICK)
 		KickStart();
@@ -288,6 +346,33 @@ __fi void VU_Thread::CommitReadPos()
 	m_ato_read_pos.store(m_read_pos, std::memory_order_release);
 }
 
+// Commits any commands held back by a batch and wakes the VU thread
+__fi void VU_Thread::FlushBatch()
+{
+	if (!m_batch_pending)
+		return;
+
+	CommitWritePos();
+	KickStart();
+}
+
+// Called after writing a complete command
+__fi void VU_Thread::Submit()
+{
+	m_batch_pending = true;
+	if (m_batch_depth == 0)
+		FlushBatch();
+}
+
+// Wakes the EE thread if it's sleeping on a full ring (called from the VU thread)
+// Called after every command without a fence, the flag is usually seen by the next
+// command. The fence is only paid once per drain of the ring, in ExecuteRingBuffer().
+__fi void VU_Thread::NotifyOfSpace()
+{
+	if (m_space_waiting.load(std::memory_order_relaxed) && m_space_waiting.exchange(false, std::memory_order_relaxed))
+		semaSpace.Post();
+}
+
 __fi u32 VU_Thread::Read()
 {
 	u32 ret = buffer[m_read_pos];
@@ -435,7 +520,51 @@ bool VU_Thread::IsDone()
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
-	semaEvent.WaitForEmpty();
+	FlushBatch();
+	semaEvent.WaitForEmptyWithSpin();
+}
+
+void VU_Thread::BeginBatch()
+{
+	m_batch_depth++;
+}
+
+void VU_Thread::EndBatch()
+{
+	pxAssert(m_batch_depth > 0);
+	if (--m_batch_depth == 0)
+		FlushBatch();
+}
+
+u32 VU_Thread::GetRingOccupancy()
+{
+	const s32 readPos = GetReadPos();
+	const s32 writePos = GetWritePos();
+	return static_cast<u32>((writePos >= readPos) ? (writePos - readPos) : (buffer_size - readPos + writePos));
+}
+
+VU_Thread::Stats VU_Thread::GetStats()
+{
+	Stats stats;
+	stats.commands = m_commands.load(std::memory_order_relaxed);
+	stats.submissions = m_submissions;
+	stats.idle_waits = m_idle_waits.load(std::memory_order_relaxed);
+	stats.full_stalls = m_full_stalls;
+	stats.full_parks = m_full_parks;
+	stats.full_stall_ns = m_full_stall_ns;
+	stats.peak_occupancy = m_peak_occupancy;
+	return stats;
+}
+
+void VU_Thread::ResetStats()
+{
+	m_commands.store(0, std::memory_order_relaxed);
+	m_submissions = 0;
+	m_idle_waits.store(0, std::memory_order_relaxed);
+	m_full_stalls = 0;
+	m_full_parks = 0;
+	m_full_stall_ns = 0;
+	m_peak_occupancy = 0;
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
@@ -474,8 +603,7 @@ void VU_Thread::VifUnpack(vifStruct& _vif, VIFregisters& _vifRegs, const u8* dat
 	WriteRegs(&_vifRegs);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
 
 void VU_Thread::WriteMicroMem(u32 vu_micro_addr, const void* data, u32 size)
@@ -486,8 +614,7 @@ void VU_Thread::WriteMicroMem(u32 vu_micro_addr, const void* data, u32 size)
 	Write(vu_micro_addr);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
 
 void VU_Thread::WriteDataMem(u32 vu_data_addr, const void* data, u32 size)
@@ -498,8 +625,7 @@ void VU_Thread::WriteDataMem(u32 vu_data_addr, const void* data, u32 size)
 	Write(vu_data_addr);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
 
 void VU_Thread::WriteVIRegs(REG_VI* viRegs)
@@ -508,8 +634,7 @@ void VU_Thread::WriteVIRegs(REG_VI* viRegs)
 	ReserveSpace(1 + size_u32(32));
 	Write(MTVU_VU_WRITE_VIREGS);
 	Write(viRegs, size_u32(32));
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
 
 void VU_Thread::WriteVFRegs(VECTOR* vfRegs)
@@ -518,8 +643,7 @@ void VU_Thread::WriteVFRegs(VECTOR* vfRegs)
 	ReserveSpace(1 + size_u32(32*4));
 	Write(MTVU_VU_WRITE_VFREGS);
 	Write(vfRegs, size_u32(32*4));
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
 
 void VU_Thread::WriteCol(vifStruct& _vif)
@@ -528,8 +652,7 @@ void VU_Thread::WriteCol(vifStruct& _vif)
 	ReserveSpace(1 + size_u32(sizeof(_vif.MaskCol)));
 	Write(MTVU_VIF_WRITE_COL);
 	Write(&_vif.MaskCol, sizeof(_vif.MaskCol));
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
 
 void VU_Thread::WriteRow(vifStruct& _vif)
@@ -538,6 +661,5 @@ void VU_Thread::WriteRow(vifStruct& _vif)
 	ReserveSpace(1 + size_u32(sizeof(_vif.MaskRow)));
 	Write(MTVU_VIF_WRITE_ROW);
 	Write(&_vif.MaskRow, sizeof(_vif.MaskRow));
-	CommitWritePos();
-	KickStart();
+	Submit();
 }
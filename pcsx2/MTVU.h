@@ -26,7 +26,11 @@ class VU_Thread final {
 	alignas(__cachelinesize) int  m_read_pos; // temporary read pos (local to the VU thread)
 	int  m_write_pos; // temporary write pos (local to the EE thread)
 	Threading::WorkSema semaEvent;
+	Threading::UserspaceSemaphore semaSpace; // Posted by VU thread when the EE thread is parked on a full ring
+	std::atomic_bool m_space_waiting{false};
 	std::atomic_bool m_shutdown_flag{false};
+	u32  m_batch_depth = 0; // Nesting level of BeginBatch() (local to the EE thread)
+	bool m_batch_pending = false; // Commands written but not yet committed (local to the EE thread)
 
 	Threading::Thread m_thread;
 
@@ -50,6 +54,17 @@ public:
 	std::atomic<u64> gsLabel; // Used for GS Label command
 	std::atomic<u64> gsSignal; // Used for GS Signal command
 
+	struct Stats
+	{
+		u64 commands; // Commands processed by the VU thread
+		u64 submissions; // Times the EE thread published new commands to the VU thread
+		u64 idle_waits; // Times the VU thread drained the ring and waited for work
+		u64 full_stalls; // Times the EE thread found the ring full
+		u64 full_parks; // Times the EE thread slept on a full ring after spinning
+		u64 full_stall_ns; // Total time the EE thread spent waiting for ring space
+		u32 peak_occupancy; // Highest ring occupancy seen on submission, in words
+	};
+
 	VU_Thread();
 	~VU_Thread();
 
@@ -75,6 +90,17 @@ public:
 	// Waits till MTVU is done processing
 	void WaitVU();
 
+	// Defers committing commands until the matching EndBatch(), so a sequence of
+	// writes costs a single commit and wake-up of the VU thread. Batches may nest.
+	void BeginBatch();
+	void EndBatch();
+
+	// Returns the number of words currently queued for the VU thread.
+	u32 GetRingOccupancy();
+
+	Stats GetStats();
+	void ResetStats();
+
 	void Get_MTVUChanges();
 
 	void ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst);
@@ -108,6 +134,9 @@ private:
 
 	void CommitWritePos();
 	void CommitReadPos();
+	void FlushBatch();
+	void Submit();
+	void NotifyOfSpace();
 
 	u32 Read();
 	void Read(void* dest, u32 size);
@@ -118,6 +147,17 @@ private:
 	void WriteRegs(VIFregisters* src);
 
 	u32 Get_vuCycles();
+
+	// EE thread counters
+	u64 m_submissions = 0;
+	u64 m_full_stalls = 0;
+	u64 m_full_parks = 0;
+	u64 m_full_stall_ns = 0;
+	u32 m_peak_occupancy = 0;
+
+	// VU thread counters, read by the EE thread
+	std::atomic<u64> m_commands{0};
+	std::atomic<u64> m_idle_waits{0};
 };
 
 extern VU_Thread vu1Thread;
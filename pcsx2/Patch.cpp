@@ -103,6 +103,16 @@ namespace Patch
 		requires std::is_base_of_v<MemoryInterface, EEMemory> &&
 	             std::is_base_of_v<MemoryInterface, IOPMemory>
 	void ApplyPatch(const PatchCommand* p, EEMemory& ee, IOPMemory& iop, ExtendedState& state);
+	template <typename EEMemory, typename IOPMemory>
+		requires std::is_base_of_v<MemoryInterface, EEMemory> &&
+	             std::is_base_of_v<MemoryInterface, IOPMemory>
+	static void ApplyPatchProgram(const PatchProgram& program, patch_place_type place, EEMemory& ee, IOPMemory& iop);
+	template <typename Memory>
+		requires std::is_base_of_v<MemoryInterface, Memory>
+	static void ApplyWriteRun(const PatchProgram::Write* writes, u32 count, Memory& memory);
+	template <typename Memory>
+		requires std::is_base_of_v<MemoryInterface, Memory>
+	static void ApplyWriteRunToPage(const PatchProgram::Write* writes, u32 count, Memory& memory, const u8* page);
 	static void ApplyDynaPatch(const DynamicPatch& patch, u32 address);
 	template <typename Memory>
 		requires std::is_base_of_v<MemoryInterface, Memory>
@@ -131,6 +141,7 @@ namespace Patch
 	static u32 s_cheats_counts = 0;
 
 	static std::vector<const PatchCommand*> s_active_patches;
+	static PatchProgram s_active_program;
 	static std::vector<DynamicPatch> s_active_gamedb_dynamic_patches;
 	static std::vector<DynamicPatch> s_active_pnach_dynamic_patches;
 	static std::vector<std::string> s_enabled_cheats;
@@ -795,6 +806,8 @@ void Patch::UpdateActivePatches(bool reload_enabled_list, bool verbose, bool ver
 		message.append_format("{}{}", message.empty() ? "" : "\n",
 			TRANSLATE_PLURAL_STR("Patch", "%n cheat patches are active.", "OSD Message", c_count));
 
+	CompilePatches(&s_active_program, s_active_patches);
+
 	// Display message on first boot when we load patches.
 	// Except when it's just GameDB.
 	const bool just_gamedb = (p_count == 0 && c_count == 0 && gp_count > 0);
@@ -874,6 +887,7 @@ void Patch::UnloadPatches()
 	s_override_aspect_ratio = {};
 	s_patches_crc = 0;
 	s_active_patches = {};
+	s_active_program = {};
 	s_active_pnach_dynamic_patches = {};
 	s_active_gamedb_dynamic_patches = {};
 	s_enabled_patches = {};
@@ -1102,17 +1116,17 @@ void Patch::ApplyBootPatches()
 {
 	EEMemoryInterface ee;
 	IOPMemoryInterface iop;
-	ApplyPatches(s_active_patches, PPT_ONCE_ON_LOAD, ee, iop);
-	ApplyPatches(s_active_patches, PPT_COMBINED_0_1, ee, iop);
-	ApplyPatches(s_active_patches, PPT_ON_LOAD_OR_WHEN_ENABLED, ee, iop);
+	ApplyPatches(s_active_program, PPT_ONCE_ON_LOAD, ee, iop);
+	ApplyPatches(s_active_program, PPT_COMBINED_0_1, ee, iop);
+	ApplyPatches(s_active_program, PPT_ON_LOAD_OR_WHEN_ENABLED, ee, iop);
 }
 
 void Patch::ApplyVsyncPatches()
 {
 	EEMemoryInterface ee;
 	IOPMemoryInterface iop;
-	ApplyPatches(s_active_patches, PPT_CONTINUOUSLY, ee, iop);
-	ApplyPatches(s_active_patches, PPT_COMBINED_0_1, ee, iop);
+	ApplyPatches(s_active_program, PPT_CONTINUOUSLY, ee, iop);
+	ApplyPatches(s_active_program, PPT_COMBINED_0_1, ee, iop);
 }
 
 void Patch::ApplyPatches(
@@ -1161,6 +1175,238 @@ void Patch::ApplyPatches(
 	}
 }
 
+void Patch::PatchProgram::Clear()
+{
+	for (std::vector<Op>& place_ops : ops)
+		place_ops.clear();
+	writes.clear();
+	commands.clear();
+}
+
+void Patch::CompilePatches(PatchProgram* program, const std::vector<const PatchCommand*>& patches)
+{
+	program->Clear();
+
+	// One place at a time, so the writes and commands for each op end up next to each other.
+	for (u32 place = 0; place < PPT_END_MARKER; place++)
+	{
+		std::vector<PatchProgram::Op>& ops = program->ops[place];
+
+		// Extended state only needs resetting at the start of a group if a previous group could have changed it.
+		bool state_used = false;
+
+		for (const PatchCommand* patch : patches)
+		{
+			if (!patch)
+			{
+				if (state_used)
+				{
+					ops.push_back({PatchProgram::OpType::ResetState, CPU_EE, 0, 0});
+					state_used = false;
+				}
+				continue;
+			}
+
+			if (patch->placetopatch != place || (patch->cpu != CPU_EE && patch->cpu != CPU_IOP))
+				continue;
+
+			// The IOP only takes bytes, shorts and words, the rest are ignored by ApplyPatch().
+			const bool ee = (patch->cpu == CPU_EE);
+			u32 size = 0;
+			u64 value = patch->data;
+			switch (patch->type)
+			{
+				case BYTE_T:
+					size = 1;
+					value = static_cast<u8>(value);
+					break;
+				case SHORT_T:
+					size = 2;
+					value = static_cast<u16>(value);
+					break;
+				case WORD_T:
+					size = 4;
+					value = static_cast<u32>(value);
+					break;
+				case DOUBLE_T:
+					size = ee ? 8 : 0;
+					break;
+				case SHORT_BE_T:
+					size = ee ? 2 : 0;
+					value = ByteSwap(static_cast<u16>(value));
+					break;
+				case WORD_BE_T:
+					size = ee ? 4 : 0;
+					value = ByteSwap(static_cast<u32>(value));
+					break;
+				case DOUBLE_BE_T:
+					size = ee ? 8 : 0;
+					value = ByteSwap(value);
+					break;
+				default:
+					break;
+			}
+
+			if (size != 0 && (patch->addr & vtlb_private::VTLB_PAGE_MASK) + size <= vtlb_private::VTLB_PAGE_SIZE)
+			{
+				const u32 page = patch->addr & ~vtlb_private::VTLB_PAGE_MASK;
+				if (ops.empty() || ops.back().type != PatchProgram::OpType::WriteRun || ops.back().cpu != patch->cpu ||
+					(program->writes[ops.back().start].addr & ~vtlb_private::VTLB_PAGE_MASK) != page)
+				{
+					ops.push_back({PatchProgram::OpType::WriteRun, patch->cpu, static_cast<u32>(program->writes.size()), 0});
+				}
+
+				program->writes.push_back({patch->addr, size, value});
+				ops.back().count++;
+				continue;
+			}
+
+			// Writes which straddle a page are left to the memory interface too.
+			const bool extended = (ee && patch->type == EXTENDED_T);
+			if (size == 0 && !extended && patch->type != BYTES_T)
+				continue;
+
+			if (ops.empty() || ops.back().type != PatchProgram::OpType::Interpret)
+				ops.push_back({PatchProgram::OpType::Interpret, patch->cpu, static_cast<u32>(program->commands.size()), 0});
+
+			program->commands.push_back(patch);
+			ops.back().count++;
+			state_used |= extended;
+		}
+	}
+}
+
+void Patch::ApplyPatches(
+	const PatchProgram& program,
+	patch_place_type place,
+	EEMemoryInterface& ee,
+	IOPMemoryInterface& iop)
+{
+	ApplyPatchProgram(program, place, ee, iop);
+}
+
+void Patch::ApplyPatches(
+	const PatchProgram& program,
+	patch_place_type place,
+	MemoryInterface& ee,
+	MemoryInterface& iop)
+{
+	ApplyPatchProgram(program, place, ee, iop);
+}
+
+template <typename EEMemory, typename IOPMemory>
+	requires std::is_base_of_v<MemoryInterface, EEMemory> &&
+             std::is_base_of_v<MemoryInterface, IOPMemory>
+void Patch::ApplyPatchProgram(const PatchProgram& program, patch_place_type place, EEMemory& ee, IOPMemory& iop)
+{
+	if (place >= PPT_END_MARKER)
+		return;
+
+	ExtendedState state;
+
+	for (const PatchProgram::Op& op : program.ops[place])
+	{
+		switch (op.type)
+		{
+			case PatchProgram::OpType::WriteRun:
+			{
+				if (op.cpu == CPU_EE)
+					ApplyWriteRun(&program.writes[op.start], op.count, ee);
+				else
+					ApplyWriteRun(&program.writes[op.start], op.count, iop);
+				break;
+			}
+			case PatchProgram::OpType::Interpret:
+			{
+				for (u32 i = op.start; i < op.start + op.count; i++)
+					ApplyPatch(program.commands[i], ee, iop, state);
+				break;
+			}
+			case PatchProgram::OpType::ResetState:
+			{
+				state = {};
+				break;
+			}
+		}
+	}
+}
+
+template <typename Memory>
+	requires std::is_base_of_v<MemoryInterface, Memory>
+void Patch::ApplyWriteRun(const PatchProgram::Write* writes, u32 count, Memory& memory)
+{
+	// Every write in the run is to the same page, so when that's EE RAM we can look it up once and compare
+	// against it directly. With the EE cache enabled reads may not come from RAM, so those have to use the
+	// read handlers, as do pages which are mapped to handlers.
+	const u8* page = nullptr;
+	if constexpr (std::is_same_v<Memory, EEMemoryInterface>)
+	{
+		if (!CHECK_CACHE)
+			page = vtlb_memSafePagePtr(writes[0].addr);
+	}
+
+	ApplyWriteRunToPage(writes, count, memory, page);
+}
+
+void Patch::ApplyWriteRun(const PatchProgram::Write* writes, u32 count, MemoryInterface& memory, const u8* page)
+{
+	ApplyWriteRunToPage(writes, count, memory, page);
+}
+
+template <typename Memory>
+	requires std::is_base_of_v<MemoryInterface, Memory>
+void Patch::ApplyWriteRunToPage(const PatchProgram::Write* writes, u32 count, Memory& memory, const u8* page)
+{
+	// Only the writes which change something go through the memory interface.
+	for (u32 i = 0; i < count; i++)
+	{
+		const PatchProgram::Write& write = writes[i];
+		if (page)
+		{
+			if (std::memcmp(page + (write.addr & vtlb_private::VTLB_PAGE_MASK), &write.value, write.size) == 0)
+				continue;
+
+			switch (write.size)
+			{
+				case 1:
+					memory.Write8(write.addr, static_cast<u8>(write.value));
+					break;
+				case 2:
+					memory.Write16(write.addr, static_cast<u16>(write.value));
+					break;
+				case 4:
+					memory.Write32(write.addr, static_cast<u32>(write.value));
+					break;
+				case 8:
+					memory.Write64(write.addr, write.value);
+					break;
+				default:
+					break;
+			}
+		}
+		else
+		{
+			switch (write.size)
+			{
+				case 1:
+					memory.IdempotentWrite8(write.addr, static_cast<u8>(write.value));
+					break;
+				case 2:
+					memory.IdempotentWrite16(write.addr, static_cast<u16>(write.value));
+					break;
+				case 4:
+					memory.IdempotentWrite32(write.addr, static_cast<u32>(write.value));
+					break;
+				case 8:
+					memory.IdempotentWrite64(write.addr, write.value);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
 u32 Patch::GetActiveGameDBPatchesCount()
 {
 	return s_gamedb_counts;
@@ -20,6 +20,7 @@
 #include "common/MemoryInterface.h"
 #include "common/SmallString.h"
 
+#include <array>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -190,6 +191,62 @@ namespace Patch
 		MemoryInterface& ee,
 		MemoryInterface& iop);
 
+	/// The active patches flattened into one list of operations per place, so
+	/// that applying them doesn't have to filter and dispatch every command.
+	/// Consecutive plain writes to the same page are grouped into a run, only
+	/// commands which need ApplyPatch() (e.g. extended codes, which carry state
+	/// from one line to the next) are kept as they are.
+	struct PatchProgram
+	{
+		enum class OpType : u8
+		{
+			WriteRun,
+			Interpret,
+			ResetState,
+		};
+
+		struct Op
+		{
+			OpType type;
+			patch_cpu_type cpu;
+			u32 start;
+			u32 count;
+		};
+
+		struct Write
+		{
+			u32 addr;
+			u32 size;
+			u64 value;
+		};
+
+		std::array<std::vector<Op>, PPT_END_MARKER> ops;
+		std::vector<Write> writes;
+		std::vector<const PatchCommand*> commands;
+
+		void Clear();
+	};
+
+	/// Builds a program from a list of patches, in the form taken by ApplyPatches().
+	extern void CompilePatches(PatchProgram* program, const std::vector<const PatchCommand*>& patches);
+
+	/// Apply the part of a compiled program for the place specified. This does
+	/// the same accesses, in the same order, as applying the source list would.
+	extern void ApplyPatches(
+		const PatchProgram& program,
+		patch_place_type place,
+		EEMemoryInterface& ee,
+		IOPMemoryInterface& iop);
+	extern void ApplyPatches(
+		const PatchProgram& program,
+		patch_place_type place,
+		MemoryInterface& ee,
+		MemoryInterface& iop);
+
+	/// Apply a run of writes from a compiled program. When the page they're all in can be read directly, pass it,
+	/// and writes are skipped by comparing against it rather than going through the read handlers.
+	extern void ApplyWriteRun(const PatchProgram::Write* writes, u32 count, MemoryInterface& memory, const u8* page);
+
 	// Get the total counts of the active game patches.
 	extern u32 GetActiveGameDBPatchesCount();
 	extern u32 GetActivePatchesCount();
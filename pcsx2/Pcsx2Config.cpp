@@ -454,6 +454,7 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU1 = true;
 	EnableFastmem = true;
 	PauseOnTLBMiss = false;
+	EnableBlockProfile = false;
 
 	// vu and fpu clamping default to standard overflow.
 	vu0Overflow = true;
@@ -532,6 +533,7 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
+	SettingsWrapBitBool(EnableBlockProfile);
 
 	SettingsWrapBitBool(vu0Overflow);
 	SettingsWrapBitBool(vu0ExtraOverflow);
@@ -791,6 +793,7 @@ bool Pcsx2Config::GSOptions::operator==(const GSOptions& right) const
 	return (
 		OpEqu(SynchronousMTGS) &&
 		OpEqu(VsyncQueueSize) &&
+		OpEqu(MTGSRingBufferSizeMB) &&
 
 		OpEqu(FramerateNTSC) &&
 		OpEqu(FrameratePAL) &&
@@ -927,6 +930,7 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(ExtendedUpscalingMultipliers);
 
 	SettingsWrapEntry(VsyncQueueSize);
+	SettingsWrapEntry(MTGSRingBufferSizeMB);
 
 	SettingsWrapEntry(FramerateNTSC);
 	SettingsWrapEntry(FrameratePAL);
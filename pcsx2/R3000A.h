@@ -190,6 +190,13 @@ extern R3000Acpu *psxCpu;
 extern R3000Acpu psxInt;
 extern R3000Acpu psxRec;
 
+// Writes out the recompiler's block profile for the current game.
+extern void psxRecSaveBlockProfile();
+
+// Compiles the hottest blocks from the profile before the next block is compiled.
+// Only done on boot and state load, not when the code cache fills up.
+extern void psxRecRequestBlockProfilePrewarm();
+
 extern void psxReset();
 extern void psxException(u32 code, u32 step);
 extern void iopEventTest();
@@ -356,6 +356,13 @@ extern R5900cpu *Cpu;
 extern R5900cpu intCpu;
 extern R5900cpu recCpu;
 
+// Writes out the recompiler's block profile for the current game.
+extern void recSaveBlockProfile();
+
+// Compiles the hottest blocks from the profile before the next block is compiled.
+// Only done on boot and state load, not when the code cache fills up.
+extern void recRequestBlockProfilePrewarm();
+
 enum EE_intProcessStatus
 {
 	INT_NOT_RUNNING = 0,
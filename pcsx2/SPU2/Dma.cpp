@@ -120,7 +120,10 @@ void V_Core::AutoDMAReadBuffer(int mode) //mode: 0= split stereo; 1 = do not spl
 	if (mode)
 	{
 		if (DMAPtr != nullptr)
+		{
 			memcpy(GetMemPtr(0x2000 + (Index << 10) + spos), DMAPtr + InputDataProgress, size);
+			PcmCache::InvalidateRange(0x2000 + (Index << 10) + spos, 0x2000 + (Index << 10) + spos + size / 2);
+		}
 		MADR += size;
 		InputDataLeft -= 0x200;
 		InputDataProgress += 0x200;
@@ -135,7 +138,10 @@ void V_Core::AutoDMAReadBuffer(int mode) //mode: 0= split stereo; 1 = do not spl
 				spos &= ~0x200;
 
 			if (DMAPtr != nullptr)
+			{
 				memcpy(GetMemPtr(0x2000 + (Index << 10) + spos), DMAPtr + InputDataProgress, 0x200);
+				PcmCache::InvalidateRange(0x2000 + (Index << 10) + spos, 0x2000 + (Index << 10) + spos + 0x100);
+			}
 			InputDataTransferred += 0x200;
 			InputDataLeft -= 0x100;
 			InputDataProgress += 0x100;
@@ -258,19 +264,7 @@ void V_Core::FinishDMAwrite()
 		buff1end = 0x100000;
 	}
 
-	const int cacheIdxStart = ActiveTSA / pcm_WordsPerBlock;
-	const int cacheIdxEnd = (buff1end + pcm_WordsPerBlock - 1) / pcm_WordsPerBlock;
-	PcmCacheEntry* cacheLine = &pcm_cache_data[cacheIdxStart];
-	PcmCacheEntry& cacheEnd = pcm_cache_data[cacheIdxEnd];
-
-	do
-	{
-		cacheLine->Validated = false;
-		cacheLine++;
-	} while (cacheLine != &cacheEnd);
-
-	//ConLog( "* SPU2: Cache Clear Range!  TSA=0x%x, TDA=0x%x (low8=0x%x, high8=0x%x, len=0x%x)\n",
-	//	ActiveTSA, buff1end, flagTSA, flagTDA, clearLen );
+	PcmCache::InvalidateRange(ActiveTSA, buff1end);
 
 
 	// First Branch needs cleared:
@@ -286,10 +280,8 @@ void V_Core::FinishDMAwrite()
 		// second branch needs copied:
 		// It starts at the beginning of memory and moves forward to buff2end
 
-		// endpoint cache should be irrelevant, since it's almost certainly dynamic
-		// memory below 0x2800 (registers and such)
-		//const u32 endpt2 = (buff2end + roundUp) / indexer_scalar;
-		//memset( pcm_cache_flags, 0, endpt2 );
+		PcmCache::InvalidateRange(0, buff2end);
+
 		const u32 start = ActiveTSA;
 		TDA = buff1end;
 
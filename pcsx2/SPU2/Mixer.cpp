@@ -5,7 +5,7 @@
 #include "SPU2/Debug.h"
 #include "SPU2/defs.h"
 #include "SPU2/spu2.h"
-#include "SPU2/interpolate_table.h"
+#include "SPU2/VoiceMix.h"
 
 #include "common/Assertions.h"
 
@@ -18,17 +18,6 @@
 #define XAFLAG_LOOP (1ul << 1)
 #define XAFLAG_LOOP_START (1ul << 2)
 
-#if MULTI_ISA_COMPILE_ONCE
-// decoded pcm data, used to cache the decoded data so that it needn't be decoded
-// multiple times.  Cache chunks are decoded when the mixer requests the blocks, and
-// invalided when DMA transfers and memory writes are performed.
-PcmCacheEntry pcm_cache_data[pcm_BlockCount];
-
-int g_counter_cache_hits = 0;
-int g_counter_cache_misses = 0;
-int g_counter_cache_ignores = 0;
-#endif
-
 MULTI_ISA_UNSHARED_START
 
 static const s32 tbl_XA_Factor[16][2] =
@@ -99,11 +88,11 @@ static __forceinline void GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 
 	if (vc.SBuffer == nullptr)
 	{
-		const int cacheIdx = (vc.NextA & 0xFFFF8) / pcm_WordsPerBlock;
-		PcmCacheEntry& cacheLine = pcm_cache_data[cacheIdx];
+		const u32 cacheIdx = (vc.NextA & 0xFFFF8) / pcm_WordsPerBlock;
+		PcmCacheEntry& cacheLine = *PcmCache::GetEntry(cacheIdx);
 		vc.SBuffer = cacheLine.Sampledata;
 
-		if (cacheLine.Validated && vc.Prev1 == cacheLine.Prev1 && vc.Prev2 == cacheLine.Prev2)
+		if (PcmCache::IsValid(cacheIdx) && vc.Prev1 == cacheLine.Prev1 && vc.Prev2 == cacheLine.Prev2)
 		{
 			// Cached block!  Read from the cache directly.
 			// Make sure to propagate the prev1/prev2 ADPCM:
@@ -113,27 +102,14 @@ static __forceinline void GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 
 			//ConLog( "* SPU2: Cache Hit! NextA=0x%x, cacheIdx=0x%x\n", vc.NextA, cacheIdx );
 
-			if (IsDevBuild)
-				g_counter_cache_hits++;
+			PcmCache::s_hits++;
 		}
 		else
 		{
-			// Only flag the cache if it's a non-dynamic memory range.
-			if (vc.NextA >= SPU2_DYN_MEMLINE)
-			{
-				cacheLine.Validated = true;
-				cacheLine.Prev1 = vc.Prev1;
-				cacheLine.Prev2 = vc.Prev2;
-			}
-
-			if (IsDevBuild)
-			{
-				if (vc.NextA < SPU2_DYN_MEMLINE)
-					g_counter_cache_ignores++;
-				else
-					g_counter_cache_misses++;
-			}
-
+			PcmCache::Validate(cacheIdx);
+			cacheLine.Prev1 = vc.Prev1;
+			cacheLine.Prev2 = vc.Prev2;
+			PcmCache::s_misses++;
 
 			s16* memptr = GetMemPtr(vc.NextA & 0xFFFF8);
 			XA_decode_block(vc.SBuffer, memptr, vc.Prev1, vc.Prev2);
@@ -288,14 +264,8 @@ static __forceinline s32 GetVoiceValues(V_Core& thiscore, uint voiceidx)
 {
 	V_Voice& vc(thiscore.Voices[voiceidx]);
 
-	int phase = (vc.SP & 0x0ff0) >> 4;
-	s32 out = 0;
-	out += (interpTable[phase][0] * vc.DecodeFifo[(vc.DecPosRead + 0) % 32]) >> 15;
-	out += (interpTable[phase][1] * vc.DecodeFifo[(vc.DecPosRead + 1) % 32]) >> 15;
-	out += (interpTable[phase][2] * vc.DecodeFifo[(vc.DecPosRead + 2) % 32]) >> 15;
-	out += (interpTable[phase][3] * vc.DecodeFifo[(vc.DecPosRead + 3) % 32]) >> 15;
-
-	return out;
+	const u32 phase = (vc.SP & 0x0ff0) >> 4;
+	return InterpolateVoice(vc.DecodeFifo, vc.DecPosRead, phase);
 }
 
 // This is Dr. Hell's noise algorithm as implemented in pcsxr
@@ -347,8 +317,8 @@ static __forceinline s32 GetNoiseValues(V_Core& thiscore)
 //                                                                                     //
 
 // writes a signed value to the SPU2 ram
-// Performs no cache invalidation -- use only for dynamic memory ranges
-// of the SPU2 (between 0x0000 and SPU2_DYN_MEMLINE)
+// Skips the address masking of spu2M_Write -- use only for the core's fixed buffers
+// below 0x2800 (output, voice 1/3 and mixer outputs)
 static __forceinline void spu2M_WriteFast(u32 addr, s16 value)
 {
 	// Fixes some of the oldest hangs in pcsx2's history! :p
@@ -362,13 +332,15 @@ static __forceinline void spu2M_WriteFast(u32 addr, s16 value)
 	}
 // throw an assertion if the memory range is invalid:
 #ifndef DEBUG_FAST
-	pxAssume(addr < SPU2_DYN_MEMLINE);
+	pxAssume(addr < 0x2800);
 #endif
+	PcmCache::Invalidate(addr);
 	*GetMemPtr(addr) = value;
 }
 
 
-static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
+// Returns the voice output after ADSR, volume is applied by the caller.
+static __forceinline s32 MixVoice(uint coreidx, uint voiceidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
 	V_Voice& vc(thiscore.Voices[voiceidx]);
@@ -381,7 +353,6 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 
 	DecodeSamples(coreidx, voiceidx);
 
-	StereoOut32 voiceOut(0, 0);
 	s32 Value = 0;
 
 	if (vc.ADSR.Phase > V_ADSR::PHASE_STOPPED)
@@ -399,8 +370,6 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 
 		if (IsDevBuild)
 			DebugCores[coreidx].Voices[voiceidx].displayPeak = std::max(DebugCores[coreidx].Voices[voiceidx].displayPeak, (s32)vc.OutX);
-
-		voiceOut = ApplyVolume(StereoOut32(Value, Value), vc.Volume);
 	}
 
 	// SPU2 Note: The spu2 continues to process voices for eternity, always, so we
@@ -417,24 +386,25 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 	else if (voiceidx == 3)
 		spu2M_WriteFast(((0 == coreidx) ? 0x600 : 0xe00) + OutPos, Value);
 
-	return voiceOut;
+	return Value;
 }
 
 static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
+	VoiceOutputSet outputs;
 
+	// Voices have to be stepped in order, since each one can modulate the pitch of the next.
+	// Volume and gates are then applied to all of them at once.
 	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
 	{
-		StereoOut32 VVal(MixVoice(coreidx, voiceidx));
-
-		// Note: Results from MixVoice are ranged at 16 bits.
-
-		dest.Dry.Left += VVal.Left & thiscore.VoiceGates[voiceidx].DryL;
-		dest.Dry.Right += VVal.Right & thiscore.VoiceGates[voiceidx].DryR;
-		dest.Wet.Left += VVal.Left & thiscore.VoiceGates[voiceidx].WetL;
-		dest.Wet.Right += VVal.Right & thiscore.VoiceGates[voiceidx].WetR;
+		const V_VolumeSlideLR& volume = thiscore.Voices[voiceidx].Volume;
+		const s32 value = MixVoice(coreidx, voiceidx);
+		outputs.Set(voiceidx, value, volume.Left.Value, volume.Right.Value);
 	}
+
+	// Note: Results from MixVoice are ranged at 16 bits.
+	dest = MixVoiceOutputs(outputs, thiscore.VoiceGates);
 }
 
 static __forceinline StereoOut32 MixCore(const uint coreidx, const VoiceMixSet& inVoices, const StereoOut32& Input, const StereoOut32& Ext)
@@ -600,15 +570,10 @@ void spu2Mix()
 			p_cachestat_counter = 0;
 			if (SPU2::MsgCache())
 			{
-				SPU2::ConLog(" * SPU2 > CacheStats > Hits: %d  Misses: %d  Ignores: %d\n",
-					g_counter_cache_hits,
-					g_counter_cache_misses,
-					g_counter_cache_ignores);
+				const PcmCache::Stats stats = PcmCache::GetStats();
+				SPU2::ConLog(" * SPU2 > CacheStats > Hits: %llu  Misses: %llu  Pages: %u\n",
+					stats.hits, stats.misses, stats.pages);
 			}
-
-			g_counter_cache_hits =
-				g_counter_cache_misses =
-					g_counter_cache_ignores = 0;
 		}
 	}
 }
@@ -145,6 +145,11 @@ StereoOut32 V_Core::DoReverb(StereoOut32 Input)
 		_spu2mem[diff_dst] = clamp_mix(diff);
 		_spu2mem[apf1_dst] = clamp_mix(apf1);
 		_spu2mem[apf2_dst] = clamp_mix(apf2);
+
+		PcmCache::Invalidate(same_dst);
+		PcmCache::Invalidate(diff_dst);
+		PcmCache::Invalidate(apf1_dst);
+		PcmCache::Invalidate(apf2_dst);
 	}
 
 	out = clamp_mix(out);
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/GSVector.h"
+#include "SPU2/defs.h"
+#include "SPU2/interpolate_table.h"
+
+// Voice mixing kernels, shared by the mixer and the tests. Everything here has internal linkage,
+// since the mixer is compiled once per ISA.
+
+// Output of every voice of a core for one sample. Each row lines up with V_VoiceGates
+// (dry left, dry right, wet left, wet right), so volume and gates can be applied and the
+// voices summed with plain vertical vector operations.
+struct alignas(32) VoiceOutputSet
+{
+	s32 Value[V_Core::NumVoices][4]; // Post-ADSR voice output, replicated
+	s32 Volume[V_Core::NumVoices][4]; // Left, right, left, right
+
+	__forceinline void Set(uint voiceidx, s32 value, s32 left, s32 right)
+	{
+		GSVector4i::store<true>(Value[voiceidx], GSVector4i(value));
+		GSVector4i::store<true>(Volume[voiceidx], GSVector4i(left, right, left, right));
+	}
+};
+
+static __forceinline VoiceMixSet MixVoiceOutputs_reference(const VoiceOutputSet& outputs, const V_VoiceGates* gates)
+{
+	VoiceMixSet ret(StereoOut32(0, 0), StereoOut32(0, 0));
+
+	for (uint i = 0; i < V_Core::NumVoices; i++)
+	{
+		const s32 left = (outputs.Value[i][0] * outputs.Volume[i][0]) >> 15;
+		const s32 right = (outputs.Value[i][1] * outputs.Volume[i][1]) >> 15;
+
+		ret.Dry.Left += left & gates[i].DryL;
+		ret.Dry.Right += right & gates[i].DryR;
+		ret.Wet.Left += left & gates[i].WetL;
+		ret.Wet.Right += right & gates[i].WetR;
+	}
+
+	return ret;
+}
+
+#if _M_SSE >= 0x501
+static __forceinline VoiceMixSet MixVoiceOutputs_avx(const VoiceOutputSet& outputs, const V_VoiceGates* gates)
+{
+	static_assert((V_Core::NumVoices % 2) == 0);
+
+	GSVector8i acc = GSVector8i::zero();
+
+	for (uint i = 0; i < V_Core::NumVoices; i += 2)
+	{
+		const GSVector8i value = GSVector8i::load<true>(outputs.Value[i]);
+		const GSVector8i volume = GSVector8i::load<true>(outputs.Volume[i]);
+		const GSVector8i gate = GSVector8i::load<false>(&gates[i]);
+		acc = acc.add32(value.mul32l(volume).sra32<15>() & gate);
+	}
+
+	const GSVector4i sum = acc.extract<0>().add32(acc.extract<1>());
+	return VoiceMixSet(StereoOut32(sum.I32[0], sum.I32[1]), StereoOut32(sum.I32[2], sum.I32[3]));
+}
+#endif
+
+static __forceinline VoiceMixSet MixVoiceOutputs_sse(const VoiceOutputSet& outputs, const V_VoiceGates* gates)
+{
+	GSVector4i acc = GSVector4i::zero();
+
+	for (uint i = 0; i < V_Core::NumVoices; i++)
+	{
+		const GSVector4i value = GSVector4i::load<true>(outputs.Value[i]);
+		const GSVector4i volume = GSVector4i::load<true>(outputs.Volume[i]);
+		const GSVector4i gate = GSVector4i::load<false>(&gates[i]);
+		acc = acc.add32(value.mul32l(volume).sra32<15>() & gate);
+	}
+
+	return VoiceMixSet(StereoOut32(acc.I32[0], acc.I32[1]), StereoOut32(acc.I32[2], acc.I32[3]));
+}
+
+static __forceinline VoiceMixSet MixVoiceOutputs(const VoiceOutputSet& outputs, const V_VoiceGates* gates)
+{
+#if _M_SSE >= 0x501
+	return MixVoiceOutputs_avx(outputs, gates);
+#else
+	return MixVoiceOutputs_sse(outputs, gates);
+#endif
+}
+
+// 4-tap gaussian interpolation of the decoded samples at fifo[pos], phase being the
+// upper 8 bits of the 12-bit pitch counter fraction.
+static __forceinline s32 InterpolateVoice_reference(const s32* fifo, u32 pos, u32 phase)
+{
+	s32 out = 0;
+	out += (interpTable[phase][0] * fifo[(pos + 0) % 32]) >> 15;
+	out += (interpTable[phase][1] * fifo[(pos + 1) % 32]) >> 15;
+	out += (interpTable[phase][2] * fifo[(pos + 2) % 32]) >> 15;
+	out += (interpTable[phase][3] * fifo[(pos + 3) % 32]) >> 15;
+	return out;
+}
+
+static __forceinline s32 InterpolateVoice(const s32* fifo, u32 pos, u32 phase)
+{
+	pos %= 32;
+
+	const GSVector4i coefs = GSVector4i::loadl(interpTable[phase].data()).i16to32();
+	const GSVector4i samples = (pos <= 28) ?
+		GSVector4i::load<false>(&fifo[pos]) :
+		GSVector4i(fifo[pos], fifo[(pos + 1) % 32], fifo[(pos + 2) % 32], fifo[(pos + 3) % 32]);
+
+	// Each tap is shifted before summing, same as the hardware.
+	GSVector4i out = samples.mul32l(coefs).sra32<15>();
+	out = out.hadd32(out);
+	out = out.hadd32(out);
+	return out.I32[0];
+}
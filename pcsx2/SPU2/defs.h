@@ -593,35 +593,78 @@ namespace SPU2Savestate
 // --------------------------------------------------------------------------------------
 //  ADPCM Decoder Cache
 // --------------------------------------------------------------------------------------
-//  the cache data size is determined by taking the number of adpcm blocks
-//  (2MB / 16) and multiplying it by the decoded block size (28 samples).
-//  Thus: pcm_cache_data = 7,340,032 bytes (ouch!)
-//  Expanded: 16 bytes expands to 56 bytes [3.5:1 ratio]
-//    Resulting in 2MB * 3.5.
-
-// The SPU2 has a dynamic memory range which is used for several internal operations, such as
-// registers, CORE 1/2 mixing, AutoDMAs, and some other fancy stuff.  We exclude this range
-// from the cache here:
-static constexpr s32 SPU2_DYN_MEMLINE = 0x2800;
+//  Decoded blocks are cached so looping voices needn't decode the same data every pass.
+//  Fully expanded, the cache would be 2MB * 3.5 (16 bytes of ADPCM decode to 56 bytes of
+//  PCM), but games only ever play from a small part of SPU2 RAM. So the cache is split
+//  into pages which are allocated the first time a voice plays a block from them.
+//
+//  A bitmap holds one bit per block, set once the block is decoded. Every write to SPU2
+//  RAM clears the bit for the block it lands in, including the core output and reverb
+//  work areas, so no part of memory has to be excluded from caching.
 
 // 8 short words per encoded PCM block. (as stored in SPU2 ram)
 static constexpr int pcm_WordsPerBlock = 8;
 
-// number of cachable ADPCM blocks (any blocks above the SPU2_DYN_MEMLINE)
+// number of ADPCM blocks in SPU2 ram
 static constexpr int pcm_BlockCount = 0x100000 / pcm_WordsPerBlock;
 
 // 28 samples per decoded PCM block (as stored in our cache)
 static constexpr int pcm_DecodedSamplesPerBlock = 28;
 
-struct PcmCacheEntry
+// 256 blocks (4KB of SPU2 ram) per cache page, 16KB once decoded
+static constexpr int pcm_BlocksPerPage = 256;
+static constexpr int pcm_PageCount = pcm_BlockCount / pcm_BlocksPerPage;
+
+struct alignas(64) PcmCacheEntry
 {
-	bool Validated;
 	s16 Sampledata[pcm_DecodedSamplesPerBlock];
 	s32 Prev1;
 	s32 Prev2;
 };
 
-extern PcmCacheEntry pcm_cache_data[pcm_BlockCount];
-extern int g_counter_cache_hits;
-extern int g_counter_cache_misses;
-extern int g_counter_cache_ignores;
+namespace PcmCache
+{
+	struct Stats
+	{
+		u64 hits;
+		u64 misses;
+		u32 pages;
+	};
+
+	extern u64 s_valid[pcm_BlockCount / 64];
+	extern u64 s_hits;
+	extern u64 s_misses;
+
+	/// Returns the cache entry for the block, allocating its page if needed.
+	PcmCacheEntry* GetEntry(u32 block);
+
+	/// Clears the valid bit for every block in the word range [start, end).
+	void InvalidateRange(u32 start, u32 end);
+
+	/// Invalidates every block, keeping the pages so voice SBuffer pointers stay valid.
+	void InvalidateAll();
+
+	/// Invalidates every block, and frees all pages.
+	void Release();
+
+	Stats GetStats();
+	void ResetStats();
+
+	__fi static bool IsValid(u32 block)
+	{
+		return (s_valid[block / 64] & (1ull << (block % 64))) != 0;
+	}
+
+	__fi static void Validate(u32 block)
+	{
+		s_valid[block / 64] |= (1ull << (block % 64));
+	}
+
+	/// Invalidates the block containing the word address.
+	__fi static void Invalidate(u32 addr)
+	{
+		const u32 block = (addr & 0xfffff) / pcm_WordsPerBlock;
+		s_valid[block / 64] &= ~(1ull << (block % 64));
+	}
+} // namespace PcmCache
+
@@ -233,6 +233,7 @@ void SPU2::InternalReset(bool psxmode)
 		memset(_spu2mem, 0, 0x200000);
 		memset(_spu2mem + 0x2800, 7, 0x10); // from BIOS reversal. Locks the voices so they don't run free.
 		memset(_spu2mem + 0xe870, 7, 0x10); // Loop which gets left over by the BIOS, Megaman X7 relies on it being there.
+		PcmCache::Release();
 
 		memset(DCFilterIn, 0, sizeof(DCFilterIn));
 		memset(DCFilterOut, 0, sizeof(DCFilterOut));
@@ -310,6 +311,15 @@ void SPU2::Close()
 
 	s_output_stream.reset();
 
+	const PcmCache::Stats cache_stats = PcmCache::GetStats();
+	if (cache_stats.hits > 0 || cache_stats.misses > 0)
+	{
+		DevCon.WriteLn("SPU2: ADPCM cache %llu hits, %llu misses, %u KB allocated", cache_stats.hits, cache_stats.misses,
+			static_cast<u32>((cache_stats.pages * pcm_BlocksPerPage * sizeof(PcmCacheEntry)) / _1kb));
+	}
+	PcmCache::Release();
+	PcmCache::ResetStats();
+
 #ifdef PCSX2_DEVBUILD
 	WaveDump::Close();
 	DMALogClose();
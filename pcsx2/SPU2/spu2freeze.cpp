@@ -16,9 +16,11 @@ namespace SPU2Savestate
 	// Increment this when changes to the savestate system are made.
 	static constexpr u32 SAVE_VERSION = 0x000e;
 
+	// Voices keep pointers into the cache pages across a failed load, so only
+	// the valid bits are cleared here; the pages are freed on close/reset.
 	static void wipe_the_cache()
 	{
-		memset(pcm_cache_data, 0, pcm_BlockCount * sizeof(PcmCacheEntry));
+		PcmCache::InvalidateAll();
 	}
 } // namespace SPU2Savestate
 
@@ -152,8 +154,8 @@ s32 SPU2Savestate::ThawIt(DataBlock& spud)
 		{
 			for (int v = 0; v < 24; v++)
 			{
-				const int cacheIdx = Cores[c].Voices[v].NextA / pcm_WordsPerBlock;
-				Cores[c].Voices[v].SBuffer = pcm_cache_data[cacheIdx].Sampledata;
+				const u32 cacheIdx = Cores[c].Voices[v].NextA / pcm_WordsPerBlock;
+				Cores[c].Voices[v].SBuffer = PcmCache::GetEntry(cacheIdx)->Sampledata;
 			}
 		}
 	}
@@ -19,6 +19,9 @@
 
 #include "common/Console.h"
 
+#include <cstring>
+#include <memory>
+
 s16 spu2regs[0x010000 / sizeof(s16)];
 s16 _spu2mem[0x200000 / sizeof(s16)];
 
@@ -81,14 +84,7 @@ __forceinline void spu2M_Write(u32 addr, s16 value)
 	// (note to self : addr address WORDs, not bytes)
 
 	addr &= 0xfffff;
-	if (addr >= SPU2_DYN_MEMLINE)
-	{
-		const int cacheIdx = addr / pcm_WordsPerBlock;
-		pcm_cache_data[cacheIdx].Validated = false;
-
-		if (SPU2::MsgToConsole() && SPU2::MsgCache())
-			SPU2::ConLog("* SPU2: PcmCache Block Clear at 0x%x (cacheIdx=0x%x)\n", addr, cacheIdx);
-	}
+	PcmCache::Invalidate(addr);
 	*GetMemPtr(addr) = value;
 }
 
@@ -98,6 +94,71 @@ __forceinline void spu2M_Write(u32 addr, u16 value)
 	spu2M_Write(addr, (s16)value);
 }
 
+// --------------------------------------------------------------------------------------
+//  ADPCM Decoder Cache
+// --------------------------------------------------------------------------------------
+
+u64 PcmCache::s_valid[pcm_BlockCount / 64];
+u64 PcmCache::s_hits = 0;
+u64 PcmCache::s_misses = 0;
+
+static std::unique_ptr<PcmCacheEntry[]> s_pcm_cache_pages[pcm_PageCount];
+static u32 s_pcm_cache_page_count = 0;
+
+PcmCacheEntry* PcmCache::GetEntry(u32 block)
+{
+	std::unique_ptr<PcmCacheEntry[]>& page = s_pcm_cache_pages[block / pcm_BlocksPerPage];
+	if (!page)
+	{
+		page = std::make_unique<PcmCacheEntry[]>(pcm_BlocksPerPage);
+		s_pcm_cache_page_count++;
+	}
+
+	return &page[block % pcm_BlocksPerPage];
+}
+
+void PcmCache::InvalidateRange(u32 start, u32 end)
+{
+	u32 block = start / pcm_WordsPerBlock;
+	const u32 end_block = std::min<u32>((end + pcm_WordsPerBlock - 1) / pcm_WordsPerBlock, pcm_BlockCount);
+
+	// Partial leading word, whole words, then the partial trailing word.
+	for (; block < end_block && (block % 64) != 0; block++)
+		s_valid[block / 64] &= ~(1ull << (block % 64));
+	for (; (block + 64) <= end_block; block += 64)
+		s_valid[block / 64] = 0;
+	for (; block < end_block; block++)
+		s_valid[block / 64] &= ~(1ull << (block % 64));
+
+	if (SPU2::MsgToConsole() && SPU2::MsgCache())
+		SPU2::ConLog("* SPU2: PcmCache Clear Range 0x%x-0x%x\n", start, end);
+}
+
+void PcmCache::InvalidateAll()
+{
+	std::memset(s_valid, 0, sizeof(s_valid));
+}
+
+void PcmCache::Release()
+{
+	std::memset(s_valid, 0, sizeof(s_valid));
+
+	for (std::unique_ptr<PcmCacheEntry[]>& page : s_pcm_cache_pages)
+		page.reset();
+	s_pcm_cache_page_count = 0;
+}
+
+PcmCache::Stats PcmCache::GetStats()
+{
+	return {s_hits, s_misses, s_pcm_cache_page_count};
+}
+
+void PcmCache::ResetStats()
+{
+	s_hits = 0;
+	s_misses = 0;
+}
+
 V_VolumeLR V_VolumeLR::Max(0x7FFF);
 V_VolumeSlideLR V_VolumeSlideLR::Max(0x3FFF, 0x7FFF);
 
@@ -1221,6 +1282,7 @@ static void RegWrite_Core(u16 value)
 					GetMemPtr(0x2000 + (thiscore.Index << 10))[i] = 0;
 					GetMemPtr(0x2200 + (thiscore.Index << 10))[i] = 0;
 				}
+				PcmCache::InvalidateRange(0x2000 + (thiscore.Index << 10), 0x2400 + (thiscore.Index << 10));
 			}
 			break;
 
@@ -62,6 +62,11 @@ static void PreLoadPrep()
 	mmap_ResetBlockTracking();
 
 	VMManager::Internal::ClearCPUExecutionCaches();
+
+#ifdef _M_X86 // TODO(Stenzek): Remove me once EE/VU/IOP recs are added.
+	recRequestBlockProfilePrewarm();
+	psxRecRequestBlockProfilePrewarm();
+#endif
 }
 
 static void PostLoadPrep()
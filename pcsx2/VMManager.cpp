@@ -1675,6 +1675,12 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (g_InputRecording.isActive())
 		g_InputRecording.stop();
 
+#ifdef _M_X86 // TODO(Stenzek): Remove me once EE/VU/IOP recs are added.
+	// Write the block profiles out while we still know which game they belong to.
+	recSaveBlockProfile();
+	psxRecSaveBlockProfile();
+#endif
+
 	SaveSessionTime(s_disc_serial);
 	s_elf_override = {};
 	ClearELFInfo();
@@ -2903,6 +2909,11 @@ void VMManager::Internal::EntryPointCompilingOnCPUThread()
 	mmap_ResetBlockTracking();
 	ClearCPUExecutionCaches();
 
+#ifdef _M_X86 // TODO(Stenzek): Remove me once EE/VU/IOP recs are added.
+	recRequestBlockProfilePrewarm();
+	psxRecRequestBlockProfilePrewarm();
+#endif
+
 	R5900SymbolImporter.OnElfLoadedInMemory();
 }
 
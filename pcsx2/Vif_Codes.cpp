@@ -320,10 +320,12 @@ static __fi void _vifCode_MPG(int idx, u32 addr, const u32* data, int size)
 	{
 		if ((addr + size * 4) > vuMemSize)
 		{
+			vu1Thread.BeginBatch();
 			vu1Thread.WriteMicroMem(addr, (u8*)data, vuMemSize - addr);
 			size -= (vuMemSize - addr) / 4;
 			data += (vuMemSize - addr) / 4;
 			vu1Thread.WriteMicroMem(0, (u8*)data, size * 4);
+			vu1Thread.EndBatch();
 			vifX.tag.addr = size * 4;
 		}
 		else
@@ -346,6 +348,12 @@ static __fi void _vifCode_MPG(int idx, u32 addr, const u32* data, int size)
 		memcpy(VUx.Micro + addr, data, vuMemSize - addr);
 		size -= (vuMemSize - addr) / 4;
 		data += (vuMemSize - addr) / 4;
+
+		// The wrapped part needs clearing too, or programs (and fingerprints) covering it go stale.
+		if (!idx)
+			CpuVU0->Clear(0, size * 4);
+		else
+			CpuVU1->Clear(0, size * 4);
 		memcpy(VUx.Micro, data, size * 4);
 
 		vifX.tag.addr = size * 4;
@@ -4,6 +4,7 @@
 #include "Common.h"
 #include "Vif_Dma.h"
 #include "Vif_Dynarec.h"
+#include "MTVU.h"
 
 //------------------------------------------------------------------
 // VifCode Transfer Interpreter (Vif0/Vif1)
@@ -114,5 +115,11 @@ bool VIF0transfer(u32 *data, int size, bool TTE) {
 	return vifTransfer<0>(data, size, TTE);
 }
 bool VIF1transfer(u32 *data, int size, bool TTE) {
-	return vifTransfer<1>(data, size, TTE);
+	// Hand everything one packet queues for the VU thread over in a single commit.
+	if (THREAD_VU1)
+		vu1Thread.BeginBatch();
+	const bool ret = vifTransfer<1>(data, size, TTE);
+	if (THREAD_VU1)
+		vu1Thread.EndBatch();
+	return ret;
 }
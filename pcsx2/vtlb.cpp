@@ -23,6 +23,7 @@
 #include "IopMem.h"
 #include "Host.h"
 #include "VMManager.h"
+#include "DebugTools/Breakpoints.h"
 
 #include "common/BitUtils.h"
 #include "common/Error.h"
@@ -31,10 +32,12 @@
 
 #include "GS/GSVector.h"
 
+#include <algorithm>
 #include <bit>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
+#include <utility>
 
 #define FASTMEM_LOG(...)
 //#define FASTMEM_LOG(...) Console.WriteLn(__VA_ARGS__)
@@ -54,6 +57,7 @@ static vtlbHandler vtlbHandlerCount = 0;
 static vtlbHandler DefaultPhyHandler;
 static vtlbHandler UnmappedVirtHandler;
 static vtlbHandler UnmappedPhyHandler;
+static vtlbHandler WatchHandler;
 
 struct FastmemVirtualMapping
 {
@@ -85,6 +89,17 @@ static std::unordered_multimap<u32, u32> s_fastmem_physical_mapping; // maps mai
 static std::unordered_map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
 
+struct WatchedPage
+{
+	u32 page;
+	VTLBVirtual original; // mapping to forward accesses to
+};
+
+static std::vector<WatchedPage> s_watched_pages; // sorted by page
+static std::vector<vtlb_WatchRange> s_watch_ranges;
+static vtlb_WatchCallback s_watch_callback = nullptr;
+u32 vtlb_watch_pc = 0;
+
 vtlb_private::VTLBPhysical vtlb_private::VTLBPhysical::fromPointer(sptr ptr)
 {
 	pxAssertMsg(ptr >= 0, "Address too high");
@@ -111,6 +126,24 @@ vtlb_private::VTLBVirtual::VTLBVirtual(VTLBPhysical phys, u32 paddr, u32 vaddr)
 	}
 }
 
+static WatchedPage* vtlb_FindWatchedPage(u32 page)
+{
+	const auto it = std::lower_bound(s_watched_pages.begin(), s_watched_pages.end(), page,
+		[](const WatchedPage& wp, u32 value) { return wp.page < value; });
+	return (it != s_watched_pages.end() && it->page == page) ? &*it : nullptr;
+}
+
+// Looks through a watch, for accesses which aren't made by the emulated program.
+static __fi VTLBVirtual vtlb_GetUnwatchedVirtual(u32 vaddr)
+{
+	const VTLBVirtual vmv = vtlbdata.vmap[vaddr >> VTLB_PAGE_BITS];
+	if (s_watched_pages.empty() || !vmv.isHandler(vaddr) || vmv.assumeHandlerGetID() != WatchHandler)
+		return vmv;
+
+	const WatchedPage* wp = vtlb_FindWatchedPage(vaddr >> VTLB_PAGE_BITS);
+	return wp ? wp->original : vmv;
+}
+
 __inline int CheckCache(u32 addr)
 {
 	// Check if the cache is enabled
@@ -325,7 +358,7 @@ template void vtlb_memWrite<mem64_t>(u32 mem, mem64_t data);
 template <typename DataType>
 bool vtlb_ramRead(u32 addr, DataType* value)
 {
-	const auto vmv = vtlbdata.vmap[addr >> VTLB_PAGE_BITS];
+	const auto vmv = vtlb_GetUnwatchedVirtual(addr);
 	if (vmv.isHandler(addr))
 	{
 		std::memset(value, 0, sizeof(DataType));
@@ -339,7 +372,7 @@ bool vtlb_ramRead(u32 addr, DataType* value)
 template <typename DataType>
 bool vtlb_ramWrite(u32 addr, const DataType& data)
 {
-	const auto vmv = vtlbdata.vmap[addr >> VTLB_PAGE_BITS];
+	const auto vmv = vtlb_GetUnwatchedVirtual(addr);
 	if (vmv.isHandler(addr))
 		return false;
 
@@ -359,6 +392,16 @@ template bool vtlb_ramWrite<mem32_t>(u32 mem, const mem32_t& data);
 template bool vtlb_ramWrite<mem64_t>(u32 mem, const mem64_t& data);
 template bool vtlb_ramWrite<mem128_t>(u32 mem, const mem128_t& data);
 
+const u8* vtlb_memSafePagePtr(u32 mem)
+{
+	const u32 page = mem & ~VTLB_PAGE_MASK;
+	const auto vmv = vtlb_GetUnwatchedVirtual(page);
+	if (vmv.isHandler(page))
+		return nullptr;
+
+	return reinterpret_cast<const u8*>(vmv.assumePtr(page));
+}
+
 int vtlb_memSafeCmpBytes(u32 mem, const void* src, u32 size)
 {
 	// can memcpy so long as pages aren't crossed
@@ -366,7 +409,7 @@ int vtlb_memSafeCmpBytes(u32 mem, const void* src, u32 size)
 	const u8* const sptr_end = sptr + size;
 	while (sptr != sptr_end)
 	{
-		auto vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
+		auto vmv = vtlb_GetUnwatchedVirtual(mem);
 		if (vmv.isHandler(mem))
 			return -1;
 
@@ -390,7 +433,7 @@ bool vtlb_memSafeReadBytes(u32 mem, void* dst, u32 size)
 	u8* const dptr_end = dptr + size;
 	while (dptr != dptr_end)
 	{
-		auto vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
+		auto vmv = vtlb_GetUnwatchedVirtual(mem);
 		if (vmv.isHandler(mem))
 			return false;
 
@@ -411,7 +454,7 @@ bool vtlb_memSafeWriteBytes(u32 mem, const void* src, u32 size)
 	const u8* const sptr_end = sptr + size;
 	while (sptr != sptr_end)
 	{
-		auto vmv = vtlbdata.vmap[mem >> VTLB_PAGE_BITS];
+		auto vmv = vtlb_GetUnwatchedVirtual(mem);
 		if (vmv.isHandler(mem))
 			return false;
 
@@ -603,6 +646,85 @@ static void vtlbUnmappedPWriteSm(u32 addr, OperandType data) {
 static void TAKES_R128 vtlbUnmappedPWriteLg(u32 addr, r128 data) { vtlb_BusError(addr, 1); if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)) { writeCache128(addr, reinterpret_cast<mem128_t*>(&data) /*Safe??*/, false); }}
 // clang-format on
 
+// --------------------------------------------------------------------------------------
+//  Memory watchpoint handlers
+// --------------------------------------------------------------------------------------
+// Watched pages are mapped with their virtual address as the handler's address, so the
+// original mapping can be looked up and the access forwarded to it once checked.
+
+static void vtlb_CheckWatches(u32 addr, u32 size, bool write)
+{
+	const u32 pc = std::exchange(vtlb_watch_pc, 0);
+	if (pc == 0)
+		return;
+
+	// logic: memAddress < bpEnd && bpStart < memAddress+memSize
+	const u32 start = standardizeBreakpointAddress(addr);
+	const u32 end = start + size;
+	const bool hit = std::any_of(s_watch_ranges.begin(), s_watch_ranges.end(), [start, end, write](const vtlb_WatchRange& range) {
+		return (write ? range.write : range.read) && start < range.end && range.start < end;
+	});
+	if (hit)
+		s_watch_callback(pc, addr, size, write);
+}
+
+static VTLBVirtual vtlb_GetWatchedOriginal(u32 addr)
+{
+	const WatchedPage* wp = vtlb_FindWatchedPage(addr >> VTLB_PAGE_BITS);
+	if (wp)
+		return wp->original;
+
+	pxFail("Watch handler called for a page which isn't watched");
+	const u32 page_addr = addr & ~VTLB_PAGE_MASK;
+	return VTLBVirtual(VTLBPhysical::fromHandler(UnmappedVirtHandler), page_addr, page_addr);
+}
+
+template <typename OperandType>
+static OperandType vtlbWatchReadSm(u32 addr)
+{
+	vtlb_CheckWatches(addr, sizeof(OperandType), false);
+
+	const VTLBVirtual vmv = vtlb_GetWatchedOriginal(addr);
+	if (!vmv.isHandler(addr))
+		return *reinterpret_cast<const OperandType*>(vmv.assumePtr(addr));
+
+	return vmv.assumeHandler<sizeof(OperandType) * 8, false>()(vmv.assumeHandlerGetPAddr(addr));
+}
+
+static RETURNS_R128 vtlbWatchReadLg(u32 addr)
+{
+	vtlb_CheckWatches(addr, sizeof(u128), false);
+
+	const VTLBVirtual vmv = vtlb_GetWatchedOriginal(addr);
+	if (!vmv.isHandler(addr))
+		return r128_load(reinterpret_cast<const void*>(vmv.assumePtr(addr)));
+
+	return vmv.assumeHandler<128, false>()(vmv.assumeHandlerGetPAddr(addr));
+}
+
+template <typename OperandType>
+static void vtlbWatchWriteSm(u32 addr, OperandType data)
+{
+	vtlb_CheckWatches(addr, sizeof(OperandType), true);
+
+	const VTLBVirtual vmv = vtlb_GetWatchedOriginal(addr);
+	if (!vmv.isHandler(addr))
+		*reinterpret_cast<OperandType*>(vmv.assumePtr(addr)) = data;
+	else
+		vmv.assumeHandler<sizeof(OperandType) * 8, true>()(vmv.assumeHandlerGetPAddr(addr), data);
+}
+
+static void TAKES_R128 vtlbWatchWriteLg(u32 addr, r128 data)
+{
+	vtlb_CheckWatches(addr, sizeof(u128), true);
+
+	const VTLBVirtual vmv = vtlb_GetWatchedOriginal(addr);
+	if (!vmv.isHandler(addr))
+		r128_store_unaligned(reinterpret_cast<void*>(vmv.assumePtr(addr)), data);
+	else
+		vmv.assumeHandler<128, true>()(vmv.assumeHandlerGetPAddr(addr), data);
+}
+
 // --------------------------------------------------------------------------------------
 //  VTLB mapping errors
 // --------------------------------------------------------------------------------------
@@ -921,6 +1043,10 @@ static void vtlb_CreateFastmemMapping(u32 vaddr, u32 mainmem_offset, const PageP
 
 	const u32 page = vaddr / VTLB_PAGE_SIZE;
 
+	// Watched pages have to go through the handler.
+	if (vtlb_FindWatchedPage(page))
+		return;
+
 	if (s_fastmem_virtual_mapping[page] == mainmem_offset)
 	{
 		// current mapping is fine
@@ -1023,6 +1149,22 @@ static void vtlb_RemoveFastmemMappings()
 	s_fastmem_physical_mapping.clear();
 }
 
+static void vtlb_CreateFastmemMappingFromVirtual(u32 vaddr)
+{
+	const VTLBVirtual& vm = vtlbdata.vmap[vaddr >> VTLB_PAGE_BITS];
+	if (vm.isHandler(vaddr))
+	{
+		// Handlers should be unmapped.
+		return;
+	}
+
+	// Check if it's a physical mapping to our main memory area.
+	u32 mainmem_offset, mainmem_size;
+	PageProtectionMode prot;
+	if (vtlb_GetMainMemoryOffsetFromPtr(vm.assumePtr(vaddr), &mainmem_offset, &mainmem_size, &prot))
+		vtlb_CreateFastmemMapping(vaddr, mainmem_offset, prot);
+}
+
 bool vtlb_ResolveFastmemMapping(uptr* addr)
 {
 	uptr uaddr = *addr;
@@ -1138,6 +1280,24 @@ bool vtlb_IsFaultingPC(u32 guest_pc)
 	return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
 }
 
+// Keeps watches in place when a watched page is remapped, the new mapping becomes the one which is forwarded to.
+static void vtlb_ReapplyWatches(u32 vaddr, u32 size)
+{
+	if (s_watched_pages.empty())
+		return;
+
+	const u32 start_page = vaddr >> VTLB_PAGE_BITS;
+	const u32 end_page = start_page + (size >> VTLB_PAGE_BITS);
+	auto it = std::lower_bound(s_watched_pages.begin(), s_watched_pages.end(), start_page,
+		[](const WatchedPage& wp, u32 value) { return wp.page < value; });
+	for (; it != s_watched_pages.end() && it->page < end_page; ++it)
+	{
+		const u32 page_addr = it->page << VTLB_PAGE_BITS;
+		it->original = vtlbdata.vmap[it->page];
+		vtlbdata.vmap[it->page] = VTLBVirtual(VTLBPhysical::fromHandler(WatchHandler), page_addr, page_addr);
+	}
+}
+
 //virtual mappings
 //TODO: Add invalid paddr checks
 void vtlb_VMap(u32 vaddr, u32 paddr, u32 size)
@@ -1163,6 +1323,8 @@ void vtlb_VMap(u32 vaddr, u32 paddr, u32 size)
 		}
 	}
 
+	const u32 map_vaddr = vaddr;
+	const u32 map_size = size;
 	while (size > 0)
 	{
 		VTLBVirtual vmv;
@@ -1182,6 +1344,8 @@ void vtlb_VMap(u32 vaddr, u32 paddr, u32 size)
 		paddr += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
 	}
+
+	vtlb_ReapplyWatches(map_vaddr, map_size);
 }
 
 void vtlb_VMapBuffer(u32 vaddr, void* buffer, u32 size)
@@ -1205,6 +1369,8 @@ void vtlb_VMapBuffer(u32 vaddr, void* buffer, u32 size)
 		}
 	}
 
+	const u32 map_vaddr = vaddr;
+	const u32 map_size = size;
 	uptr bu8 = (uptr)buffer;
 	while (size > 0)
 	{
@@ -1213,6 +1379,8 @@ void vtlb_VMapBuffer(u32 vaddr, void* buffer, u32 size)
 		bu8 += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
 	}
+
+	vtlb_ReapplyWatches(map_vaddr, map_size);
 }
 
 void vtlb_VMapUnmap(u32 vaddr, u32 size)
@@ -1222,12 +1390,16 @@ void vtlb_VMapUnmap(u32 vaddr, u32 size)
 
 	vtlb_RemoveFastmemMappings(vaddr, size);
 
+	const u32 map_vaddr = vaddr;
+	const u32 map_size = size;
 	while (size > 0)
 	{
 		vtlbdata.vmap[vaddr >> VTLB_PAGE_BITS] = VTLBVirtual(VTLBPhysical::fromHandler(UnmappedVirtHandler), vaddr, vaddr);
 		vaddr += VTLB_PAGE_SIZE;
 		size -= VTLB_PAGE_SIZE;
 	}
+
+	vtlb_ReapplyWatches(map_vaddr, map_size);
 }
 
 // vtlb_Init -- Clears vtlb handlers and memory mappings.
@@ -1251,6 +1423,7 @@ void vtlb_Init()
 	UnmappedVirtHandler = vtlb_RegisterHandler(VTLB_BuildUnmappedHandler(vtlbUnmappedV));
 	UnmappedPhyHandler = vtlb_RegisterHandler(VTLB_BuildUnmappedHandler(vtlbUnmappedP));
 	DefaultPhyHandler = vtlb_RegisterHandler(0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	WatchHandler = vtlb_RegisterHandler(VTLB_BuildUnmappedHandler(vtlbWatch));
 
 	//done !
 
@@ -1278,6 +1451,7 @@ void vtlb_Reset()
 
 void vtlb_Shutdown()
 {
+	vtlb_ClearWatches();
 	vtlb_RemoveFastmemMappings();
 	s_fastmem_backpatch_info.clear();
 	s_fastmem_faulting_pcs.clear();
@@ -1296,23 +1470,70 @@ void vtlb_ResetFastmem()
 
 	// we need to go through and look at the vtlb pointers, to remap the host area
 	for (size_t i = 0; i < VTLB_VMAP_ITEMS; i++)
+		vtlb_CreateFastmemMappingFromVirtual(static_cast<u32>(i) << VTLB_PAGE_BITS);
+}
+
+void vtlb_SetWatches(std::vector<vtlb_WatchRange> ranges, vtlb_WatchCallback callback)
+{
+	vtlb_ClearWatches();
+	if (!vtlbdata.vmap)
+		return;
+
+	s_watch_ranges = std::move(ranges);
+	s_watch_callback = callback;
+
+	// Every alias of a range has to be watched, e.g. the cached and uncached views of RAM.
+	for (u32 page = 0; page < VTLB_VMAP_ITEMS; page++)
 	{
-		const VTLBVirtual& vm = vtlbdata.vmap[i];
-		const u32 vaddr = static_cast<u32>(i) << VTLB_PAGE_BITS;
-		if (vm.isHandler(vaddr))
-		{
-			// Handlers should be unmapped.
-			continue;
-		}
+		const u32 start = standardizeBreakpointAddress(page << VTLB_PAGE_BITS);
+		const u64 end = static_cast<u64>(start) + VTLB_PAGE_SIZE;
+		const bool watched = std::any_of(s_watch_ranges.begin(), s_watch_ranges.end(), [start, end](const vtlb_WatchRange& range) {
+			return (range.read || range.write) && start < range.end && range.start < end;
+		});
+		if (watched)
+			s_watched_pages.push_back({page, vtlbdata.vmap[page]});
+	}
+
+	for (const WatchedPage& wp : s_watched_pages)
+	{
+		const u32 page_addr = wp.page << VTLB_PAGE_BITS;
+		vtlbdata.vmap[wp.page] = VTLBVirtual(VTLBPhysical::fromHandler(WatchHandler), page_addr, page_addr);
+		if (!s_fastmem_virtual_mapping.empty())
+			vtlb_RemoveFastmemMapping(page_addr);
+	}
+
+	DevCon.WriteLn("(VTLB) Watching %zu pages for %zu memory ranges", s_watched_pages.size(), s_watch_ranges.size());
+}
+
+void vtlb_ClearWatches()
+{
+	std::vector<WatchedPage> pages = std::move(s_watched_pages);
+	s_watched_pages.clear();
+	s_watch_ranges.clear();
+	s_watch_callback = nullptr;
+	vtlb_watch_pc = 0;
 
-		// Check if it's a physical mapping to our main memory area.
-		u32 mainmem_offset, mainmem_size;
-		PageProtectionMode prot;
-		if (vtlb_GetMainMemoryOffsetFromPtr(vm.assumePtr(vaddr), &mainmem_offset, &mainmem_size, &prot))
-			vtlb_CreateFastmemMapping(vaddr, mainmem_offset, prot);
+	if (!vtlbdata.vmap)
+		return;
+
+	for (const WatchedPage& wp : pages)
+	{
+		vtlbdata.vmap[wp.page] = wp.original;
+		if (CHECK_FASTMEM && CHECK_EEREC && !s_fastmem_virtual_mapping.empty())
+			vtlb_CreateFastmemMappingFromVirtual(wp.page << VTLB_PAGE_BITS);
 	}
 }
 
+bool vtlb_HasWatches()
+{
+	return !s_watched_pages.empty();
+}
+
+bool vtlb_IsWatchedPage(u32 vaddr)
+{
+	return (vtlb_FindWatchedPage(vaddr >> VTLB_PAGE_BITS) != nullptr);
+}
+
 // Reserves the vtlb core allocation used by various emulation components!
 // [TODO] basemem - request allocating memory at the specified virtual location, which can allow
 //    for easier debugging and/or 3rd party cheat programs.  If 0, the operating system
@@ -1370,6 +1591,8 @@ void vtlb_Core_Free()
 {
 	vtlbdata.vmap = nullptr;
 	vtlbdata.ppmap = nullptr;
+	decltype(s_watched_pages)().swap(s_watched_pages);
+	s_watch_ranges.clear();
 
 	vtlb_RemoveFastmemMappings();
 	vtlb_ClearLoadStoreInfo();
@@ -8,6 +8,8 @@
 #include "common/HostSys.h"
 #include "common/SingleRegisterTypes.h"
 
+#include <vector>
+
 static const uptr VTLB_AllocUpperBounds = _1gb * 2;
 
 // Specialized function pointers for each read type
@@ -81,6 +83,29 @@ extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc
 extern void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern bool vtlb_IsFaultingPC(u32 guest_pc);
 
+// Memory watchpoints. Pages overlapping a range are remapped to a handler which checks the access,
+// then forwards it to the original mapping, so accesses to any other page run at full speed.
+// Ranges are in standardizeBreakpointAddress() form, with an exclusive end.
+struct vtlb_WatchRange
+{
+	u32 start;
+	u32 end;
+	bool read;
+	bool write;
+};
+
+// Called before an access which overlaps any of the ranges, pc is the recompiler pc of the access.
+using vtlb_WatchCallback = void (*)(u32 pc, u32 addr, u32 size, bool write);
+
+extern void vtlb_SetWatches(std::vector<vtlb_WatchRange> ranges, vtlb_WatchCallback callback);
+extern void vtlb_ClearWatches();
+extern bool vtlb_HasWatches();
+extern bool vtlb_IsWatchedPage(u32 vaddr);
+
+// Set by recompiled code around handler calls and around memory instructions, accesses without a
+// pc (e.g. from DMA or HLE code) are forwarded without being checked.
+extern u32 vtlb_watch_pc;
+
 //Memory functions
 
 template< typename DataType >
@@ -103,6 +128,8 @@ extern bool vtlb_ramWrite(u32 mem, const DataType& value);
 extern int vtlb_memSafeCmpBytes(u32 mem, const void* src, u32 size);
 extern bool vtlb_memSafeReadBytes(u32 mem, void* dst, u32 size);
 extern bool vtlb_memSafeWriteBytes(u32 mem, const void* src, u32 size);
+// Returns the start of the RAM page containing mem, or null if it is mapped to a handler.
+extern const u8* vtlb_memSafePagePtr(u32 mem);
 
 using vtlb_ReadRegAllocCallback = int(*)();
 extern int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_ReadRegAllocCallback dest_reg_alloc = nullptr);
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "x86/BlockProfile.h"
+#include "Config.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+	struct ProfileHeader
+	{
+		u32 signature;
+		u32 version;
+		u32 crc;
+		u32 num_entries;
+	};
+
+	static constexpr u32 PROFILE_SIGNATURE = 0x46505242; // BRPF
+	static constexpr u32 PROFILE_VERSION = 2;
+} // namespace
+
+RecBlockProfile::RecBlockProfile(const char* name)
+	: m_name(name)
+{
+}
+
+RecBlockProfile::~RecBlockProfile() = default;
+
+u64 RecBlockProfile::HashCode(const u8* ptr, u32 size)
+{
+	return XXH3_64bits(ptr, size * sizeof(u32));
+}
+
+bool RecBlockProfile::Matches(const Entry& entry, const u8* ram, u32 ram_size)
+{
+	if (entry.size == 0 || entry.startpc >= ram_size || (ram_size - entry.startpc) / 4 < entry.size)
+		return false;
+
+	return (HashCode(ram + entry.startpc, entry.size) == entry.hash);
+}
+
+u64* RecBlockProfile::AllocateCounter(u32 startpc)
+{
+	if (m_num_counters == MAX_COUNTERS)
+		return nullptr;
+
+	const u32 index = m_num_counters++;
+	m_counters[index] = 0;
+	m_counter_pcs[index] = startpc;
+	return &m_counters[index];
+}
+
+void RecBlockProfile::ResetCounters()
+{
+	m_num_counters = 0;
+}
+
+void RecBlockProfile::Capture(BaseBlocks& blocks, const u8* ram, u32 ram_size)
+{
+	if (m_crc == 0 || m_num_counters == 0)
+		return;
+
+	// A block which was cleared and recompiled has more than one counter.
+	std::unordered_map<u32, u64> counts;
+	counts.reserve(m_num_counters);
+	for (u32 i = 0; i < m_num_counters; i++)
+	{
+		if (m_counters[i] != 0)
+			counts[m_counter_pcs[i]] += std::exchange(m_counters[i], 0);
+	}
+
+	std::unordered_map<u32, Entry> entries;
+	entries.reserve(m_entries.size() + counts.size());
+	for (const Entry& entry : m_entries)
+		entries.emplace(entry.startpc, entry);
+
+	bool changed = false;
+	for (int i = 0; const BASEBLOCKEX* block = blocks[i]; i++)
+	{
+		if (block->size == 0 || block->startpc >= ram_size || (ram_size - block->startpc) / 4 < block->size)
+			continue;
+
+		const auto count_it = counts.find(block->startpc);
+		if (count_it == counts.end())
+			continue;
+
+		// Counts only carry over if the code hasn't changed since it was recorded.
+		Entry entry = {block->startpc, block->size, HashCode(ram + block->startpc, block->size), count_it->second};
+		const auto it = entries.find(entry.startpc);
+		if (it != entries.end())
+		{
+			if (it->second.size == entry.size && it->second.hash == entry.hash)
+				entry.count += it->second.count;
+			it->second = entry;
+		}
+		else
+		{
+			entries.emplace(entry.startpc, entry);
+		}
+
+		changed = true;
+	}
+
+	if (!changed)
+		return;
+
+	m_entries.clear();
+	m_entries.reserve(entries.size());
+	for (const auto& it : entries)
+		m_entries.push_back(it.second);
+
+	// Hottest first, so that prewarming and truncation both favour the blocks which matter most.
+	std::sort(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs) {
+		return (lhs.count != rhs.count) ? (lhs.count > rhs.count) : (lhs.startpc < rhs.startpc);
+	});
+	if (m_entries.size() > MAX_ENTRIES)
+		m_entries.resize(MAX_ENTRIES);
+
+	m_dirty = true;
+}
+
+void RecBlockProfile::SetGame(u32 crc)
+{
+	if (m_crc == crc)
+		return;
+
+	Save();
+
+	m_entries.clear();
+	m_crc = crc;
+	m_dirty = false;
+
+	if (m_crc != 0)
+		Load();
+}
+
+std::string RecBlockProfile::GetPath(u32 crc) const
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("{:08X}_{}.blockprofile", crc, m_name));
+}
+
+void RecBlockProfile::Load()
+{
+	const std::string path = GetPath(m_crc);
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value())
+		return;
+
+	ProfileHeader header;
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.signature != PROFILE_SIGNATURE || header.version != PROFILE_VERSION || header.crc != m_crc ||
+		header.num_entries > MAX_ENTRIES || data->size() != sizeof(header) + header.num_entries * sizeof(Entry))
+	{
+		Console.Warning("(RecBlockProfile) Ignoring invalid block profile '%s'", path.c_str());
+		return;
+	}
+
+	m_entries.resize(header.num_entries);
+	std::memcpy(m_entries.data(), data->data() + sizeof(header), header.num_entries * sizeof(Entry));
+
+	DevCon.WriteLn("(RecBlockProfile) Loaded %u %s blocks for CRC %08X", header.num_entries, m_name, m_crc);
+}
+
+void RecBlockProfile::Save()
+{
+	if (!m_dirty || m_crc == 0)
+		return;
+
+	const ProfileHeader header = {PROFILE_SIGNATURE, PROFILE_VERSION, m_crc, static_cast<u32>(m_entries.size())};
+	std::vector<u8> data(sizeof(header) + m_entries.size() * sizeof(Entry));
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), m_entries.data(), m_entries.size() * sizeof(Entry));
+
+	const std::string path = GetPath(m_crc);
+	if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+	{
+		Console.Error("(RecBlockProfile) Failed to write block profile '%s'", path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("(RecBlockProfile) Saved %zu %s blocks for CRC %08X", m_entries.size(), m_name, m_crc);
+	m_dirty = false;
+}
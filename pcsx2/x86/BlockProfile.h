@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "x86/BaseblockEx.h"
+
+#include <array>
+#include <vector>
+
+// Persistent, per-game record of the guest blocks a recompiler has executed, and how often.
+// On the next boot or state load of the same game, the recompiler can compile the hottest
+// recorded blocks whose source words are unchanged before it resumes execution, rather
+// than hitching on the first execution of each one.
+class RecBlockProfile
+{
+public:
+	struct Entry
+	{
+		u32 startpc; // Physical address of the first instruction
+		u32 size; // Size in instructions
+		u64 hash; // Hash of the source words
+		u64 count; // Number of times the block was executed
+	};
+
+	explicit RecBlockProfile(const char* name);
+	~RecBlockProfile();
+
+	__fi const std::vector<Entry>& GetEntries() const { return m_entries; }
+	__fi u32 GetCRC() const { return m_crc; }
+
+	/// Returns a counter for the block starting at startpc, which the compiled block should
+	/// increment each time it is executed. Returns nullptr if all counters are in use.
+	u64* AllocateCounter(u32 startpc);
+
+	/// Releases all counters. Must only be called when no compiled code refers to them.
+	void ResetCounters();
+
+	/// Merges the execution counts of the blocks currently known to the recompiler into the
+	/// profile, which stays sorted by count. Only blocks which lie entirely within the first
+	/// ram_size bytes of ram, and which have been executed, are recorded.
+	void Capture(BaseBlocks& blocks, const u8* ram, u32 ram_size);
+
+	/// Switches the profile to the specified game, writing out the previous profile if it changed.
+	/// A CRC of zero (BIOS, no ELF loaded) clears the profile without loading anything.
+	void SetGame(u32 crc);
+
+	/// Writes the profile to the cache directory, if it has changed since it was loaded.
+	void Save();
+
+	/// Returns true if the source words for the entry in ram still match the recorded hash.
+	static bool Matches(const Entry& entry, const u8* ram, u32 ram_size);
+
+private:
+	static constexpr u32 MAX_ENTRIES = 0x40000;
+	static constexpr u32 MAX_COUNTERS = 0x20000;
+
+	std::string GetPath(u32 crc) const;
+	void Load();
+
+	static u64 HashCode(const u8* ptr, u32 size);
+
+	const char* m_name;
+	std::vector<Entry> m_entries;
+	u32 m_crc = 0;
+	u32 m_num_counters = 0;
+	bool m_dirty = false;
+
+	// Referenced directly by compiled code, so they live alongside the (static) profile.
+	std::array<u64, MAX_COUNTERS> m_counters = {};
+	std::array<u32, MAX_COUNTERS> m_counter_pcs = {};
+};
@@ -5,6 +5,7 @@
 #include "Host.h"
 #include "R3000A.h"
 #include "BaseblockEx.h"
+#include "BlockProfile.h"
 #include "R5900OpcodeTables.h"
 #include "IopBios.h"
 #include "IopHw.h"
@@ -26,6 +27,7 @@
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
 #include "DebugTools/Breakpoints.h"
 
 //#define DUMP_BLOCKS 1
@@ -59,6 +61,9 @@ static BASEBLOCK* recROM2 = nullptr; // also here
 static BaseBlocks recBlocks;
 static u8* recPtr = nullptr;
 static u8* recPtrEnd = nullptr;
+
+static RecBlockProfile s_blockProfile("iop");
+static bool s_blockProfilePrewarmPending = false;
 u32 psxpc; // recompiler psxpc
 int psxbranch; // set for branch
 u32 g_iopCyclePenalty;
@@ -920,10 +925,36 @@ static void recReserve()
 
 #define R3000A_TEXTPTR (&psxRegs.GPR.r[33])
 
+static void recCaptureBlockProfile()
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableBlockProfile)
+		return;
+
+	s_blockProfile.Capture(recBlocks, iopMem->Main, Ps2MemSize::ExposedIopRam);
+	s_blockProfile.ResetCounters();
+	s_blockProfile.SetGame(VMManager::GetCurrentCRC());
+}
+
+void psxRecRequestBlockProfilePrewarm()
+{
+	s_blockProfilePrewarmPending = EmuConfig.Cpu.Recompiler.EnableBlockProfile;
+}
+
+void psxRecSaveBlockProfile()
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableBlockProfile)
+		return;
+
+	s_blockProfile.Capture(recBlocks, iopMem->Main, Ps2MemSize::ExposedIopRam);
+	s_blockProfile.Save();
+}
+
 void recResetIOP()
 {
 	DevCon.WriteLn("iR3000A Recompiler reset.");
 
+	recCaptureBlockProfile();
+
 	if (CHECK_EXTRAMEM != extraRam)
 	{
 		recReserveRAM();
@@ -999,6 +1030,8 @@ void recResetIOP()
 
 static void recShutdown()
 {
+	s_blockProfile.Save();
+
 	recLutReserve.deallocate();
 
 	safe_free(s_pInstCache);
@@ -1577,6 +1610,43 @@ static void PreBlockCheck(u32 blockpc)
 }
 #endif
 
+// Compiles the blocks in the profile whose source words are unchanged, hottest first, so that
+// execution doesn't have to stop to compile them the first time they're reached.
+static void iopPrewarmBlockProfile()
+{
+	s_blockProfilePrewarmPending = false;
+	if (s_blockProfile.GetEntries().empty())
+		return;
+
+	// Leave at least half of the code cache for blocks which weren't in the profile.
+	const u8* prewarm_end = SysMemory::GetIOPRec() + (recPtrEnd - SysMemory::GetIOPRec()) / 2;
+
+	Common::Timer timer;
+	u32 compiled = 0;
+	for (const RecBlockProfile::Entry& entry : s_blockProfile.GetEntries())
+	{
+		if (recPtr >= prewarm_end)
+			break;
+
+		// Skip the addresses with compile-time hooks in iopRecRecompile(), and the BIOS call vectors.
+		const u32 startpc = entry.startpc;
+		if (startpc <= 0xc0 || startpc == 0x890 || startpc == 0x1630)
+			continue;
+
+		if (PSX_GETBLOCK(startpc)->GetFnptr() != (uptr)iopJITCompile ||
+			!RecBlockProfile::Matches(entry, iopMem->Main, Ps2MemSize::ExposedIopRam))
+		{
+			continue;
+		}
+
+		iopRecRecompile(startpc);
+		compiled++;
+	}
+
+	Console.WriteLn("(IOP Block Profile) Prewarmed %u of %zu blocks in %.2f ms", compiled,
+		s_blockProfile.GetEntries().size(), timer.GetTimeMilliseconds());
+}
+
 static void iopRecRecompile(const u32 startpc)
 {
 	u32 i;
@@ -1616,6 +1686,15 @@ static void iopRecRecompile(const u32 startpc)
 		recResetIOP();
 	}
 
+	if (s_blockProfilePrewarmPending)
+	{
+		iopPrewarmBlockProfile();
+
+		// The block we were asked for may have been part of the profile.
+		if (PSX_GETBLOCK(startpc)->GetFnptr() != (uptr)iopJITCompile)
+			return;
+	}
+
 	xSetTextPtr(R3000A_TEXTPTR);
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
@@ -1651,6 +1730,12 @@ static void iopRecRecompile(const u32 startpc)
 	xFastCall((void*)PreBlockCheck, psxpc);
 #endif
 
+	if (EmuConfig.Cpu.Recompiler.EnableBlockProfile)
+	{
+		if (u64* counter = s_blockProfile.AllocateCounter(HWADDR(startpc)))
+			xADD(ptr64[counter], 1);
+	}
+
 	// go until the next branch
 	i = startpc;
 	s_nEndBlock = 0xffffffff;
@@ -115,6 +115,7 @@ void _eeMoveGPRtoR(const x86Emitter::xRegister64& to, int fromgpr, bool allow_pr
 void _eeMoveGPRtoM(uptr to, int fromgpr); // 32-bit only
 
 void _eeFlushAllDirty();
+void _eeWritebackAllDirty();
 void _eeOnWriteReg(int reg, int signext);
 
 // totally deletes from const, xmm, and mmx entries
@@ -14,6 +14,7 @@
 #include "VMManager.h"
 #include "vtlb.h"
 #include "x86/BaseblockEx.h"
+#include "x86/BlockProfile.h"
 #include "x86/iR5900.h"
 #include "x86/iR5900Analysis.h"
 
@@ -21,6 +22,7 @@
 #include "common/FastJmp.h"
 #include "common/HeapArray.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
 
 // Only for MOVQ workaround.
 #include "common/emitter/internal.h"
@@ -84,6 +86,9 @@ static BASEBLOCK* recROM2 = nullptr; // also here
 static BaseBlocks recBlocks;
 static u8* recPtr = nullptr;
 static u8* recPtrEnd = nullptr;
+
+static RecBlockProfile s_blockProfile("ee");
+static bool s_blockProfilePrewarmPending = false;
 EEINST* s_pInstCache = nullptr;
 static u32 s_nInstCacheSize = 0;
 
@@ -100,6 +105,10 @@ static EEINST* s_psaveInstInfo = nullptr;
 
 static u32 s_savenBlockCycles = 0;
 
+// EE memchecks as of the last reset, watched through the vtlb.
+static std::vector<MemCheck> s_memchecks;
+static MemCheckWatch s_memcheck_watch;
+
 static void iBranchTest(u32 newpc = 0xffffffff);
 static void ClearRecLUT(BASEBLOCK* base, int count);
 static u32 scaleblockcycles();
@@ -232,6 +241,33 @@ void _eeFlushAllDirty()
 	_flushConstRegs(false);
 }
 
+// Like _eeFlushAllDirty(), but only emits stores, leaving the allocator state and every host
+// register untouched. For code which is only run on one path, e.g. before calling a vtlb handler.
+void _eeWritebackAllDirty()
+{
+	for (u32 i = 0; i < iREGCNT_XMM; i++)
+	{
+		if (xmmregs[i].inuse && (xmmregs[i].mode & MODE_WRITE))
+			_writebackXMMreg(i);
+	}
+
+	for (u32 i = 0; i < iREGCNT_GPR; i++)
+	{
+		if (x86regs[i].inuse && x86regs[i].type != X86TYPE_TEMP && (x86regs[i].mode & MODE_WRITE))
+			_writebackX86Reg(i);
+	}
+
+	// no scratch register for the constants, rax could be holding anything
+	for (u32 i = 1; i < 32; i++)
+	{
+		if (!GPR_IS_DIRTY_CONST(i))
+			continue;
+
+		xMOV(ptr32[&cpuRegs.GPR.r[i].UL[0]], g_cpuConstRegs[i].UL[0]);
+		xMOV(ptr32[&cpuRegs.GPR.r[i].UL[1]], g_cpuConstRegs[i].UL[1]);
+	}
+}
+
 void _eeMoveGPRtoR(const xRegister32& to, int fromgpr, bool allow_preload)
 {
 	if (fromgpr == 0)
@@ -602,10 +638,40 @@ alignas(16) static u16 manual_page[Ps2MemSize::TotalRam >> 12];
 alignas(16) static u8 manual_counter[Ps2MemSize::TotalRam >> 12];
 
 ////////////////////////////////////////////////////
+static void recCaptureBlockProfile()
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableBlockProfile)
+		return;
+
+	// Record what was executed for the previous game before switching over.
+	// The code referencing the counters is about to be thrown away.
+	s_blockProfile.Capture(recBlocks, eeMem->Main, Ps2MemSize::ExposedRam);
+	s_blockProfile.ResetCounters();
+	s_blockProfile.SetGame(VMManager::GetCurrentCRC());
+}
+
+void recRequestBlockProfilePrewarm()
+{
+	s_blockProfilePrewarmPending = EmuConfig.Cpu.Recompiler.EnableBlockProfile;
+}
+
+void recSaveBlockProfile()
+{
+	if (!EmuConfig.Cpu.Recompiler.EnableBlockProfile)
+		return;
+
+	s_blockProfile.Capture(recBlocks, eeMem->Main, Ps2MemSize::ExposedRam);
+	s_blockProfile.Save();
+}
+
+static void recUpdateMemchecks();
+
 static void recResetRaw()
 {
 	Console.WriteLn(Color_StrongBlack, "EE/iR5900 Recompiler Reset");
 
+	recCaptureBlockProfile();
+
 	if (CHECK_EXTRAMEM != extraRam)
 	{
 		recReserveRAM();
@@ -635,6 +701,7 @@ static void recResetRaw()
 
 	recBlocks.Reset();
 	vtlb_ClearLoadStoreInfo();
+	recUpdateMemchecks();
 
 	g_branch = 0;
 	g_resetEeScalingStats = true;
@@ -645,6 +712,8 @@ static void recResetRaw()
 
 void recShutdown()
 {
+	s_blockProfile.Save();
+
 	recRAMCopy.deallocate();
 	recLutReserve_RAM.deallocate();
 
@@ -1523,30 +1592,27 @@ void dynarecCheckBreakpoint()
 	recExitExecution();
 }
 
-void dynarecMemcheck(size_t i)
+bool encodeBreakpoint()
 {
-	const u32 op = memRead32(cpuRegs.pc);
-	const OPCODE& opcode = GetInstruction(op);
-	if (CBreakPoints::CheckSkipFirst(BREAKPOINT_EE, pc) != 0)
-	{
-		CBreakPoints::ClearSkipFirst(BREAKPOINT_EE);
-		return;
-	}
-
-	auto mc = CBreakPoints::GetMemChecks(BREAKPOINT_EE)[i];
-
-	if (mc.hasCond)
+	if (isBreakpointNeeded(pc) != 0)
 	{
-		if (!mc.cond.Evaluate())
-			return;
+		iFlushCall(FLUSH_EVERYTHING | FLUSH_PC);
+		xFastCall((void*)dynarecCheckBreakpoint);
+		return true;
 	}
+	return false;
+}
 
-	if (mc.result & MEMCHECK_LOG)
+// Called by the vtlb before an access which overlaps a memcheck. The recompiler pc of the access is
+// past it, or the delay slot itself, so execution resumes at the instruction before: the access, or
+// its branch. Guest state was written back before the handler call, so the block can be left here.
+static void recMemcheckWatchHit(u32 access_pc, u32 addr, u32 size, bool write)
+{
+	const u32 block_pc = std::exchange(cpuRegs.pc, access_pc - 4);
+	if (!s_memcheck_watch.Check(s_memchecks, addr, size, write))
 	{
-		if (opcode.flags & IS_STORE)
-			DevCon.WriteLn("Hit store breakpoint @0x%x", cpuRegs.pc);
-		else
-			DevCon.WriteLn("Hit load breakpoint @0x%x", cpuRegs.pc);
+		cpuRegs.pc = block_pc;
+		return;
 	}
 
 	CBreakPoints::SetBreakpointTriggered(true, BREAKPOINT_EE);
@@ -1554,97 +1620,26 @@ void dynarecMemcheck(size_t i)
 	recExitExecution();
 }
 
-void recMemcheck(u32 op, u32 bits, bool store)
+static void recUpdateMemchecks()
 {
-	iFlushCall(FLUSH_EVERYTHING | FLUSH_PC);
+	s_memchecks = CBreakPoints::GetMemChecks(BREAKPOINT_EE);
 
-	// compute accessed address
-	_eeMoveGPRtoR(ecx, (op >> 21) & 0x1F);
-	if (static_cast<s16>(op) != 0)
-		xADD(ecx, static_cast<s16>(op));
-	if (bits == 128)
-		xAND(ecx, ~0x0F);
-
-	xFastCall((void*)standardizeBreakpointAddress, ecx);
-	xMOV(ecx, eax);
-	xMOV(edx, eax);
-	xADD(edx, bits / 8);
-
-	// ecx = access address
-	// edx = access address+size
-
-	auto checks = CBreakPoints::GetMemChecks(BREAKPOINT_EE);
-	for (size_t i = 0; i < checks.size(); i++)
+	if (s_memchecks.empty())
 	{
-		if (checks[i].result == 0)
-			continue;
-		if ((checks[i].memCond & MEMCHECK_WRITE) == 0 && store)
-			continue;
-		if ((checks[i].memCond & MEMCHECK_READ) == 0 && !store)
-			continue;
-
-		// logic: memAddress < bpEnd && bpStart < memAddress+memSize
-
-		xMOV(eax, standardizeBreakpointAddress(checks[i].end));
-		xCMP(ecx, eax); // address < end
-		xForwardJGE8 next1; // if address >= end then goto next1
-
-		xMOV(eax, standardizeBreakpointAddress(checks[i].start));
-		xCMP(eax, edx); // start < address+size
-		xForwardJGE8 next2; // if start >= address+size then goto next2
-
-		// hit the breakpoint
-		if (checks[i].result & MEMCHECK_BREAK)
-		{
-			xMOV(eax, i);
-			xFastCall((void*)dynarecMemcheck, eax);
-		}
-
-		next1.SetTarget();
-		next2.SetTarget();
+		vtlb_ClearWatches();
+		return;
 	}
-}
 
-bool encodeBreakpoint()
-{
-	if (isBreakpointNeeded(pc) != 0)
+	std::vector<vtlb_WatchRange> ranges;
+	ranges.reserve(s_memchecks.size());
+	for (const MemCheck& mc : s_memchecks)
 	{
-		iFlushCall(FLUSH_EVERYTHING | FLUSH_PC);
-		xFastCall((void*)dynarecCheckBreakpoint);
-		return true;
+		const bool active = (mc.result != 0);
+		ranges.push_back({standardizeBreakpointAddress(mc.start), standardizeBreakpointAddress(mc.end),
+			active && (mc.memCond & MEMCHECK_READ) != 0, active && (mc.memCond & MEMCHECK_WRITE) != 0});
 	}
-	return false;
-}
 
-bool encodeMemcheck()
-{
-	const int needed = isMemcheckNeeded(pc);
-	if (needed == 0)
-		return false;
-
-	const u32 op = memRead32(needed == 2 ? pc + 4 : pc);
-	const OPCODE& opcode = GetInstruction(op);
-
-	const bool store = (opcode.flags & IS_STORE) != 0;
-	switch (opcode.flags & MEMTYPE_MASK)
-	{
-		case MEMTYPE_BYTE:
-			recMemcheck(op, 8, store);
-			break;
-		case MEMTYPE_HALF:
-			recMemcheck(op, 16, store);
-			break;
-		case MEMTYPE_WORD:
-			recMemcheck(op, 32, store);
-			break;
-		case MEMTYPE_DWORD:
-			recMemcheck(op, 64, store);
-			break;
-		case MEMTYPE_QWORD:
-			recMemcheck(op, 128, store);
-			break;
-	}
-	return true;
+	vtlb_SetWatches(std::move(ranges), recMemcheckWatchHit);
 }
 
 void recompileNextInstruction(bool delayslot, bool swapped_delay_slot)
@@ -1655,7 +1650,7 @@ void recompileNextInstruction(bool delayslot, bool swapped_delay_slot)
 	// add breakpoint
 	if (!delayslot)
 	{
-		if(encodeBreakpoint() || encodeMemcheck())
+		if (encodeBreakpoint())
 			xFastCall((void*)CBreakPoints::CommitClearSkipFirst, BREAKPOINT_EE);
 	}
 	else
@@ -1812,7 +1807,15 @@ void recompileNextInstruction(bool delayslot, bool swapped_delay_slot)
 	{
 		//If the COP0 DIE bit is disabled, cycles should be doubled.
 		s_nBlockCycles += opcode.cycles * (2 - ((cpuRegs.CP0.n.Config >> 18) & 0x1));
+
+		// Memory instructions which fall back to the interpreter reach the vtlb from C++, and so
+		// never set the watch pc themselves. Set it around the whole instruction so they're checked too.
+		const bool watch_pc = (opcode.flags & IS_MEMORY) && vtlb_HasWatches();
+		if (watch_pc)
+			xMOV(ptr32[&vtlb_watch_pc], pc);
 		opcode.recompile();
+		if (watch_pc)
+			xMOV(ptr32[&vtlb_watch_pc], 0);
 	}
 
 	if (!swapped_delay_slot)
@@ -2156,6 +2159,49 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	return true;
 }
 
+// Compiles the blocks in the profile whose source words are unchanged, hottest first, so that
+// execution doesn't have to stop to compile them the first time they're reached.
+static void recPrewarmBlockProfile()
+{
+	s_blockProfilePrewarmPending = false;
+
+	// Compile-time hooks with side effects must only run when the block is actually reached.
+	if (EmuConfig.Gamefixes.GoemonTlbHack || s_blockProfile.GetEntries().empty())
+		return;
+
+	// Leave at least half of the code cache for blocks which weren't in the profile.
+	const u8* prewarm_end = SysMemory::GetEERec() + (recPtrEnd - SysMemory::GetEERec()) / 2;
+	const u32 entry_point = VMManager::Internal::GetCurrentELFEntryPoint();
+
+	Common::Timer timer;
+	u32 compiled = 0;
+	for (const RecBlockProfile::Entry& entry : s_blockProfile.GetEntries())
+	{
+		if (recPtr >= prewarm_end)
+			break;
+
+		const u32 startpc = entry.startpc;
+		if (startpc == 0 || startpc == entry_point || startpc == EELOAD_START ||
+			(g_eeloadMain && startpc == HWADDR(g_eeloadMain)) || (g_eeloadExec && startpc == HWADDR(g_eeloadExec)))
+		{
+			continue;
+		}
+
+		// Only identity-mapped pages can be compiled ahead of time, since we don't know the virtual address.
+		if (HWADDR(startpc) != startpc || PC_GETBLOCK(startpc)->GetFnptr() != (uptr)JITCompile ||
+			!RecBlockProfile::Matches(entry, eeMem->Main, Ps2MemSize::ExposedRam))
+		{
+			continue;
+		}
+
+		recRecompile(startpc);
+		compiled++;
+	}
+
+	Console.WriteLn("(EE Block Profile) Prewarmed %u of %zu blocks in %.2f ms", compiled,
+		s_blockProfile.GetEntries().size(), timer.GetTimeMilliseconds());
+}
+
 static void recRecompile(const u32 startpc)
 {
 	u32 i = 0;
@@ -2176,6 +2222,15 @@ static void recRecompile(const u32 startpc)
 		recResetRaw();
 	}
 
+	if (s_blockProfilePrewarmPending)
+	{
+		recPrewarmBlockProfile();
+
+		// The block we were asked for may have been part of the profile.
+		if (PC_GETBLOCK(startpc)->GetFnptr() != (uptr)JITCompile)
+			return;
+	}
+
 	xSetTextPtr(R5900_TEXTPTR);
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
@@ -2238,6 +2293,12 @@ static void recRecompile(const u32 startpc)
 	xFastCall((void*)PreBlockCheck, pc);
 #endif
 
+	if (EmuConfig.Cpu.Recompiler.EnableBlockProfile)
+	{
+		if (u64* counter = s_blockProfile.AllocateCounter(HWADDR(startpc)))
+			xADD(ptr64[counter], 1);
+	}
+
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
 	{
 		if (pc == 0x33ad48 || pc == 0x35060c)
@@ -2279,10 +2340,8 @@ static void recRecompile(const u32 startpc)
 	s32 timeout_reg = -1;
 	bool is_timeout_loop = true;
 
-	// compile breakpoints as individual blocks
-	const int n1 = isBreakpointNeeded(i);
-	const int n2 = isMemcheckNeeded(i);
-	const int n = std::max<int>(n1, n2);
+	// compile breakpoints as individual blocks, memchecks are checked by the vtlb on the pages they watch
+	const int n = isBreakpointNeeded(i);
 	if (n != 0)
 	{
 		s_nEndBlock = i + n * 4;
@@ -2294,7 +2353,7 @@ static void recRecompile(const u32 startpc)
 		BASEBLOCK* pblock = PC_GETBLOCK(i);
 
 		// stop before breakpoints
-		if (isBreakpointNeeded(i) != 0 || isMemcheckNeeded(i) != 0)
+		if (isBreakpointNeeded(i) != 0)
 		{
 			s_nEndBlock = i;
 			break;
@@ -429,7 +429,7 @@ void recSWL()
 
 	// If we're not using fastmem, we need to flush early. Because the first read
 	// (which would flush) happens inside a branch.
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 		iFlushCall(FLUSH_FULLVTLB);
 
 	xForwardJE8 skip;
@@ -504,7 +504,7 @@ void recSWR()
 
 	// If we're not using fastmem, we need to flush early. Because the first read
 	// (which would flush) happens inside a branch.
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 		iFlushCall(FLUSH_FULLVTLB);
 
 	xForwardJE8 skip;
@@ -840,7 +840,7 @@ void recSDL()
 
 		// If we're not using fastmem, we need to flush early. Because the first read
 		// (which would flush) happens inside a branch.
-		if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+		if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 			iFlushCall(FLUSH_FULLVTLB);
 
 		xForwardJE8 skip;
@@ -926,7 +926,7 @@ void recSDR()
 
 		// If we're not using fastmem, we need to flush early. Because the first read
 		// (which would flush) happens inside a branch.
-		if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+		if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 			iFlushCall(FLUSH_FULLVTLB);
 
 		xForwardJE8 skip;
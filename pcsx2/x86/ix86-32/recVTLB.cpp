@@ -239,13 +239,29 @@ static u8* GetIndirectDispatcherPtr(int mode, int operandsize, int sign = 0)
 								  (operandsize * INDIRECT_DISPATCHER_SIZE)];
 }
 
+// ------------------------------------------------------------------------
+// Tells the watchpoint handler which instruction is making the access, only emitted
+// while there are watched pages, since no other handler needs it. Guest state is
+// written back too, so the handler can evaluate conditions and leave the block.
+//
+static void DynGen_SetWatchPC(u32 guest_pc)
+{
+	_eeWritebackAllDirty();
+	xMOV(ptr32[&vtlb_watch_pc], guest_pc);
+}
+
+static void DynGen_ClearWatchPC()
+{
+	xMOV(ptr32[&vtlb_watch_pc], 0);
+}
+
 // ------------------------------------------------------------------------
 // Generates a JS instruction that targets the appropriate templated instance of
 // the vtlb Indirect Dispatcher.
 //
 
 template <typename GenDirectFn>
-static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits, bool sign = false)
+static void DynGen_HandlerTest(const GenDirectFn& gen_direct, u32 guest_pc, int mode, int bits, bool sign = false)
 {
 	int szidx = 0;
 	switch (bits)
@@ -261,7 +277,12 @@ static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits
 	gen_direct();
 	xForwardJump8 done;
 	to_handler.SetTarget();
+	const bool watched = vtlb_HasWatches();
+	if (watched)
+		DynGen_SetWatchPC(guest_pc);
 	xFastCall(GetIndirectDispatcherPtr(mode, szidx, sign));
+	if (watched)
+		DynGen_ClearWatchPC();
 	done.SetTarget();
 }
 
@@ -368,12 +389,12 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 	pxAssume(bits <= 64);
 
 	int x86_dest_reg;
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
 		DynGen_PrepRegs(addr_reg, -1, bits, xmm);
-		DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign && bits < 64);
+		DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, pc, 0, bits, sign && bits < 64);
 
 		if (!xmm)
 		{
@@ -498,7 +519,7 @@ int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const,
 		}
 
 		// Shortcut for the INTC_STAT register, which many games like to spin on heavily.
-		if ((bits == 32) && !EmuConfig.Speedhacks.IntcStat && (paddr == INTC_STAT))
+		if ((bits == 32) && !EmuConfig.Speedhacks.IntcStat && (paddr == INTC_STAT) && !vtlb_IsWatchedPage(addr_const))
 		{
 			x86_dest_reg = dest_reg_alloc ? dest_reg_alloc() : (_freeX86reg(eax), eax.GetId());
 			if (!xmm)
@@ -516,7 +537,12 @@ int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const,
 		else
 		{
 			iFlushCall(FLUSH_FULLVTLB);
+			const bool watched = vtlb_IsWatchedPage(addr_const);
+			if (watched)
+				DynGen_SetWatchPC(pc);
 			xFastCall(vmv.assumeHandlerGetRaw(szidx, false), paddr);
+			if (watched)
+				DynGen_ClearWatchPC();
 
 			if (!xmm)
 			{
@@ -556,12 +582,12 @@ int vtlb_DynGenReadQuad(u32 bits, int addr_reg, vtlb_ReadRegAllocCallback dest_r
 {
 	pxAssume(bits == 128);
 
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
 		DynGen_PrepRegs(arg1regd.GetId(), -1, bits, true);
-		DynGen_HandlerTest([bits]() {DynGen_DirectRead(bits, false); },  0, bits);
+		DynGen_HandlerTest([bits]() {DynGen_DirectRead(bits, false); }, pc, 0, bits);
 
 		const int reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0); // Handler returns in xmm0
 		if (reg >= 0)
@@ -613,7 +639,12 @@ int vtlb_DynGenReadQuad_Const(u32 bits, u32 addr_const, vtlb_ReadRegAllocCallbac
 
 		const int szidx = 4;
 		iFlushCall(FLUSH_FULLVTLB);
+		const bool watched = vtlb_IsWatchedPage(addr_const);
+		if (watched)
+			DynGen_SetWatchPC(pc);
 		xFastCall(vmv.assumeHandlerGetRaw(szidx, 0), paddr);
+		if (watched)
+			DynGen_ClearWatchPC();
 
 		reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
 		xMOVAPS(xRegisterSSE(reg), xmm0);
@@ -681,12 +712,12 @@ void vtlb_DynGenWrite(u32 sz, bool xmm, int addr_reg, int value_reg)
 	}
 #endif
 
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc) || vtlb_HasWatches())
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
 		DynGen_PrepRegs(addr_reg, value_reg, sz, xmm);
-		DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, 1, sz);
+		DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, pc, 1, sz);
 		return;
 	}
 
@@ -893,7 +924,12 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 			xMOV(arg2reg, xRegister64(value_reg));
 		}
 
+		const bool watched = vtlb_IsWatchedPage(addr_const);
+		if (watched)
+			DynGen_SetWatchPC(pc);
 		xFastCall(vmv.assumeHandlerGetRaw(szidx, true));
+		if (watched)
+			DynGen_ClearWatchPC();
 	}
 }
 
@@ -934,6 +970,9 @@ void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc,
 		address_register, data_register, size_in_bits, is_signed, is_load);
 #endif
 
+	// Code is compiled without fastmem while anything is watched, the register state isn't known here.
+	pxAssert(!vtlb_HasWatches());
+
 	u8* thunk = recBeginThunk();
 
 	// save regs
@@ -984,7 +1023,7 @@ void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc,
 	if (is_load)
 	{
 		DynGen_PrepRegs(address_register, -1, size_in_bits, is_xmm);
-		DynGen_HandlerTest([size_in_bits, is_signed]() {DynGen_DirectRead(size_in_bits, is_signed); },  0, size_in_bits, is_signed && size_in_bits <= 32);
+		DynGen_HandlerTest([size_in_bits, is_signed]() {DynGen_DirectRead(size_in_bits, is_signed); }, guest_pc, 0, size_in_bits, is_signed && size_in_bits <= 32);
 
 		if (size_in_bits == 128)
 		{
@@ -1029,7 +1068,7 @@ void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc,
 		}
 
 		DynGen_PrepRegs(address_register, data_register, size_in_bits, is_xmm);
-		DynGen_HandlerTest([size_in_bits]() { DynGen_DirectWrite(size_in_bits); }, 1, size_in_bits);
+		DynGen_HandlerTest([size_in_bits]() { DynGen_DirectWrite(size_in_bits); }, guest_pc, 1, size_in_bits);
 	}
 
 	// restore regs
@@ -54,12 +54,17 @@ void mVUreset(microVU& mVU, bool resetReserve)
 	memset(&mVU.prog.lpState, 0, sizeof(mVU.prog.lpState));
 	mVU.profiler.Reset(mVU.index);
 
+	if (mVU.prog.total > 0)
+		mVUprintStats(mVU);
+
 	// Program Variables
+	mVU.prog.microPrefixDirty = 0;
 	mVU.prog.cleared  =  1;
 	mVU.prog.isSame   = -1;
 	mVU.prog.cur      = NULL;
 	mVU.prog.total    =  0;
 	mVU.prog.curFrame =  0;
+	mVU.prog.region   =  0;
 
 	// Setup Dynarec Cache Limits for Each Program
 	mVU.prog.x86start = xGetAlignedCallTarget();
@@ -80,6 +85,10 @@ void mVUreset(microVU& mVU, bool resetReserve)
 		mVU.prog.quick[i].block = NULL;
 		mVU.prog.quick[i].prog = NULL;
 	}
+
+	if (!mVU.prog.retired)
+		mVU.prog.retired = new std::deque<microProgram*>();
+	mVUfreeRetired(mVU);
 }
 
 // Free Allocated Resources
@@ -96,11 +105,19 @@ void mVUclose(microVU& mVU)
 		}
 		safe_delete(mVU.prog.prog[i]);
 	}
+
+	if (mVU.prog.retired)
+	{
+		mVUfreeRetired(mVU);
+		safe_delete(mVU.prog.retired);
+	}
 }
 
 // Clears Block Data in specified range
 __fi void mVUclear(mV, u32 addr, u32 size)
 {
+	mVU.prog.microPrefixDirty = std::min(mVU.prog.microPrefixDirty, (addr / 4) & mVU.progMemMask);
+
 	if (!mVU.prog.cleared)
 	{
 		mVU.prog.cleared = 1; // Next execution searches/creates a new microprogram
@@ -134,6 +151,7 @@ __ri microProgram* mVUcreateProg(microVU& mVU, int startPC)
 	microProgram* prog = (microProgram*)_aligned_malloc(sizeof(microProgram), 64);
 	memset(prog, 0, sizeof(microProgram));
 	prog->idx = mVU.prog.total++;
+	prog->serial = ++mVU.prog.serial;
 	prog->ranges = new std::deque<microRange>();
 	prog->startPC = startPC;
 	if(doWholeProgCompare)
@@ -150,6 +168,7 @@ __ri microProgram* mVUcreateProg(microVU& mVU, int startPC)
 // Caches Micro Program
 __ri void mVUcacheProg(microVU& mVU, microProgram& prog)
 {
+	prog.fingerprintValid = false;
 	if (!doWholeProgCompare)
 	{
 		auto cmpOffset = [&](void* x) { return (u8*)x + mVUrange.start; };
@@ -212,9 +231,187 @@ void mVUprintUniqueRatio(microVU& mVU)
 	DevCon.WriteLn("%d / %d [%3.1f%%]", v.size(), total, 100. - (double)v.size() / (double)total * 100.);
 }
 
+// Prints program cache statistics
+void mVUprintStats(microVU& mVU)
+{
+	const microProgStats& stats = mVU.prog.stats;
+	const double cacheSize = (double)((uptr)mVU.prog.x86end - (uptr)mVU.prog.x86start);
+	const double cachePerc = ((double)((uptr)mVU.prog.x86ptr - (uptr)mVU.prog.x86start)) / cacheSize * 100;
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta,
+		"microVU%d: Progs = %d, Hits = %u, Misses = %u, Evictions = %u, Reclaims = %u, Stalls = %u (%.2f ms), Cache = %3.3f%%",
+		mVU.index, mVU.prog.total, stats.hits, stats.misses, stats.evictions, stats.reclaims, stats.stalls,
+		Common::Timer::ConvertValueToMilliseconds(stats.stallTicks), cachePerc);
+}
+
+// Moves the least recently used programs of a list out of the search path.
+// They can't be freed yet, as the program which is executing may be one of them.
+static void mVUevictProgs(microVU& mVU, microProgramList& list)
+{
+	while (list.size() > mVUmaxProgsPerPC)
+	{
+		// The front of the list is the program which was just created, keep it.
+		auto victim = list.begin() + 1;
+		for (auto it = victim + 1; it != list.end(); ++it)
+		{
+			if (it[0]->lastUsed < victim[0]->lastUsed ||
+				(it[0]->lastUsed == victim[0]->lastUsed && it[0]->useCount < victim[0]->useCount))
+			{
+				victim = it;
+			}
+		}
+
+		mVU.prog.retired->push_back(victim[0]);
+		list.erase(victim);
+		mVU.prog.stats.evictions++;
+	}
+}
+
+// Frees programs which were evicted from the search lists
+void mVUfreeRetired(microVU& mVU)
+{
+	for (auto it = mVU.prog.retired->begin(); it != mVU.prog.retired->end(); ++it)
+	{
+		mVUdeleteProg(mVU, it[0]);
+	}
+	mVU.prog.retired->clear();
+}
+
+// Frees every program with code in the given rec-cache region, so that it can be reused.
+// Jump caches in other programs are validated by serial, so they can't reach the freed code.
+static void mVUreclaimRegion(microVU& mVU, u32 region)
+{
+	const u32 mask = 1u << region;
+	for (u32 i = 0; i < (mVU.progSize / 2); i++)
+	{
+		microProgramList* list = mVU.prog.prog[i];
+		for (auto it = list->begin(); it != list->end();)
+		{
+			microProgram* prog = it[0];
+			if (!(prog->regions & mask))
+			{
+				++it;
+				continue;
+			}
+
+			if (mVU.prog.quick[i].prog == prog)
+			{
+				mVU.prog.quick[i].block = NULL;
+				mVU.prog.quick[i].prog  = NULL;
+			}
+			if (mVU.prog.cur == prog)
+			{
+				mVU.prog.cur    = NULL;
+				mVU.prog.isSame = -1;
+			}
+
+			it = list->erase(it);
+			mVUdeleteProg(mVU, prog);
+			mVU.prog.stats.evictions++;
+		}
+	}
+	mVU.prog.stats.reclaims++;
+}
+
+// Called once execution has finished, when nothing can be running evicted programs any more.
+// When code has been written past the end of the current rec-cache region, moves on to the
+// next region and reclaims the one after it. The region after the current one is always
+// free, so that compilation can overrun into it (or into the safe-zone, for the last region).
+void mVUupdateCache(microVU& mVU)
+{
+	mVUfreeRetired(mVU);
+
+	if (mVU.prog.x86ptr < mVU.prog.x86start)
+	{
+		Console.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Program cache limit reached.", mVU.index);
+		mVUreset(mVU, false);
+		return;
+	}
+
+	const uptr regionSize = static_cast<uptr>(mVU.prog.x86end - mVU.prog.x86start) / mVUcacheRegions;
+	const u8* regionEnd = (mVU.prog.region == mVUcacheRegions - 1) ? mVU.prog.x86end :
+		mVU.prog.x86start + regionSize * (mVU.prog.region + 1);
+	if (mVU.prog.x86ptr < regionEnd)
+		return;
+
+	mVU.prog.region = (mVU.prog.region + 1) % mVUcacheRegions;
+	if (mVU.prog.region == 0)
+		mVU.prog.x86ptr = mVU.prog.x86start;
+
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Reclaiming program cache region %u",
+		mVU.index, (mVU.prog.region + 1) % mVUcacheRegions);
+	mVUreclaimRegion(mVU, (mVU.prog.region + 1) % mVUcacheRegions);
+}
+
+// Mixes a micro memory word with its index. Fingerprints are sums of these, so the
+// fingerprint of any range of micro memory can be taken from the running sums.
+static __fi u64 mVUfingerprintWord(u32 idx, u32 word)
+{
+	u64 v = (static_cast<u64>(idx) << 32) | word;
+	v ^= v >> 33;
+	v *= 0xff51afd7ed558ccdULL;
+	v ^= v >> 33;
+	v *= 0xc4ceb9fe1a85ec53ULL;
+	v ^= v >> 33;
+	return v;
+}
+
+// Brings the running sums up to date with the micro memory writes since the last search
+static __fi void mVUupdateMicroPrefix(microVU& mVU)
+{
+	const u32* micro = reinterpret_cast<const u32*>(mVU.regs().Micro);
+	u64* prefix = mVU.prog.microPrefix;
+	for (u32 i = mVU.prog.microPrefixDirty; i < mVU.progSize; i++)
+		prefix[i + 1] = prefix[i] + mVUfingerprintWord(i, micro[i]);
+	mVU.prog.microPrefixDirty = mVU.progSize;
+}
+
+// Returns false if the program definitely doesn't match mVU.regs().Micro,
+// without touching more than the running sums for each of its ranges.
+static bool mVUfingerprintMatches(microVU& mVU, microProgram& prog)
+{
+	const u64* prefix = mVU.prog.microPrefix;
+	if (doWholeProgCompare)
+	{
+		if (!prog.fingerprintValid)
+		{
+			prog.fingerprint = 0;
+			for (u32 i = 0; i < mVU.progSize; i++)
+				prog.fingerprint += mVUfingerprintWord(i, prog.data[i]);
+			prog.fingerprintValid = true;
+		}
+		return (prog.fingerprint == prefix[mVU.progSize]);
+	}
+
+	u64 fingerprint = 0;
+	for (const auto& range : *prog.ranges)
+	{
+		// Ranges which are still being set up can't be fingerprinted, let memcmp handle them.
+		if (range.start < 0 || range.end < range.start || range.end > static_cast<s32>(mVU.microMemSize))
+			return true;
+
+		fingerprint += prefix[range.end / 4] - prefix[range.start / 4];
+	}
+
+	if (!prog.fingerprintValid)
+	{
+		prog.fingerprint = 0;
+		for (const auto& range : *prog.ranges)
+		{
+			for (int i = range.start / 4; i < range.end / 4; i++)
+				prog.fingerprint += mVUfingerprintWord(i, prog.data[i]);
+		}
+		prog.fingerprintValid = true;
+	}
+
+	return (prog.fingerprint == fingerprint);
+}
+
 // Compare Cached microProgram to mVU.regs().Micro
 __fi bool mVUcmpProg(microVU& mVU, microProgram& prog)
 {
+	if (!mVUfingerprintMatches(mVU, prog))
+		return false;
+
 	if (doWholeProgCompare)
 	{
 		if (memcmp((u8*)prog.data, mVU.regs().Micro, mVU.microMemSize))
@@ -247,8 +444,12 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 	microProgramQuick& quick = mVU.prog.quick[mVU.regs().start_pc / 8];
 	microProgramList*  list  = mVU.prog.prog [mVU.regs().start_pc / 8];
 
+	mVU.prog.curFrame++;
+
 	if (!quick.prog) // If null, we need to search for new program
 	{
+		mVUupdateMicroPrefix(mVU);
+
 		for (auto it = list->begin(); it != list->end(); ++it)
 		{
 			bool b = mVUcmpProg(mVU, *it[0]);
@@ -257,6 +458,9 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 			{
 				quick.block = it[0]->block[startPC / 8];
 				quick.prog  = it[0];
+				quick.prog->useCount++;
+				quick.prog->lastUsed = mVU.prog.curFrame;
+				mVU.prog.stats.hits++;
 				list->erase(it);
 				list->push_front(quick.prog);
 
@@ -274,10 +478,13 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 		mVU.prog.cleared = 0;
 		mVU.prog.isSame  = 1;
 		mVU.prog.cur     = mVUcreateProg(mVU, mVU.regs().start_pc/8);
+		mVU.prog.cur->lastUsed = mVU.prog.curFrame;
+		mVU.prog.stats.misses++;
 		void* entryPoint = mVUblockFetch(mVU,  startPC, pState);
 		quick.block      = mVU.prog.cur->block[startPC/8];
 		quick.prog       = mVU.prog.cur;
 		list->push_front(mVU.prog.cur);
+		mVUevictProgs(mVU, *list);
 		//mVUprintUniqueRatio(mVU);
 		return entryPoint;
 	}
@@ -285,6 +492,7 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 	// If list.quick, then we've already found and recompiled the program ;)
 	mVU.prog.isSame = -1;
 	mVU.prog.cur = quick.prog;
+	mVU.prog.cur->lastUsed = mVU.prog.curFrame;
 	// Because the VU's can now run in sections and not whole programs at once
 	// we need to set the current block so it gets the right program back
 	quick.block = mVU.prog.cur->block[startPC / 8];
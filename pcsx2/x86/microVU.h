@@ -21,6 +21,7 @@
 #include "microVU_IR.h"
 #include "microVU_Profiler.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
 
 class microBlockManager;
 
@@ -48,8 +49,14 @@ struct microProgram
 	u32                data [mProgSize];     // Holds a copy of the VU microProgram
 	microBlockManager* block[mProgSize / 2]; // Array of Block Managers
 	std::deque<microRange>* ranges;          // The ranges of the microProgram that have already been recompiled
-	u32 startPC; // Start PC of this program
-	int idx;     // Program index
+	u32 startPC;  // Start PC of this program
+	int idx;      // Program index
+	u32 useCount; // Number of times this program was found by mVUsearchProg()
+	u32 lastUsed; // Value of microProgManager::curFrame when this program was last used
+	u32 serial;   // Unique id of this program (freed programs' addresses get reused)
+	u32 regions;  // Bitmask of the rec-cache regions holding code for this program
+	u64 fingerprint;      // Fingerprint of data[] over the compiled ranges
+	bool fingerprintValid; // Cleared when ranges or data change
 };
 
 typedef std::deque<microProgram*> microProgramList;
@@ -60,23 +67,42 @@ struct microProgramQuick
 	microProgram*      prog;  // The microProgram who is the owner of 'block'
 };
 
+struct microProgStats
+{
+	u32 hits;       // Program searches which found a cached program
+	u32 misses;     // Program searches which had to create a new program
+	u32 evictions;  // Programs dropped by the LRU limit or when their rec-cache region was reclaimed
+	u32 reclaims;   // Rec-cache regions reclaimed for new code
+	u32 stalls;     // Number of times execution had to wait for code to be compiled
+	u64 stallTicks; // Time spent waiting for compilation (Common::Timer ticks)
+	bool compiling; // Set while a stall is being timed
+};
+
 struct microProgManager
 {
 	microIR<mProgSize> IRinfo;             // IR information
 	microProgramList*  prog [mProgSize/2]; // List of microPrograms indexed by startPC values
 	microProgramQuick  quick[mProgSize/2]; // Quick reference to valid microPrograms for current execution
 	microProgram*      cur;                // Pointer to currently running MicroProgram
+	microProgramList*  retired;            // Programs evicted from the search lists, freed once execution has finished
 	int                total;              // Total Number of valid MicroPrograms
 	int                isSame;             // Current cached microProgram is Exact Same program as mVU.regs().Micro (-1 = unknown, 0 = No, 1 = Yes)
 	int                cleared;            // Micro Program is Indeterminate so must be searched for (and if no matches are found then recompile a new one)
-	u32                curFrame;           // Frame Counter
+	u32                curFrame;           // Program search counter (used as the LRU clock)
 	u8*                x86ptr;             // Pointer to program's recompilation code
 	u8*                x86start;           // Start of program's rec-cache
 	u8*                x86end;             // Limit of program's rec-cache
+	u32                region;             // Rec-cache region which new code is being written to
+	u32                serial;             // Serial of the last created program
 	microRegInfo       lpState;            // Pipeline state from where program left off (useful for continuing execution)
+	microProgStats     stats;              // Cache statistics (persist across resets)
+	u32                microPrefixDirty;   // First word of microPrefix which is out of date with micro memory
+	u64                microPrefix[mProgSize + 1]; // Running sums of micro memory word fingerprints
 };
 
 static const uint mVUcacheSafeZone =  3; // Safe-Zone for program recompilation (in megabytes)
+static const uint mVUmaxProgsPerPC = 64; // Max programs kept in the search list of a single startPC
+static const uint mVUcacheRegions  =  8; // Rec-cache is reclaimed one region at a time (each must be larger than the safe-zone)
 
 struct microVU
 {
@@ -137,6 +163,13 @@ struct microVU
 	}
 };
 
+// Returns the rec-cache region which ptr lies in (overruns into the safe-zone belong to the last region)
+__fi u32 mVUcacheRegion(const microVU& mVU, const u8* ptr)
+{
+	const uptr regionSize = static_cast<uptr>(mVU.prog.x86end - mVU.prog.x86start) / mVUcacheRegions;
+	return std::min<u32>(static_cast<u32>(static_cast<uptr>(ptr - mVU.prog.x86start) / regionSize), mVUcacheRegions - 1);
+}
+
 class microBlockManager
 {
 private:
@@ -295,6 +328,9 @@ mVUop(mVUopL);
 // Private Functions
 extern void mVUcacheProg(microVU& mVU, microProgram& prog);
 extern void mVUdeleteProg(microVU& mVU, microProgram*& prog);
+extern void mVUfreeRetired(microVU& mVU);
+extern void mVUprintStats(microVU& mVU);
+extern void mVUupdateCache(microVU& mVU);
 _mVUt extern void* mVUsearchProg(u32 startPC, uptr pState);
 extern void* mVUexecuteVU0(u32 startPC, u32 cycles);
 extern void* mVUexecuteVU1(u32 startPC, u32 cycles);
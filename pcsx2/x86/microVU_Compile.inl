@@ -36,6 +36,7 @@ __fi void mVUcheckIsSame(mV)
 void mVUsetupRange(microVU& mVU, s32 pc, bool isStartPC)
 {
 	std::deque<microRange>*& ranges = mVUcurProg.ranges;
+	mVUcurProg.fingerprintValid = false;
 	if (pc > (s64)mVU.microMemSize)
 	{
 		Console.Error("microVU%d: PC outside of VU memory PC=0x%04x", mVU.index, pc);
@@ -694,6 +695,7 @@ void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 	microFlagCycles mFC;
 	u8* thisPtr = x86Ptr;
 	const u32 endCount = (((microRegInfo*)pState)->blockType) ? 1 : (mVU.microMemSize / 8);
+	mVUcurProg.regions |= 1u << mVUcacheRegion(mVU, thisPtr);
 
 	// First Pass
 	iPC = startPC / 4;
@@ -1002,6 +1004,9 @@ void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 
 perf_and_return:
 
+	// A block can overrun into the next region, which has to be reclaimed along with this program.
+	mVUcurProg.regions |= 1u << mVUcacheRegion(mVU, x86Ptr);
+
 	if (mVU.regs().start_pc == startPC)
 	{
 		if (mVU.index)
@@ -1019,8 +1024,20 @@ __fi void* mVUentryGet(microVU& mVU, microBlockManager* block, u32 startPC, uptr
 	microBlock* pBlock = block->search(mVU, (microRegInfo*)pState);
 	if (pBlock)
 		return pBlock->x86ptrStart;
-	else
+
+	// Blocks compiled for branches while compiling are part of the same stall.
+	microProgStats& stats = mVU.prog.stats;
+	if (stats.compiling)
 		return mVUcompile(mVU, startPC, pState);
+
+	// Execution has to wait for the block to be compiled.
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+	stats.compiling = true;
+	void* entryPoint = mVUcompile(mVU, startPC, pState);
+	stats.compiling = false;
+	stats.stalls++;
+	stats.stallTicks += Common::Timer::GetCurrentValue() - start;
+	return entryPoint;
 }
 
 // Search for Existing Compiled Block (if found, return x86ptr; else, compile and return x86ptr)
@@ -1045,10 +1062,12 @@ _mVUt void* mVUcompileJIT(u32 startPC, uptr ptr)
 			microVU& mVU = mVUx;
 			microBlock* pBlock = (microBlock*)ptr;
 			microJumpCache& jc = pBlock->jumpCache[startPC / 8];
-			if (jc.prog && jc.prog == mVU.prog.quick[startPC / 8].prog)
+			microProgram* prog = mVU.prog.quick[startPC / 8].prog;
+			if (prog && jc.serial == prog->serial)
 				return jc.x86ptrStart;
 			void* v = mVUblockFetch(mVUx, startPC, (uptr)&pBlock->pStateEnd);
-			jc.prog = mVU.prog.quick[startPC / 8].prog;
+			prog = mVU.prog.quick[startPC / 8].prog;
+			jc.serial = prog ? prog->serial : 0;
 			jc.x86ptrStart = v;
 			return v;
 		}
@@ -1060,10 +1079,12 @@ _mVUt void* mVUcompileJIT(u32 startPC, uptr ptr)
 		microVU& mVU = mVUx;
 		microBlock* pBlock = (microBlock*)ptr;
 		microJumpCache& jc = pBlock->jumpCache[startPC / 8];
-		if (jc.prog && jc.prog == mVU.prog.quick[startPC / 8].prog)
+		microProgram* prog = mVU.prog.quick[startPC / 8].prog;
+		if (prog && jc.serial == prog->serial)
 			return jc.x86ptrStart;
 		void* v = mVUsearchProg<vuIndex>(startPC, (uptr)&pBlock->pStateEnd);
-		jc.prog = mVU.prog.quick[startPC / 8].prog;
+		prog = mVU.prog.quick[startPC / 8].prog;
+		jc.serial = prog ? prog->serial : 0;
 		jc.x86ptrStart = v;
 		return v;
 	}
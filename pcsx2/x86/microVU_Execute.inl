@@ -342,12 +342,7 @@ _mVUt void mVUcleanUp()
 	microVU& mVU = mVUx;
 
 	mVU.prog.x86ptr = x86Ptr;
-
-	if ((xGetPtr() < mVU.prog.x86start) || (xGetPtr() >= mVU.prog.x86end))
-	{
-		Console.WriteLn(vuIndex ? Color_Orange : Color_Magenta, "microVU%d: Program cache limit reached.", mVU.index);
-		mVUreset(mVU, false);
-	}
+	mVUupdateCache(mVU);
 
 	mVU.cycles = mVU.totalCycles - std::max(0, mVU.cycles);
 	mVU.regs().cycle += mVU.cycles;
@@ -60,12 +60,11 @@ union alignas(16) microRegInfo
 // Note: mVUcustomSearch needs to be updated if this is changed
 static_assert(sizeof(microRegInfo) == 96, "microRegInfo was not 96 bytes");
 
-struct microProgram;
 struct microJumpCache
 {
-	microJumpCache() : prog(NULL), x86ptrStart(NULL) {}
-	microProgram* prog; // Program to which the entry point below is part of
-	void* x86ptrStart;  // Start of code (Entry point for block)
+	microJumpCache() : serial(0), x86ptrStart(NULL) {}
+	u32 serial;        // Serial of the program to which the entry point below is part of (0 = none)
+	void* x86ptrStart; // Start of code (Entry point for block)
 };
 
 struct alignas(16) microBlock
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "pcsx2/DebugTools/ExpressionParser.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Registers r0-r31, with fp0-fp31 at 0x100, and a small memory.
+class TestFunctions : public IExpressionFunctions
+{
+public:
+	TestFunctions()
+	{
+		for (u32 i = 0; i < 32; i++)
+		{
+			regs[i] = static_cast<u64>(i) * 0x1234567ull;
+			const float f = static_cast<float>(i) * 1.5f;
+			std::memcpy(&fregs[i], &f, sizeof(f));
+		}
+		for (u32 i = 0; i < sizeof(memory); i++)
+			memory[i] = static_cast<u8>(i * 7);
+	}
+
+	bool parseReference(char* str, u64& referenceIndex) override
+	{
+		int index;
+		if (std::sscanf(str, "r%d", &index) == 1 && index >= 0 && index < 32)
+		{
+			referenceIndex = index;
+			return true;
+		}
+		if (std::sscanf(str, "fp%d", &index) == 1 && index >= 0 && index < 32)
+		{
+			referenceIndex = 0x100 | index;
+			return true;
+		}
+		return false;
+	}
+
+	bool parseSymbol(char* str, u64& symbolValue) override
+	{
+		if (std::strcmp(str, "data") != 0)
+			return false;
+		symbolValue = 0x40;
+		return true;
+	}
+
+	u64 getReferenceValue(u64 referenceIndex) override
+	{
+		return (referenceIndex & 0x100) ? fregs[referenceIndex & 0x1F] : regs[referenceIndex];
+	}
+
+	ExpressionType getReferenceType(u64 referenceIndex) override
+	{
+		return (referenceIndex & 0x100) ? EXPR_TYPE_FLOAT : EXPR_TYPE_UINT;
+	}
+
+	bool getMemoryValue(u32 address, int size, u64& dest, std::string& error) override
+	{
+		if ((size != 1 && size != 2 && size != 4 && size != 8) || address + size > sizeof(memory))
+		{
+			error = "Invalid memory access.";
+			return false;
+		}
+		dest = 0;
+		std::memcpy(&dest, &memory[address], size);
+		return true;
+	}
+
+	const void* getReferencePointer(u64 referenceIndex, int& size) override
+	{
+		if (referenceIndex & 0x100)
+		{
+			size = 4;
+			return &fregs[referenceIndex & 0x1F];
+		}
+		size = 8;
+		return &regs[referenceIndex];
+	}
+
+	u64 regs[32];
+	u32 fregs[32];
+	u8 memory[256];
+};
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/GS/GSLocalMemory.h"
+#include "pcsx2/GS/GSState.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	static constexpr u32 MOVE_PSMS[] = {
+		PSMCT32, PSMCT24, PSMCT16, PSMCT16S, PSMT8, PSMT4, PSMZ32, PSMZ24, PSMZ16, PSMZ16S};
+
+	static constexpr u32 WRITE_PSMS[] = {PSMCT32, PSMCT16, PSMCT16S, PSMT8, PSMT4, PSMZ32, PSMZ16, PSMZ16S};
+
+	static void FillMemory(GSLocalMemory& mem, u32 seed)
+	{
+		u32* const vm = mem.vm32();
+		for (int i = 0; i < GSLocalMemory::m_vmsize / 4; i++)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			vm[i] = seed;
+		}
+	}
+
+	static bool MemoryEquals(const GSLocalMemory& a, const GSLocalMemory& b)
+	{
+		return std::memcmp(a.m_vm8, b.m_vm8, GSLocalMemory::m_vmsize) == 0;
+	}
+
+	// A pixel at a time, the way GSState::Move() does it when it can't copy whole blocks.
+	static void MovePixels(GSLocalMemory& mem, const GIFRegBITBLTBUF& BITBLTBUF, int sx, int sy, int dx, int dy, int w, int h)
+	{
+		const GSLocalMemory::psm_t& spsm = GSLocalMemory::m_psm[BITBLTBUF.SPSM];
+		const GSLocalMemory::psm_t& dpsm = GSLocalMemory::m_psm[BITBLTBUF.DPSM];
+		for (int y = 0; y < h; y++)
+		{
+			for (int x = 0; x < w; x++)
+			{
+				const u32 c = (mem.*spsm.rp)(sx + x, sy + y, BITBLTBUF.SBP, BITBLTBUF.SBW);
+				(mem.*dpsm.wp)(dx + x, dy + y, c, BITBLTBUF.DBP, BITBLTBUF.DBW);
+			}
+		}
+	}
+
+	// A pixel at a time, for checking WriteImage against.
+	static void WritePixels(GSLocalMemory& mem, const GIFRegBITBLTBUF& BITBLTBUF, int dx, int dy, int w, int h, const u8* src)
+	{
+		const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[BITBLTBUF.DPSM];
+		for (int y = 0; y < h; y++)
+		{
+			for (int x = 0; x < w; x++)
+			{
+				const int i = y * w + x;
+				u32 c;
+				switch (psm.trbpp)
+				{
+					case 32: std::memcpy(&c, &src[i * 4], sizeof(c)); break;
+					case 16: c = src[i * 2] | (src[i * 2 + 1] << 8); break;
+					case 8: c = src[i]; break;
+					default: c = (src[i >> 1] >> ((i & 1) << 2)) & 0xf; break;
+				}
+				(mem.*psm.wp)(dx + x, dy + y, c, BITBLTBUF.DBP, BITBLTBUF.DBW);
+			}
+		}
+	}
+
+	static void WriteImage(GSLocalMemory& mem, const GIFRegBITBLTBUF& BITBLTBUF, int dx, int dy, int w, int h, const u8* src)
+	{
+		GIFRegBITBLTBUF blit = BITBLTBUF;
+		GIFRegTRXPOS TRXPOS = {};
+		TRXPOS.DSAX = dx;
+		TRXPOS.DSAY = dy;
+		GIFRegTRXREG TRXREG = {};
+		TRXREG.RRW = w;
+		TRXREG.RRH = h;
+
+		int tx = dx;
+		int ty = dy;
+		const int len = (w * h * GSLocalMemory::m_psm[BITBLTBUF.DPSM].trbpp) >> 3;
+		GSLocalMemory::m_psm[BITBLTBUF.DPSM].wi(mem, tx, ty, src, len, blit, TRXPOS, TRXREG);
+	}
+
+	static GIFRegBITBLTBUF MakeBITBLTBUF(u32 psm, u32 sbp, u32 dbp, u32 bw)
+	{
+		GIFRegBITBLTBUF BITBLTBUF = {};
+		BITBLTBUF.SBP = sbp;
+		BITBLTBUF.SBW = bw;
+		BITBLTBUF.SPSM = psm;
+		BITBLTBUF.DBP = dbp;
+		BITBLTBUF.DBW = bw;
+		BITBLTBUF.DPSM = psm;
+		return BITBLTBUF;
+	}
+
+	// Nothing gets drawn, only transfers go through it.
+	class TestGSState final : public GSState
+	{
+	public:
+		void Draw() override {}
+	};
+} // namespace
+
+TEST(GSLocalMemory, MoveBlocksMatchesPixelCopy)
+{
+	std::unique_ptr<GSLocalMemory> blocks = std::make_unique<GSLocalMemory>();
+	std::unique_ptr<GSLocalMemory> pixels = std::make_unique<GSLocalMemory>();
+
+	for (const u32 psm : MOVE_PSMS)
+	{
+		SCOPED_TRACE(psm);
+		const GSVector2i bs = GSLocalMemory::m_psm[psm].bs;
+
+		FillMemory(*blocks, psm);
+		FillMemory(*pixels, psm);
+
+		// Crosses pages in both directions.
+		const GIFRegBITBLTBUF BITBLTBUF = MakeBITBLTBUF(psm, 0, 0x2000, 10);
+		const int sx = bs.x * 3, sy = bs.y, dx = bs.x * 2, dy = bs.y * 5, w = bs.x * 9, h = bs.y * 6;
+		ASSERT_TRUE(blocks->MoveBlocks(BITBLTBUF, sx, sy, dx, dy, w, h));
+		MovePixels(*pixels, BITBLTBUF, sx, sy, dx, dy, w, h);
+		EXPECT_TRUE(MemoryEquals(*blocks, *pixels));
+
+		// Different parts of the same buffer.
+		const GIFRegBITBLTBUF same = MakeBITBLTBUF(psm, 0x1000, 0x1000, 10);
+		ASSERT_TRUE(blocks->MoveBlocks(same, 0, 0, bs.x * 16, bs.y * 8, bs.x * 4, bs.y * 4));
+		MovePixels(*pixels, same, 0, 0, bs.x * 16, bs.y * 8, bs.x * 4, bs.y * 4);
+		EXPECT_TRUE(MemoryEquals(*blocks, *pixels));
+	}
+}
+
+TEST(GSLocalMemory, MoveBlocksRejectsUnsupported)
+{
+	std::unique_ptr<GSLocalMemory> mem = std::make_unique<GSLocalMemory>();
+
+	const GIFRegBITBLTBUF BITBLTBUF = MakeBITBLTBUF(PSMCT32, 0, 0x2000, 10);
+	EXPECT_FALSE(mem->MoveBlocks(BITBLTBUF, 4, 0, 0, 0, 64, 64));
+	EXPECT_FALSE(mem->MoveBlocks(BITBLTBUF, 0, 0, 0, 4, 64, 64));
+	EXPECT_FALSE(mem->MoveBlocks(BITBLTBUF, 0, 0, 0, 0, 60, 64));
+	EXPECT_FALSE(mem->MoveBlocks(BITBLTBUF, 2040, 0, 0, 0, 64, 64));
+
+	GIFRegBITBLTBUF convert = BITBLTBUF;
+	convert.DPSM = PSMCT16;
+	EXPECT_FALSE(mem->MoveBlocks(convert, 0, 0, 0, 0, 64, 64));
+
+	GIFRegBITBLTBUF masked = MakeBITBLTBUF(PSMT8H, 0, 0x2000, 10);
+	EXPECT_FALSE(mem->MoveBlocks(masked, 0, 0, 0, 0, 64, 64));
+
+	// Overlapping rects have to be copied in order.
+	const GIFRegBITBLTBUF same = MakeBITBLTBUF(PSMCT32, 0, 0, 10);
+	EXPECT_FALSE(mem->MoveBlocks(same, 0, 0, 8, 8, 64, 64));
+
+	// So do different buffers which share memory.
+	const GIFRegBITBLTBUF shared = MakeBITBLTBUF(PSMCT32, 0, 0x20, 10);
+	EXPECT_FALSE(mem->MoveBlocks(shared, 0, 0, 0, 0, 128, 64));
+}
+
+TEST(GSLocalMemory, WriteImageMatchesPixelWrites)
+{
+	std::unique_ptr<GSLocalMemory> image = std::make_unique<GSLocalMemory>();
+	std::unique_ptr<GSLocalMemory> pixels = std::make_unique<GSLocalMemory>();
+
+	std::vector<u8> src(640 * 256 * 4);
+	for (size_t i = 0; i < src.size(); i++)
+		src[i] = static_cast<u8>((i * 7) ^ (i >> 9));
+
+	for (const u32 psm : WRITE_PSMS)
+	{
+		SCOPED_TRACE(psm);
+		const GSVector2i bs = GSLocalMemory::m_psm[psm].bs;
+		const GIFRegBITBLTBUF BITBLTBUF = MakeBITBLTBUF(psm, 0, 0x400, 10);
+
+		FillMemory(*image, psm);
+		FillMemory(*pixels, psm);
+
+		// Whole pages.
+		const int w = GSLocalMemory::m_psm[psm].pgs.x * 4, h = GSLocalMemory::m_psm[psm].pgs.y * 2;
+		WriteImage(*image, BITBLTBUF, 0, 0, w, h, src.data());
+		WritePixels(*pixels, BITBLTBUF, 0, 0, w, h, src.data());
+		EXPECT_TRUE(MemoryEquals(*image, *pixels));
+
+		// Partial blocks on every side.
+		const int ux = bs.x + 8, uy = bs.y + 2, uw = bs.x * 5, uh = bs.y * 3 + 2;
+		WriteImage(*image, BITBLTBUF, ux, uy, uw, uh, src.data());
+		WritePixels(*pixels, BITBLTBUF, ux, uy, uw, uh, src.data());
+		EXPECT_TRUE(MemoryEquals(*image, *pixels));
+	}
+}
+
+TEST(GSState, MoveFinishesTransfer)
+{
+#ifdef PCSX2_DEVBUILD
+	// Transfers are logged to the GS device in devel builds, and there isn't one here.
+	GTEST_SKIP() << "Needs a GS device";
+#endif
+
+	std::unique_ptr<TestGSState> state = std::make_unique<TestGSState>();
+	std::unique_ptr<GSLocalMemory> pixels = std::make_unique<GSLocalMemory>();
+
+	const GIFRegBITBLTBUF BITBLTBUF = MakeBITBLTBUF(PSMCT32, 0, 0x2000, 10);
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[PSMCT32];
+
+	// Whole blocks first, then a rect which has to be copied a pixel at a time.
+	for (const int offset : {0, 3})
+	{
+		SCOPED_TRACE(offset);
+		FillMemory(state->m_mem, offset);
+		FillMemory(*pixels, offset);
+
+		GIFRegTRXPOS TRXPOS = {};
+		TRXPOS.SSAX = offset;
+		TRXPOS.SSAY = 8;
+		TRXPOS.DSAX = 16;
+		TRXPOS.DSAY = offset;
+		GIFRegTRXREG TRXREG = {};
+		TRXREG.RRW = 64;
+		TRXREG.RRH = 32;
+
+		state->m_env.BITBLTBUF = BITBLTBUF;
+		state->m_env.TRXPOS = TRXPOS;
+		state->m_env.TRXREG = TRXREG;
+		state->m_env.TRXDIR.XDIR = 2;
+
+		state->Move();
+		MovePixels(*pixels, BITBLTBUF, offset, 8, 16, offset, 64, 32);
+		EXPECT_TRUE(MemoryEquals(state->m_mem, *pixels));
+		EXPECT_EQ(state->m_env.TRXDIR.XDIR, 3u);
+
+		// Once it's done, the rest of the packet doesn't move anything again.
+		(state->m_mem.*psm.wp)(offset, 8, 0x12345678, BITBLTBUF.SBP, BITBLTBUF.SBW);
+		(pixels.get()->*psm.wp)(offset, 8, 0x12345678, BITBLTBUF.SBP, BITBLTBUF.SBW);
+		state->Move();
+		EXPECT_TRUE(MemoryEquals(state->m_mem, *pixels));
+	}
+}
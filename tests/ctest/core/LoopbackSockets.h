@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "DEV9/SocketPoller.h"
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Unconnected UDP sockets bound to ephemeral loopback ports, as used by the UDP sessions.
+class LoopbackSockets
+{
+public:
+	explicit LoopbackSockets(size_t count)
+	{
+#ifdef _WIN32
+		WSADATA wsaData;
+		WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+		for (size_t i = 0; i < count; i++)
+		{
+			const PollSocket sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+			u_long nonBlocking = 1;
+			ioctlsocket(sock, FIONBIO, &nonBlocking);
+#else
+			fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+#endif
+			sockaddr_in addr{};
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			bind(sock, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+
+			socklen_t len = sizeof(addr);
+			getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &len);
+
+			sockets.push_back(sock);
+			addresses.push_back(addr);
+		}
+	}
+
+	~LoopbackSockets()
+	{
+		for (const PollSocket sock : sockets)
+			Close(sock);
+#ifdef _WIN32
+		WSACleanup();
+#endif
+	}
+
+	void SendTo(size_t index)
+	{
+		const char data[4] = {1, 2, 3, 4};
+		sendto(sockets[0], data, sizeof(data), 0, reinterpret_cast<const sockaddr*>(&addresses[index]), sizeof(addresses[index]));
+	}
+
+	static int Peek(PollSocket sock)
+	{
+		char data[16];
+		return static_cast<int>(recv(sock, data, sizeof(data), MSG_PEEK));
+	}
+
+	static void Close(PollSocket sock)
+	{
+#ifdef _WIN32
+		closesocket(sock);
+#else
+		close(sock);
+#endif
+	}
+
+	std::vector<PollSocket> sockets;
+	std::vector<sockaddr_in> addresses;
+};
+
+// Waits for loopback datagrams to land, the sends are asynchronous on some platforms.
+inline void WaitForReady(SocketPoller& poller, std::vector<PollSocket>* ready, size_t expected)
+{
+	for (int i = 0; i < 1000; i++)
+	{
+		poller.Poll(ready);
+		if (ready->size() >= expected)
+			return;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
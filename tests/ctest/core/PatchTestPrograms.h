@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "Patch.h"
+
+#include "common/MemoryInterface.h"
+
+#include <cstring>
+#include <vector>
+
+inline Patch::PatchCommand BuildPatchCommand(
+	Patch::patch_place_type place,
+	Patch::patch_cpu_type cpu,
+	u32 address,
+	Patch::patch_data_type type,
+	u64 data)
+{
+	Patch::PatchCommand command;
+	command.placetopatch = place;
+	command.cpu = cpu;
+	command.addr = address;
+	command.type = type;
+	command.data = data;
+	return command;
+}
+
+// Plain memory, so that lots of patches can be applied without the overhead of a mock.
+class TestMemoryInterface final : public MemoryInterface
+{
+public:
+	static constexpr u32 SIZE = 0x100000;
+	static constexpr u32 PAGE_MASK = 0xfff;
+
+	TestMemoryInterface()
+		: m_data(SIZE)
+	{
+	}
+
+	u8 Read8(u32 address, bool* valid) override { return Read<u8>(address, valid); }
+	u16 Read16(u32 address, bool* valid) override { return Read<u16>(address, valid); }
+	u32 Read32(u32 address, bool* valid) override { return Read<u32>(address, valid); }
+	u64 Read64(u32 address, bool* valid) override { return Read<u64>(address, valid); }
+	u128 Read128(u32 address, bool* valid) override { return Read<u128>(address, valid); }
+	bool ReadBytes(u32 address, void* dest, u32 size) override { return false; }
+
+	bool Write8(u32 address, u8 value) override { return Write<u8>(address, value); }
+	bool Write16(u32 address, u16 value) override { return Write<u16>(address, value); }
+	bool Write32(u32 address, u32 value) override { return Write<u32>(address, value); }
+	bool Write64(u32 address, u64 value) override { return Write<u64>(address, value); }
+	bool Write128(u32 address, u128 value) override { return Write<u128>(address, value); }
+	bool WriteBytes(u32 address, void* src, u32 size) override { return false; }
+
+	bool CompareBytes(u32 address, void* src, u32 size) override { return false; }
+
+	const std::vector<u8>& GetData() const { return m_data; }
+	u32 GetWriteCount() const { return m_writes; }
+
+	// Where EE RAM would be when it can be read directly.
+	const u8* GetPage(u32 address) const { return &m_data[address & ~PAGE_MASK]; }
+
+private:
+	template <typename T>
+	T Read(u32 address, bool* valid)
+	{
+		T value;
+		std::memcpy(&value, &m_data[address % (SIZE - sizeof(T))], sizeof(T));
+		if (valid)
+			*valid = true;
+		return value;
+	}
+
+	template <typename T>
+	bool Write(u32 address, T value)
+	{
+		std::memcpy(&m_data[address % (SIZE - sizeof(T))], &value, sizeof(T));
+		m_writes++;
+		return true;
+	}
+
+	std::vector<u8> m_data;
+	u32 m_writes = 0;
+};
+
+// Roughly what a big cheat file looks like: mostly constant writes, some
+// grouped behind conditionals, split up into a lot of groups.
+inline std::vector<Patch::PatchCommand> BuildCheatSet(u32 groups)
+{
+	static constexpr Patch::patch_data_type PLAIN_TYPES[] = {
+		Patch::BYTE_T, Patch::SHORT_T, Patch::WORD_T, Patch::DOUBLE_T, Patch::WORD_BE_T};
+
+	std::vector<Patch::PatchCommand> commands;
+	for (u32 i = 0; i < groups; i++)
+	{
+		const u32 base = (i * 0x1230) & 0xff000;
+		const Patch::patch_place_type place = (i % 5 == 0) ? Patch::PPT_ONCE_ON_LOAD : Patch::PPT_CONTINUOUSLY;
+		if (i % 4 == 0)
+		{
+			// Only apply the next line if the halfword at base is zero.
+			commands.push_back(BuildPatchCommand(place, Patch::CPU_EE, 0xd0000000 | base, Patch::EXTENDED_T, 0x00000000));
+			commands.push_back(BuildPatchCommand(place, Patch::CPU_EE, 0x20000000 | (base + 0x10), Patch::EXTENDED_T, i));
+		}
+
+		for (u32 j = 0; j < 8; j++)
+		{
+			commands.push_back(BuildPatchCommand(place, (j == 7) ? Patch::CPU_IOP : Patch::CPU_EE, base + 0x20 + j * 8,
+				PLAIN_TYPES[(i + j) % std::size(PLAIN_TYPES)], 0x0123456789abcdefull * (i + j + 1)));
+		}
+	}
+	return commands;
+}
+
+inline std::vector<const Patch::PatchCommand*> BuildPatchList(const std::vector<Patch::PatchCommand>& commands)
+{
+	// Start a new group every ten lines, which resets the extended state.
+	std::vector<const Patch::PatchCommand*> pointers;
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		if (i % 10 == 0)
+			pointers.push_back(nullptr);
+		pointers.push_back(&commands[i]);
+	}
+	return pointers;
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Host/AudioStream.h"
+
+#include "common/Timer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	static constexpr u32 SAMPLE_RATE = 48000;
+
+	class TestAudioStream final : public AudioStream
+	{
+	public:
+		TestAudioStream(const AudioStreamParameters& parameters, bool stretch_enabled)
+			: AudioStream(SAMPLE_RATE, parameters)
+		{
+			BaseInitialize(&StereoSampleReaderImpl, stretch_enabled);
+		}
+
+		using AudioStream::ReadFrames;
+	};
+
+	static void FillChunk(AudioStream::SampleType (&chunk)[AudioStream::CHUNK_SIZE * 2], u32 first_frame)
+	{
+		for (u32 i = 0; i < AudioStream::CHUNK_SIZE; i++)
+		{
+			const float value = std::sin(static_cast<float>(first_frame + i) * 0.05f);
+			chunk[i * 2 + 0] = value;
+			chunk[i * 2 + 1] = -value;
+		}
+	}
+
+	static bool WaitForFramesWritten(const AudioStream& stream, u64 frames)
+	{
+		for (int i = 0; i < 5000; i++)
+		{
+			if (stream.GetStatistics().frames_written >= frames)
+				return true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return false;
+	}
+} // namespace
+
+TEST(AudioStream, StretchThroughput)
+{
+	// Ten seconds of audio, pushed as fast as the stretch thread takes it.
+	static constexpr u32 CHUNKS = SAMPLE_RATE * 10 / AudioStream::CHUNK_SIZE;
+	static constexpr u32 READ_SIZE = 256;
+
+	TestAudioStream stream(AudioStreamParameters(), true);
+
+	std::atomic_bool done{false};
+	std::thread backend([&stream, &done]() {
+		std::vector<AudioStream::SampleType> output(READ_SIZE * 2);
+		while (!done.load(std::memory_order_acquire))
+		{
+			if (stream.GetBufferedFramesRelaxed() >= READ_SIZE)
+				stream.ReadFrames(output.data(), READ_SIZE);
+			else
+				std::this_thread::yield();
+		}
+	});
+
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	double write_ms = 0.0;
+	Common::Timer timer;
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+
+		Common::Timer write_timer;
+		stream.WriteChunk(chunk);
+		write_ms += write_timer.GetTimeMilliseconds();
+
+		// Roughly the rate of a game running unthrottled, without overrunning the stretch thread.
+		if ((i % 4) == 3)
+			std::this_thread::yield();
+	}
+
+	WaitForFramesWritten(stream, static_cast<u64>(CHUNKS) * AudioStream::CHUNK_SIZE / 2);
+	const double total_ms = timer.GetTimeMilliseconds();
+	done.store(true, std::memory_order_release);
+	backend.join();
+
+	const AudioStream::Statistics stats = stream.GetStatistics();
+	EXPECT_GT(stats.frames_read, 0u);
+
+	std::printf("AudioStream, %u chunks stretched: %.3f ms writing, %.3f ms total, %u overruns, %u underruns, "
+				"average latency %u frames\n",
+		CHUNKS, write_ms, total_ms, stats.overruns, stats.underruns, stats.average_latency_frames);
+}
@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Host/AudioStream.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	static constexpr u32 SAMPLE_RATE = 48000;
+
+	// Lets the test play the part of the backend.
+	class TestAudioStream final : public AudioStream
+	{
+	public:
+		TestAudioStream(const AudioStreamParameters& parameters, bool stretch_enabled)
+			: AudioStream(SAMPLE_RATE, parameters)
+		{
+			BaseInitialize(&StereoSampleReaderImpl, stretch_enabled);
+		}
+
+		using AudioStream::ReadFrames;
+	};
+
+	static void FillChunk(AudioStream::SampleType (&chunk)[AudioStream::CHUNK_SIZE * 2], u32 first_frame)
+	{
+		for (u32 i = 0; i < AudioStream::CHUNK_SIZE; i++)
+		{
+			const float value = std::sin(static_cast<float>(first_frame + i) * 0.05f);
+			chunk[i * 2 + 0] = value;
+			chunk[i * 2 + 1] = -value;
+		}
+	}
+
+	// The stretch thread works in the background, give it a moment.
+	static bool WaitForFramesWritten(const AudioStream& stream, u64 frames)
+	{
+		for (int i = 0; i < 5000; i++)
+		{
+			if (stream.GetStatistics().frames_written >= frames)
+				return true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return false;
+	}
+} // namespace
+
+TEST(AudioStream, PassesFramesThrough)
+{
+	static constexpr u32 CHUNKS = 16;
+
+	TestAudioStream stream(AudioStreamParameters(), false);
+
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		stream.WriteChunk(chunk);
+	}
+
+	std::vector<AudioStream::SampleType> output(CHUNKS * AudioStream::CHUNK_SIZE * 2);
+	stream.ReadFrames(output.data(), CHUNKS * AudioStream::CHUNK_SIZE);
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		for (u32 j = 0; j < AudioStream::CHUNK_SIZE * 2; j++)
+			ASSERT_EQ(output[i * AudioStream::CHUNK_SIZE * 2 + j], chunk[j]);
+	}
+
+	const AudioStream::Statistics stats = stream.GetStatistics();
+	EXPECT_EQ(stats.frames_written, CHUNKS * AudioStream::CHUNK_SIZE);
+	EXPECT_EQ(stats.frames_read, CHUNKS * AudioStream::CHUNK_SIZE);
+	EXPECT_EQ(stats.underruns, 0u);
+	EXPECT_EQ(stats.overruns, 0u);
+	EXPECT_EQ(stats.max_latency_frames, CHUNKS * AudioStream::CHUNK_SIZE);
+}
+
+TEST(AudioStream, CountsOverrunsAndUnderruns)
+{
+	TestAudioStream stream(AudioStreamParameters(), false);
+
+	// One slot always stays empty, so the last chunk which would fill the buffer is dropped.
+	const u32 fitting_chunks = stream.GetBufferSize() / AudioStream::CHUNK_SIZE - 1;
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	for (u32 i = 0; i < fitting_chunks + 4; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		stream.WriteChunk(chunk);
+	}
+
+	AudioStream::Statistics stats = stream.GetStatistics();
+	EXPECT_EQ(stats.frames_written, fitting_chunks * AudioStream::CHUNK_SIZE);
+	EXPECT_EQ(stats.overruns, 4u);
+	EXPECT_EQ(stats.underruns, 0u);
+
+	std::vector<AudioStream::SampleType> output((fitting_chunks + 1) * AudioStream::CHUNK_SIZE * 2);
+	stream.ReadFrames(output.data(), (fitting_chunks + 1) * AudioStream::CHUNK_SIZE);
+
+	stats = stream.GetStatistics();
+	EXPECT_EQ(stats.frames_read, fitting_chunks * AudioStream::CHUNK_SIZE);
+	EXPECT_EQ(stats.underruns, 1u);
+}
+
+TEST(AudioStream, StretchesOnThread)
+{
+	// Less than the stretch thread's input buffer, so nothing is dropped even if it doesn't get to run.
+	static constexpr u32 CHUNKS = 48;
+
+	TestAudioStream stream(AudioStreamParameters(), true);
+
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		stream.WriteChunk(chunk);
+	}
+
+	// SoundTouch holds some frames back, but it should have produced something.
+	ASSERT_TRUE(WaitForFramesWritten(stream, 1));
+	EXPECT_EQ(stream.GetStatistics().overruns, 0u);
+
+	std::vector<AudioStream::SampleType> output(AudioStream::CHUNK_SIZE * 2);
+	stream.ReadFrames(output.data(), AudioStream::CHUNK_SIZE);
+	float energy = 0.0f;
+	for (const float sample : output)
+		energy += sample * sample;
+	EXPECT_GT(energy, 0.0f);
+
+	// Both of these stop the stretch thread while they touch its state.
+	stream.EmptyBuffer();
+	EXPECT_EQ(stream.GetBufferedFramesRelaxed(), 0u);
+	stream.SetStretchEnabled(false);
+	stream.SetStretchEnabled(true);
+
+	const u64 written = stream.GetStatistics().frames_written;
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		stream.WriteChunk(chunk);
+	}
+	EXPECT_TRUE(WaitForFramesWritten(stream, written + 1));
+}
+
+TEST(AudioStream, FlushesPartialBatch)
+{
+	// Expansion runs on the stretch thread too, and only holds back one block, unlike SoundTouch.
+	static constexpr u32 CHUNKS = 7;
+	static constexpr u32 BLOCK_CHUNKS = AudioStream::MIN_EXPANSION_BLOCK_SIZE / AudioStream::CHUNK_SIZE;
+
+	AudioStreamParameters parameters;
+	parameters.expansion_mode = AudioExpansionMode::StereoLFE;
+	parameters.expand_block_size = AudioStream::MIN_EXPANSION_BLOCK_SIZE;
+	TestAudioStream stream(parameters, false);
+
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		stream.WriteChunk(chunk);
+	}
+
+	// Short of a whole batch, so it waits for more input.
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_EQ(stream.GetStatistics().frames_written, 0u);
+
+	// Until the backend runs dry.
+	std::vector<AudioStream::SampleType> output(AudioStream::CHUNK_SIZE * AudioStream::MAX_OUTPUT_CHANNELS);
+	stream.ReadFrames(output.data(), AudioStream::CHUNK_SIZE);
+	EXPECT_EQ(stream.GetStatistics().underruns, 1u);
+	ASSERT_TRUE(WaitForFramesWritten(stream, (CHUNKS - BLOCK_CHUNKS) * AudioStream::CHUNK_SIZE));
+
+	// The same goes for pausing.
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, (CHUNKS + i) * AudioStream::CHUNK_SIZE);
+		stream.WriteChunk(chunk);
+	}
+	stream.SetPaused(true);
+	EXPECT_TRUE(WaitForFramesWritten(stream, (CHUNKS * 2 - BLOCK_CHUNKS) * AudioStream::CHUNK_SIZE));
+}
+
+TEST(AudioStream, EmptyBufferWhileUnderrunning)
+{
+	// Not a whole number of batches, so there's always input for an underrun to flush.
+	static constexpr u32 ITERATIONS = 50;
+	static constexpr u32 CHUNKS = 13;
+
+	AudioStreamParameters parameters;
+	parameters.expansion_mode = AudioExpansionMode::StereoLFE;
+	parameters.expand_block_size = AudioStream::MIN_EXPANSION_BLOCK_SIZE;
+	TestAudioStream stream(parameters, false);
+
+	// Underruns wake the stretch thread from the backend's thread at any time, including during EmptyBuffer().
+	std::atomic_bool done{false};
+	std::thread backend([&stream, &done]() {
+		std::vector<AudioStream::SampleType> output(AudioStream::CHUNK_SIZE * AudioStream::MAX_OUTPUT_CHANNELS);
+		while (!done.load(std::memory_order_acquire))
+		{
+			stream.ReadFrames(output.data(), AudioStream::CHUNK_SIZE);
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	});
+
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	for (u32 i = 0; i < ITERATIONS; i++)
+	{
+		for (u32 j = 0; j < CHUNKS; j++)
+		{
+			FillChunk(chunk, j * AudioStream::CHUNK_SIZE);
+			stream.WriteChunk(chunk);
+		}
+
+		// Nothing can be written behind its back, the backend only takes frames away.
+		stream.EmptyBuffer();
+		EXPECT_EQ(stream.GetBufferedFramesRelaxed(), 0u) << i;
+	}
+
+	done.store(true, std::memory_order_release);
+	backend.join();
+	EXPECT_GT(stream.GetStatistics().underruns, 0u);
+}
+
+TEST(AudioStream, PacingNullStreamReads)
+{
+	static constexpr u32 CHUNKS = 32;
+
+	std::unique_ptr<AudioStream> stream = AudioStream::CreatePacingNullStream(SAMPLE_RATE, AudioStreamParameters(), false);
+	ASSERT_NE(stream, nullptr);
+
+	AudioStream::SampleType chunk[AudioStream::CHUNK_SIZE * 2];
+	for (u32 i = 0; i < CHUNKS; i++)
+	{
+		FillChunk(chunk, i * AudioStream::CHUNK_SIZE);
+		stream->WriteChunk(chunk);
+	}
+
+	// Read at the device rate, so this takes about 40ms.
+	for (int i = 0; i < 5000 && stream->GetStatistics().frames_read < CHUNKS * AudioStream::CHUNK_SIZE; i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	EXPECT_EQ(stream->GetStatistics().frames_read, CHUNKS * AudioStream::CHUNK_SIZE);
+
+	stream->SetPaused(true);
+	stream->SetPaused(false);
+}
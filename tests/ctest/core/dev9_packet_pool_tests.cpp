@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "DEV9/PacketReader/EthernetFrame.h"
+#include "DEV9/PacketReader/IP/UDP/UDP_Packet.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+
+using namespace PacketReader;
+using namespace PacketReader::IP;
+using namespace PacketReader::IP::UDP;
+
+namespace
+{
+	static const IP_Address SOURCE_IP{{{192, 168, 1, 10}}};
+	static const IP_Address DEST_IP{{{10, 0, 2, 100}}};
+
+	// Builds a frame the same way the socket adapter's recv path does.
+	static void BuildUDPFrame(NetPacket* pkt, int payload_size, u8 fill)
+	{
+		PayloadData* data = new PayloadData(payload_size);
+		std::memset(data->data.get(), fill, payload_size);
+
+		UDP_Packet* udp = new UDP_Packet(data);
+		udp->sourcePort = 1234;
+		udp->destinationPort = 5678;
+
+		IP_Packet* ip = new IP_Packet(udp);
+		ip->sourceIP = SOURCE_IP;
+		ip->destinationIP = DEST_IP;
+
+		EthernetFrame frame(ip);
+		frame.protocol = static_cast<u16>(EtherType::IPv4);
+		frame.WritePacket(pkt);
+	}
+} // namespace
+
+TEST(DEV9PacketPool, ReusesFreedObjects)
+{
+	std::unique_ptr<UDP_Packet> first = std::make_unique<UDP_Packet>(new PayloadData(16));
+	const std::set<const void*> first_objects = {first.get(), first->GetPayload()};
+	const u8* first_data = static_cast<PayloadData*>(first->GetPayload())->data.get();
+	first.reset();
+
+	// Both objects share a size class, so may swap blocks.
+	std::unique_ptr<UDP_Packet> second = std::make_unique<UDP_Packet>(new PayloadData(32));
+	const std::set<const void*> second_objects = {second.get(), second->GetPayload()};
+	EXPECT_EQ(first_objects, second_objects);
+	EXPECT_EQ(static_cast<PayloadData*>(second->GetPayload())->data.get(), first_data);
+}
+
+TEST(DEV9PacketPool, ReturnsBlocksToAllocatingThread)
+{
+	// Frames built on the send thread are freed on the recv thread.
+	std::unique_ptr<UDP_Packet> packet = std::make_unique<UDP_Packet>(new PayloadData(16));
+	const std::set<const void*> objects = {packet.get(), packet->GetPayload()};
+	const u8* data = static_cast<PayloadData*>(packet->GetPayload())->data.get();
+	std::thread([&packet]() { packet.reset(); }).join();
+
+	std::unique_ptr<UDP_Packet> reused = std::make_unique<UDP_Packet>(new PayloadData(16));
+	EXPECT_EQ(objects, (std::set<const void*>{reused.get(), reused->GetPayload()}));
+	EXPECT_EQ(static_cast<PayloadData*>(reused->GetPayload())->data.get(), data);
+}
+
+TEST(DEV9PacketPool, OutlivesAllocatingThread)
+{
+	std::unique_ptr<UDP_Packet> packet;
+	std::thread([&packet]() {
+		packet = std::make_unique<UDP_Packet>(new PayloadData(PacketPool::BufferSize));
+		std::memset(static_cast<PayloadData*>(packet->GetPayload())->data.get(), 0x5A, PacketPool::BufferSize);
+	}).join();
+
+	// The pool of the exited thread is only released with its last block.
+	PayloadData* payload = static_cast<PayloadData*>(packet->GetPayload());
+	EXPECT_EQ(payload->data[PacketPool::BufferSize - 1], 0x5A);
+	packet.reset();
+}
+
+TEST(DEV9PacketPool, OversizedBuffers)
+{
+	EXPECT_EQ(PacketPool::MakeBuffer(0).get(), nullptr);
+	EXPECT_TRUE(PacketPool::MakeBuffer(PacketPool::BufferSize).get_deleter().pooled);
+	EXPECT_FALSE(PacketPool::MakeBuffer(PacketPool::BufferSize + 1).get_deleter().pooled);
+
+	PayloadData large(PacketPool::BufferSize * 2);
+	std::memset(large.data.get(), 0x5A, large.GetLength());
+	std::unique_ptr<PayloadData> copy(large.Clone());
+	EXPECT_EQ(std::memcmp(copy->data.get(), large.data.get(), large.GetLength()), 0);
+}
+
+TEST(DEV9PacketPool, FrameRoundTrip)
+{
+	NetPacket pkt;
+	BuildUDPFrame(&pkt, 200, 0xA5);
+	EXPECT_EQ(pkt.size, 14 + 20 + 8 + 200);
+
+	// Parsed in place over the NetPacket.
+	EthernetFrame frame(&pkt);
+	ASSERT_EQ(frame.protocol, static_cast<u16>(EtherType::IPv4));
+	PayloadPtr* frame_payload = static_cast<PayloadPtr*>(frame.GetPayload());
+	EXPECT_EQ(frame_payload->data, reinterpret_cast<u8*>(&pkt.buffer[14]));
+
+	IP_Packet ip(frame_payload->data, frame_payload->GetLength());
+	EXPECT_TRUE(ip.VerifyChecksum());
+	EXPECT_EQ(ip.sourceIP, SOURCE_IP);
+	EXPECT_EQ(ip.destinationIP, DEST_IP);
+
+	IP_PayloadPtr* ip_payload = static_cast<IP_PayloadPtr*>(ip.GetPayload());
+	UDP_Packet udp(ip_payload->data, ip_payload->GetLength());
+	EXPECT_EQ(udp.sourcePort, 1234);
+	EXPECT_EQ(udp.destinationPort, 5678);
+
+	PayloadPtr* udp_payload = static_cast<PayloadPtr*>(udp.GetPayload());
+	ASSERT_EQ(udp_payload->GetLength(), 200);
+	for (int i = 0; i < udp_payload->GetLength(); i++)
+		EXPECT_EQ(udp_payload->data[i], 0xA5);
+}
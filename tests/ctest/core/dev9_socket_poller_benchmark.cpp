@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "LoopbackSockets.h"
+
+#include "common/Timer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+TEST(DEV9SocketPoller, PollVersusRecvSweep)
+{
+	// A few hundred sessions, with only a handful receiving at any time.
+	static constexpr size_t SESSIONS = 500;
+	static constexpr int POLLS = 2000;
+
+	LoopbackSockets sockets(SESSIONS);
+	SocketPoller poller;
+	for (size_t i = 0; i < SESSIONS; i++)
+		poller.Update(&sockets.addresses[i], sockets.sockets[i]);
+
+	for (size_t i = 1; i < SESSIONS; i += 100)
+		sockets.SendTo(i);
+
+	std::vector<PollSocket> ready;
+	WaitForReady(poller, &ready, SESSIONS / 100);
+
+	// What the adapter used to do, a recv() on every session.
+	u64 sweep_found = 0;
+	Common::Timer timer;
+	for (int i = 0; i < POLLS; i++)
+	{
+		for (const PollSocket sock : sockets.sockets)
+			sweep_found += (LoopbackSockets::Peek(sock) > 0);
+	}
+	const double sweep_ms = timer.GetTimeMilliseconds();
+
+	u64 poll_found = 0;
+	timer.Reset();
+	for (int i = 0; i < POLLS; i++)
+	{
+		for (size_t j = 0; j < SESSIONS; j++)
+			poller.Update(&sockets.addresses[j], sockets.sockets[j]);
+		poller.Poll(&ready);
+		for (const PollSocket sock : ready)
+			poll_found += (LoopbackSockets::Peek(sock) > 0);
+	}
+	const double poll_ms = timer.GetTimeMilliseconds();
+
+	EXPECT_EQ(sweep_found, poll_found);
+
+	std::printf("DEV9 socket polling, %zu sessions x %d polls: recv sweep %.3f ms, poller %.3f ms\n",
+		SESSIONS, POLLS, sweep_ms, poll_ms);
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "LoopbackSockets.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+TEST(DEV9SocketPoller, ReportsReadableSockets)
+{
+	LoopbackSockets sockets(64);
+	SocketPoller poller;
+
+	for (size_t i = 0; i < sockets.sockets.size(); i++)
+		poller.Update(&sockets.addresses[i], sockets.sockets[i]);
+
+	std::vector<PollSocket> ready;
+	poller.Poll(&ready);
+	EXPECT_TRUE(ready.empty());
+
+	std::vector<PollSocket> expected;
+	for (size_t i = 5; i < sockets.sockets.size(); i += 10)
+	{
+		sockets.SendTo(i);
+		expected.push_back(sockets.sockets[i]);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	WaitForReady(poller, &ready, expected.size());
+	EXPECT_EQ(ready, expected);
+
+	// Removed and unset sockets stop being reported, updating to the same socket is a no-op.
+	poller.Remove(&sockets.addresses[5]);
+	poller.Update(&sockets.addresses[15], static_cast<PollSocket>(-1));
+	poller.Update(&sockets.addresses[25], sockets.sockets[25]);
+	expected.erase(std::remove(expected.begin(), expected.end(), sockets.sockets[5]), expected.end());
+	expected.erase(std::remove(expected.begin(), expected.end(), sockets.sockets[15]), expected.end());
+
+	poller.Poll(&ready);
+	EXPECT_EQ(ready, expected);
+}
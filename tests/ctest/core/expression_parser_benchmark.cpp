@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "ExpressionTestFunctions.h"
+
+#include "common/Timer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+TEST(ExpressionParser, CompiledVersusInterpreted)
+{
+	// A typical breakpoint condition, checked on every pass through a hot loop.
+	static constexpr int EVALUATIONS = 1000000;
+
+	TestFunctions funcs;
+	PostfixExpression postfix;
+	std::string error;
+	ASSERT_TRUE(initPostfixExpression("r4 == 0x4000 && [r2 & 0xF0] != 0 || r31 == 0x100000", &funcs, postfix, error));
+
+	CompiledExpression compiled;
+	ASSERT_TRUE(compiled.compile(postfix, &funcs, error));
+
+	u64 interpreted_sum = 0;
+	Common::Timer timer;
+	for (int i = 0; i < EVALUATIONS; i++)
+	{
+		funcs.regs[2] = i;
+		u64 result;
+		std::string eval_error;
+		parsePostfixExpression(postfix, &funcs, result, eval_error);
+		interpreted_sum += result;
+	}
+	const double interpreted_ms = timer.GetTimeMilliseconds();
+
+	u64 compiled_sum = 0;
+	timer.Reset();
+	for (int i = 0; i < EVALUATIONS; i++)
+	{
+		funcs.regs[2] = i;
+		u64 result;
+		std::string eval_error;
+		compiled.evaluate(&funcs, result, eval_error);
+		compiled_sum += result;
+	}
+	const double compiled_ms = timer.GetTimeMilliseconds();
+
+	EXPECT_EQ(compiled_sum, interpreted_sum);
+
+	std::printf("Expression evaluation, %d conditions: interpreted %.3f ms, compiled %.3f ms\n",
+		EVALUATIONS, interpreted_ms, compiled_ms);
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "ExpressionTestFunctions.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+	static void ExpectSameResult(TestFunctions& funcs, const char* infix)
+	{
+		PostfixExpression postfix;
+		std::string error;
+		ASSERT_TRUE(initPostfixExpression(infix, &funcs, postfix, error)) << infix;
+
+		u64 interpreted = 0;
+		std::string interpreted_error;
+		const bool interpreted_ok = parsePostfixExpression(postfix, &funcs, interpreted, interpreted_error);
+
+		CompiledExpression compiled;
+		u64 result = 0;
+		std::string compiled_error;
+		const bool compiled_ok = compiled.compile(postfix, &funcs, compiled_error) &&
+		                         compiled.evaluate(&funcs, result, compiled_error);
+
+		EXPECT_EQ(compiled_ok, interpreted_ok) << infix;
+		EXPECT_EQ(compiled_error, interpreted_error) << infix;
+		if (compiled_ok && interpreted_ok)
+			EXPECT_EQ(result, interpreted) << infix;
+	}
+} // namespace
+
+TEST(ExpressionParser, CompiledMatchesInterpreter)
+{
+	static const char* const expressions[] = {
+		"1", "r5", "r3 + r4 * 2", "(r3 + r4) * 2", "r10 - r11", "-r2", "~r7", "!r0", "!r1",
+		"r9 / 3", "r9 % 7", "r9 / r0", "r9 % r0", "r1 << 4", "r20 >> 3",
+		"r1 == 0x1234567", "r1 != 0x1234567", "r2 >= r3", "r2 > r3", "r2 <= r3", "r2 < r3",
+		"r5 & 0xFF", "r5 ^ r6", "r5 | r6", "r0 && r1", "r1 && r2", "r0 || r0", "r0 || r3",
+		"r1 ? r2 : r3", "r0 ? r2 : r3", "r1 ? r0 ? 1 : 2 : 3",
+		"[data]", "[data + 4] == 0x1E171009", "[data, 1]", "[data + 2, 2]", "[data, 3]", "[0x1000]",
+		"fp2 + 1", "fp3 * fp4", "fp5 / 2", "fp6 > fp7", "fp6 < fp7", "r1 + fp0", "r1 - fp1", "-fp0",
+		"1.5 + 2", "r3 == 3.0", "+r1", "1 2", "r1 +",
+		"((((((((((((((((((((((((((((((((((((1+r1)+r2)+r3)+r4)+r5)+r6)+r7)+r8)+r9)+r10)+r11)+r12)+r13)+r14)"
+		"+r15)+r16)+r17)+r18)+r19)+r20)+r21)+r22)+r23)+r24)+r25)+r26)+r27)+r28)+r29)+r30)+r31)+1)+2)+3)+4)+5)",
+		"1+(2+(3+(4+(5+(6+(7+(8+(9+(10+(11+(12+(13+(14+(15+(16+(17+(18+(19+(20+(21+(22+(23+(24+(25+(26+(27+(28+(29+"
+		"(30+(31+(32+(33+(34+(35+r1))))))))))))))))))))))))))))))))))",
+	};
+
+	TestFunctions funcs;
+	for (const char* infix : expressions)
+		ExpectSameResult(funcs, infix);
+}
+
+TEST(ExpressionParser, CompiledReadsCurrentValues)
+{
+	TestFunctions funcs;
+	PostfixExpression postfix;
+	std::string error;
+	ASSERT_TRUE(initPostfixExpression("r4 == 0x10 && fp1 > 2", &funcs, postfix, error));
+
+	CompiledExpression compiled;
+	ASSERT_TRUE(compiled.compile(postfix, &funcs, error));
+
+	u64 result;
+	ASSERT_TRUE(compiled.evaluate(&funcs, result, error));
+	EXPECT_EQ(result, 0u);
+
+	funcs.regs[4] = 0x10;
+	const float f = 3.0f;
+	std::memcpy(&funcs.fregs[1], &f, sizeof(f));
+	ASSERT_TRUE(compiled.evaluate(&funcs, result, error));
+	EXPECT_EQ(result, 1u);
+}
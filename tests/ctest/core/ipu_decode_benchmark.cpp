@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "IPU/IPU_DCT.h"
+
+#include "common/Timer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	struct alignas(16) Block
+	{
+		s16 coeffs[64];
+	};
+
+	// Same block shape as the decode tests: a DC term plus a few quantized AC terms.
+	static std::vector<Block> MakeStreamBlocks(u32 seed, size_t count)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> dc(-2048, 2047);
+		std::uniform_int_distribution<int> ac_count(0, 12);
+		std::geometric_distribution<int> position(0.15);
+		std::uniform_int_distribution<int> level(-64, 64);
+
+		std::vector<Block> blocks(count);
+		for (Block& block : blocks)
+		{
+			std::memset(block.coeffs, 0, sizeof(block.coeffs));
+			block.coeffs[0] = static_cast<s16>(dc(rng));
+
+			for (int i = ac_count(rng); i > 0; i--)
+			{
+				const int pos = std::min(1 + position(rng), 63);
+				block.coeffs[pos] = static_cast<s16>(level(rng) * 16 / (1 + pos / 8));
+			}
+		}
+
+		return blocks;
+	}
+} // namespace
+
+TEST(IPUDecode, IDCTAndVLC)
+{
+	// Roughly one second of 640x448 video, at 6 blocks per macroblock.
+	static constexpr size_t BLOCKS = 60 * 40 * 28 * 6;
+	const std::vector<Block> input = MakeStreamBlocks(42, BLOCKS);
+	std::vector<Block> reference_output = input;
+	std::vector<Block> vector_output = input;
+
+	Common::Timer timer;
+	for (Block& block : reference_output)
+		IDCT_Block_reference(block.coeffs);
+	const double reference_idct_ms = timer.GetTimeMilliseconds();
+
+	timer.Reset();
+	for (Block& block : vector_output)
+		IDCT_Block_vector(block.coeffs);
+	const double vector_idct_ms = timer.GetTimeMilliseconds();
+
+	EXPECT_EQ(std::memcmp(reference_output.data(), vector_output.data(), BLOCKS * sizeof(Block)), 0);
+
+	// VLC lookups over a random code stream, biased towards short codes like real streams.
+	std::mt19937 rng(42);
+	std::geometric_distribution<int> zeros(0.4);
+	std::uniform_int_distribution<u32> bits(0, 0xFFFF);
+	std::vector<u16> codes(BLOCKS * 4);
+	for (u16& code : codes)
+		code = static_cast<u16>(bits(rng) >> std::min(zeros(rng), 15));
+
+	uptr reference_sum = 0;
+	timer.Reset();
+	for (const u16 code : codes)
+		reference_sum += reinterpret_cast<uptr>(DCT_Lookup_reference(code, DCTTable::NonIntraNext));
+	const double reference_vlc_ms = timer.GetTimeMilliseconds();
+
+	uptr table_sum = 0;
+	timer.Reset();
+	for (const u16 code : codes)
+		table_sum += reinterpret_cast<uptr>(DCT_Lookup(code, DCTTable::NonIntraNext));
+	const double table_vlc_ms = timer.GetTimeMilliseconds();
+
+	EXPECT_EQ(reference_sum, table_sum);
+
+	std::printf("IPU IDCT, %zu blocks: reference %.3f ms, vector %.3f ms\n", BLOCKS, reference_idct_ms, vector_idct_ms);
+	std::printf("IPU VLC, %zu codes: reference %.3f ms, table %.3f ms\n", codes.size(), reference_vlc_ms, table_vlc_ms);
+}
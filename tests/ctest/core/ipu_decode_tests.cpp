@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "IPU/IPU_DCT.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	struct alignas(16) Block
+	{
+		s16 coeffs[64];
+	};
+
+	// Coefficient blocks shaped like decoded macroblocks: a DC term plus a handful of AC terms
+	// which get rarer and smaller towards the high frequencies, the same as after quantization.
+	static std::vector<Block> MakeStreamBlocks(u32 seed, size_t count)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> dc(-2048, 2047);
+		std::uniform_int_distribution<int> ac_count(0, 12);
+		std::geometric_distribution<int> position(0.15);
+		std::uniform_int_distribution<int> level(-64, 64);
+
+		std::vector<Block> blocks(count);
+		for (Block& block : blocks)
+		{
+			std::memset(block.coeffs, 0, sizeof(block.coeffs));
+			block.coeffs[0] = static_cast<s16>(dc(rng));
+
+			for (int i = ac_count(rng); i > 0; i--)
+			{
+				const int pos = std::min(1 + position(rng), 63);
+				block.coeffs[pos] = static_cast<s16>(level(rng) * 16 / (1 + pos / 8));
+			}
+		}
+
+		return blocks;
+	}
+
+	static void ExpectIDCTMatches(const Block& input)
+	{
+		Block expected = input;
+		Block actual = input;
+		IDCT_Block_reference(expected.coeffs);
+		IDCT_Block_vector(actual.coeffs);
+		EXPECT_EQ(std::memcmp(expected.coeffs, actual.coeffs, sizeof(expected.coeffs)), 0);
+	}
+} // namespace
+
+TEST(IPUDecode, IDCTMatchesReference)
+{
+	for (const Block& block : MakeStreamBlocks(1234, 10000))
+		ExpectIDCTMatches(block);
+}
+
+TEST(IPUDecode, IDCTMatchesReferenceFullRange)
+{
+	// Values outside what legal streams produce, to cover the wrapping intermediates.
+	std::mt19937 rng(5678);
+	std::uniform_int_distribution<int> value(-2048, 2047);
+
+	Block block;
+	for (int i = 0; i < 10000; i++)
+	{
+		for (s16& coeff : block.coeffs)
+			coeff = static_cast<s16>(value(rng));
+		ExpectIDCTMatches(block);
+	}
+}
+
+TEST(IPUDecode, IDCTDCOnlyRows)
+{
+	Block block = {};
+	for (int dc = -2048; dc < 2048; dc++)
+	{
+		for (int row = 0; row < 8; row++)
+			block.coeffs[row * 8] = static_cast<s16>(dc + row);
+		ExpectIDCTMatches(block);
+	}
+}
+
+TEST(IPUDecode, DCTLookupMatchesReference)
+{
+	for (int table = 0; table < static_cast<int>(DCTTable::Count); table++)
+	{
+		for (u32 code = 0; code < 0x10000; code++)
+		{
+			EXPECT_EQ(DCT_Lookup_reference(static_cast<u16>(code), static_cast<DCTTable>(table)),
+				DCT_Lookup(static_cast<u16>(code), static_cast<DCTTable>(table)))
+				<< "table " << table << " code " << code;
+		}
+	}
+}
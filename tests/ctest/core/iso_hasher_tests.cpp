@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/CDVD/IsoHasher.h"
+
+#include "common/FileSystem.h"
+#include "common/MD5Digest.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+namespace
+{
+	static constexpr u32 SECTOR_SIZE = 2048;
+
+	class TestImages
+	{
+	public:
+		TestImages(u32 count, u32 sectors)
+		{
+			for (u16 i = 0; i < UINT16_MAX && directory.empty(); i++)
+			{
+				std::string path = Path::Combine(FileSystem::GetWorkingDirectory(), fmt::format("pcsx2_iso_hasher_test_{}", i));
+				if (!FileSystem::DirectoryExists(path.c_str()) && FileSystem::CreateDirectoryPath(path.c_str(), false))
+					directory = std::move(path);
+			}
+
+			for (u32 i = 0; i < count && !directory.empty(); i++)
+			{
+				// A DVD image as far as detection goes, the primary volume descriptor is at sector 16.
+				std::vector<u8> data(static_cast<size_t>(sectors) * SECTOR_SIZE);
+				for (size_t j = 0; j < data.size(); j++)
+					data[j] = static_cast<u8>((j * 31) ^ (j >> 11) ^ i);
+				u8* const pvd = &data[16 * SECTOR_SIZE];
+				std::memcpy(pvd, "\x01" "CD001", 6);
+				pvd[166] = 0;
+				pvd[167] = 0;
+
+				std::string path = Path::Combine(directory, fmt::format("image{}.iso", i));
+				FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size());
+
+				MD5Digest md5;
+				md5.Update(data.data(), static_cast<u32>(data.size()));
+				u8 digest[16];
+				md5.Final(digest);
+
+				std::string hash;
+				for (const u8 b : digest)
+					hash += fmt::format("{:02x}", b);
+
+				paths.push_back(std::move(path));
+				hashes.push_back(std::move(hash));
+			}
+		}
+
+		~TestImages()
+		{
+			if (!directory.empty())
+				FileSystem::RecursiveDeleteDirectory(directory.c_str());
+		}
+
+		std::string directory;
+		std::vector<std::string> paths;
+		std::vector<std::string> hashes;
+	};
+} // namespace
+
+TEST(IsoHasher, HashesImage)
+{
+	// Not a multiple of the chunk size, so the last chunk is partial.
+	static constexpr u32 SECTORS = 1000;
+
+	TestImages images(1, SECTORS);
+	ASSERT_EQ(images.paths.size(), 1u);
+
+	IsoHasher hasher;
+	ASSERT_TRUE(hasher.OpenImage(images.paths[0]));
+	EXPECT_FALSE(hasher.IsCD());
+	ASSERT_EQ(hasher.GetTrackCount(), 1u);
+	EXPECT_EQ(hasher.GetTrack(0).sectors, SECTORS);
+
+	hasher.ComputeHashes();
+	EXPECT_EQ(hasher.GetTrack(0).hash, images.hashes[0]);
+}
+
+TEST(IsoHasher, HashesImagesConcurrently)
+{
+	static constexpr u32 IMAGES = 4;
+	static constexpr u32 SECTORS = 4096;
+
+	TestImages images(IMAGES, SECTORS);
+	ASSERT_EQ(images.paths.size(), IMAGES);
+
+	// Each hasher has its own reader, so none of them go through the global CDVD state.
+	std::vector<std::string> hashes(IMAGES);
+	std::vector<std::thread> threads;
+	for (u32 i = 0; i < IMAGES; i++)
+	{
+		threads.emplace_back([&images, &hashes, i]() {
+			IsoHasher hasher;
+			if (!hasher.OpenImage(images.paths[i]) || hasher.GetTrackCount() != 1)
+				return;
+
+			hasher.ComputeHashes();
+			hashes[i] = hasher.GetTrack(0).hash;
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	for (u32 i = 0; i < IMAGES; i++)
+		EXPECT_EQ(hashes[i], images.hashes[i]);
+}
+
+TEST(IsoHasher, VerifiesDirectory)
+{
+	static constexpr u32 IMAGES = 8;
+	static constexpr u32 SECTORS = 4096;
+
+	TestImages images(IMAGES, SECTORS);
+	ASSERT_EQ(images.paths.size(), IMAGES);
+
+	std::vector<IsoHasher::BatchEntry> entries = IsoHasher::FindImages(images.directory.c_str(), false);
+	ASSERT_EQ(entries.size(), IMAGES);
+
+	const IsoHasher::BatchStats stats = IsoHasher::VerifyImages(entries, 4);
+	EXPECT_EQ(stats.images, IMAGES);
+	EXPECT_EQ(stats.bytes, static_cast<u64>(IMAGES) * SECTORS * SECTOR_SIZE);
+
+	for (u32 i = 0; i < IMAGES; i++)
+	{
+		EXPECT_EQ(entries[i].path, images.paths[i]);
+		ASSERT_EQ(entries[i].tracks.size(), 1u);
+		EXPECT_EQ(entries[i].tracks[0].hash, images.hashes[i]);
+
+		// Made up images are never in the database.
+		EXPECT_EQ(entries[i].db_entry, nullptr);
+		EXPECT_FALSE(entries[i].error.empty());
+	}
+}
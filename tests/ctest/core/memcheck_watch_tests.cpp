@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/DebugTools/Breakpoints.h"
+#include "pcsx2/R5900.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+	static constexpr u32 BRANCH_PC = 0x00100000;
+	static constexpr u32 BEQ_ZERO_ZERO = 0x10000004; // beq zero, zero, +4
+	static constexpr u32 LW_V0_A0 = 0x8C820000; // lw v0, 0(a0)
+	static constexpr u32 WATCHED = 0x00200000;
+
+	static MemCheck MakeMemCheck(MemCheckCondition cond)
+	{
+		MemCheck mc;
+		mc.start = WATCHED;
+		mc.end = WATCHED + 16;
+		mc.memCond = cond;
+		mc.result = MEMCHECK_BREAK;
+		return mc;
+	}
+
+	class MemCheckWatchTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			std::memset(&cpuRegs, 0, sizeof(cpuRegs));
+			cpuRegs.pc = BRANCH_PC;
+			cpuRegs.cycle = 1000;
+		}
+
+		MemCheckWatch watch;
+	};
+} // namespace
+
+TEST_F(MemCheckWatchTest, DelaySlotAccessResumesAtBranch)
+{
+	EXPECT_EQ(MemCheckWatch::GetAccessPC(BRANCH_PC, BEQ_ZERO_ZERO), BRANCH_PC + 4);
+	EXPECT_EQ(MemCheckWatch::GetAccessPC(BRANCH_PC + 4, LW_V0_A0), BRANCH_PC + 4);
+}
+
+TEST_F(MemCheckWatchTest, DelaySlotAccessStopsEveryTime)
+{
+	std::vector<MemCheck> checks = {MakeMemCheck(MEMCHECK_READ)};
+
+	// The access in the delay slot of a loop, execution stops at the branch each time round.
+	for (int i = 0; i < 3; i++)
+	{
+		EXPECT_TRUE(watch.Check(checks, WATCHED + 4, 4, false)) << i;
+		EXPECT_FALSE(watch.Check(checks, WATCHED + 4, 4, false)) << "retry " << i;
+		cpuRegs.cycle += 10;
+	}
+
+	EXPECT_EQ(checks[0].numHits.Get(), 3u);
+}
+
+TEST_F(MemCheckWatchTest, OnlyMatchingAccessesStop)
+{
+	std::vector<MemCheck> checks = {MakeMemCheck(MEMCHECK_WRITE)};
+
+	EXPECT_FALSE(watch.Check(checks, WATCHED, 4, false));
+	EXPECT_FALSE(watch.Check(checks, WATCHED + 16, 4, true));
+	EXPECT_FALSE(watch.Check(checks, WATCHED - 4, 4, true));
+	EXPECT_TRUE(watch.Check(checks, WATCHED - 2, 4, true));
+}
+
+TEST_F(MemCheckWatchTest, ConditionEvaluatedOnFirstHit)
+{
+	std::vector<MemCheck> checks = {MakeMemCheck(MEMCHECK_READ)};
+	MemCheck& mc = checks[0];
+	std::string error;
+	mc.hasCond = true;
+	mc.cond.debug = &r5900Debug;
+	mc.cond.expressionString = "a0 == 0x200008";
+	ASSERT_TRUE(r5900Debug.initExpression(mc.cond.expressionString.c_str(), mc.cond.expression, error)) << error;
+	mc.cond.Compile();
+
+	cpuRegs.GPR.n.a0.UD[0] = WATCHED + 4;
+	EXPECT_FALSE(watch.Check(checks, WATCHED + 4, 4, false));
+	EXPECT_EQ(mc.cond.evaluations.Get(), 1u);
+
+	cpuRegs.cycle += 10;
+	cpuRegs.GPR.n.a0.UD[0] = WATCHED + 8;
+	EXPECT_TRUE(watch.Check(checks, WATCHED + 8, 4, false));
+	EXPECT_EQ(mc.cond.evaluations.Get(), 2u);
+	EXPECT_EQ(mc.numHits.Get(), 1u);
+
+	// Not evaluated again for the retry, the registers are the same.
+	EXPECT_FALSE(watch.Check(checks, WATCHED + 8, 4, false));
+	EXPECT_EQ(mc.cond.evaluations.Get(), 2u);
+}
+
+TEST(BreakPointCounter, CopiesShareCounts)
+{
+	MemCheck stored;
+	MemCheck copy = stored;
+	copy.numHits.Increment();
+	copy.cond.evaluations.Increment();
+	EXPECT_EQ(stored.numHits.Get(), 1u);
+	EXPECT_EQ(stored.cond.evaluations.Get(), 1u);
+
+	// Setting a new condition starts counting again, without old copies adding to it.
+	stored.cond.Compile();
+	copy.cond.evaluations.Increment();
+	EXPECT_EQ(stored.cond.evaluations.Get(), 0u);
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "MockMemoryInterface.h"
+#include "pcsx2/DebugTools/MIPSAnalyst.h"
+
+#include "common/StringUtil.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace MIPSAnalyst;
+
+namespace
+{
+	static constexpr u32 BASE = 0x00100000;
+	static constexpr u32 SIZE = 0x20000;
+	static constexpr u32 SPLIT = BASE + 0x4000;
+
+	static constexpr u32 NOP = 0x00000000;
+	static constexpr u32 ADDIU_A0 = 0x24840001; // addiu a0, a0, 1
+	static constexpr u32 JR_RA = 0x03e00008;
+
+	static u32 MakeBne(s32 words) { return 0x14800000 | (static_cast<u32>(words) & 0xFFFF); } // bne a0, zero
+	static u32 MakeB(s32 words) { return 0x10000000 | (static_cast<u32>(words) & 0xFFFF); } // beq zero, zero
+	static u32 MakeJ(u32 target) { return 0x08000000 | ((target >> 2) & 0x03FFFFFF); }
+
+	class MIPSAnalystTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			ON_CALL(memory, Read32(testing::_, testing::_)).WillByDefault([this](u32 address, bool* valid) {
+				const bool inside = address >= BASE && address < BASE + SIZE && !(address & 3);
+				if (valid)
+					*valid = inside;
+				return inside ? code[(address - BASE) / 4] : 0;
+			});
+
+			source = *database.get_symbol_source("Test");
+		}
+
+		void SetCode(u32 address, u32 op) { code[(address - BASE) / 4] = op; }
+
+		void AddExistingFunction(u32 address, u32 size)
+		{
+			ccc::Result<ccc::Function*> function = database.functions.create_symbol(
+				StringUtil::StdStringFromFormat("existing_%08x", address), address, source, nullptr);
+			ASSERT_TRUE(function.success());
+			(*function)->set_size(size);
+		}
+
+		// Deterministic code with a mix of leaf and non-leaf functions, tail calls, noreturn loops and padding.
+		void GenerateCode()
+		{
+			u32 seed = 0x12345678;
+			const auto next = [&seed]() {
+				seed = seed * 1664525 + 1013904223;
+				return seed >> 8;
+			};
+
+			for (u32 i = 0; i < SIZE / 4; i++)
+			{
+				const u32 address = BASE + i * 4;
+				const u32 roll = next() % 100;
+				if (roll < 8)
+					code[i] = JR_RA;
+				else if (roll < 16)
+					code[i] = MakeBne(1 + next() % 48);
+				else if (roll < 18)
+					code[i] = MakeB(-static_cast<s32>(1 + next() % 16));
+				else if (roll < 20 && address > BASE + 0x100)
+					code[i] = MakeJ(address - 4 * (1 + next() % 0x40));
+				else if (roll < 26)
+					code[i] = NOP;
+				else
+					code[i] = ADDIU_A0;
+			}
+		}
+
+		testing::NiceMock<MockMemoryInterface> memory;
+		ccc::SymbolDatabase database;
+		ccc::SymbolSourceHandle source;
+		std::vector<u32> code = std::vector<u32>(SIZE / 4, ADDIU_A0);
+	};
+
+	static void ExpectSameFunctions(const std::vector<AnalyzedFunction>& actual, const std::vector<AnalyzedFunction>& expected)
+	{
+		ASSERT_EQ(actual.size(), expected.size());
+		for (size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(actual[i].start, expected[i].start) << i;
+			EXPECT_EQ(actual[i].end, expected[i].end) << i;
+			EXPECT_EQ(actual[i].isStraightLeaf, expected[i].isStraightLeaf) << i;
+			EXPECT_EQ(actual[i].suspectedNoReturn, expected[i].suspectedNoReturn) << i;
+		}
+	}
+
+	static const AnalyzedFunction* FindFunction(const std::vector<AnalyzedFunction>& functions, u32 start)
+	{
+		for (const AnalyzedFunction& function : functions)
+		{
+			if (function.start == start)
+				return &function;
+		}
+
+		return nullptr;
+	}
+} // namespace
+
+TEST_F(MIPSAnalystTest, SplitScanMatchesSinglePiece)
+{
+	GenerateCode();
+	for (u32 address = SPLIT; address < BASE + SIZE; address += 0x2800)
+		AddExistingFunction(address, 0x20);
+
+	const std::vector<AnalyzedFunction> expected = AnalyzeFunctions(database, memory, BASE, BASE + SIZE, false, nullptr, 1);
+	const std::vector<AnalyzedFunction> actual = AnalyzeFunctions(database, memory, BASE, BASE + SIZE, false, nullptr);
+
+	EXPECT_GT(expected.size(), 100u);
+	ExpectSameFunctions(actual, expected);
+}
+
+TEST_F(MIPSAnalystTest, BranchPastSplit)
+{
+	AddExistingFunction(SPLIT, 0x20);
+
+	// The function still ends at the existing one, and the scan starts over after it.
+	SetCode(SPLIT - 0x40, MakeBne(0x40));
+	SetCode(SPLIT + 0x40, JR_RA);
+
+	const std::vector<AnalyzedFunction> expected = AnalyzeFunctions(database, memory, BASE, BASE + SIZE, false, nullptr, 1);
+	const std::vector<AnalyzedFunction> actual = AnalyzeFunctions(database, memory, BASE, BASE + SIZE, false, nullptr);
+	ExpectSameFunctions(actual, expected);
+
+	const AnalyzedFunction* before_split = FindFunction(actual, BASE);
+	ASSERT_NE(before_split, nullptr);
+	EXPECT_EQ(before_split->end, SPLIT - 4);
+	EXPECT_FALSE(before_split->isStraightLeaf);
+
+	const AnalyzedFunction* after_split = FindFunction(actual, SPLIT + 0x20);
+	ASSERT_NE(after_split, nullptr);
+	EXPECT_EQ(after_split->end, SPLIT + 0x44);
+	EXPECT_TRUE(after_split->isStraightLeaf);
+}
+
+TEST_F(MIPSAnalystTest, ExistingFunctionCrossingSplit)
+{
+	// The scan of the first piece skips over the split inside the first existing function, so the
+	// second piece, which started at the split, has to be scanned again.
+	AddExistingFunction(SPLIT - 0x10, 0x40);
+	AddExistingFunction(SPLIT, 0x20);
+	SetCode(SPLIT + 0x50, JR_RA);
+
+	const std::vector<AnalyzedFunction> expected = AnalyzeFunctions(database, memory, BASE, BASE + SIZE, false, nullptr, 1);
+	const std::vector<AnalyzedFunction> actual = AnalyzeFunctions(database, memory, BASE, BASE + SIZE, false, nullptr);
+	ExpectSameFunctions(actual, expected);
+
+	EXPECT_EQ(FindFunction(actual, SPLIT + 0x20), nullptr);
+	const AnalyzedFunction* after_split = FindFunction(actual, SPLIT + 0x30);
+	ASSERT_NE(after_split, nullptr);
+	EXPECT_EQ(after_split->end, SPLIT + 0x54);
+}
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Patch.h"
+
+#include "PatchTestPrograms.h"
+
+#include "common/Timer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+TEST(Patch, CompiledVersusInterpreted)
+{
+	// A few thousand lines of cheats, applied for a minute of frames.
+	static constexpr u32 FRAMES = 3600;
+
+	const std::vector<Patch::PatchCommand> commands = BuildCheatSet(500);
+	const std::vector<const Patch::PatchCommand*> pointers = BuildPatchList(commands);
+
+	Patch::PatchProgram program;
+	Patch::CompilePatches(&program, pointers);
+
+	TestMemoryInterface ee, iop;
+
+	Common::Timer timer;
+	for (u32 i = 0; i < FRAMES; i++)
+	{
+		Patch::ApplyPatches(pointers, Patch::PPT_CONTINUOUSLY, ee, iop);
+		Patch::ApplyPatches(pointers, Patch::PPT_COMBINED_0_1, ee, iop);
+	}
+	const double interpreted_ms = timer.GetTimeMilliseconds();
+
+	timer.Reset();
+	for (u32 i = 0; i < FRAMES; i++)
+	{
+		Patch::ApplyPatches(program, Patch::PPT_CONTINUOUSLY, ee, iop);
+		Patch::ApplyPatches(program, Patch::PPT_COMBINED_0_1, ee, iop);
+	}
+	const double compiled_ms = timer.GetTimeMilliseconds();
+
+	std::printf("Patch, %zu commands for %u frames: %.3f ms interpreted, %.3f ms compiled\n", commands.size(), FRAMES,
+		interpreted_ms, compiled_ms);
+}
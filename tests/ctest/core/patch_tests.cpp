@@ -4,49 +4,47 @@
 #include "Patch.h"
 
 #include "MockMemoryInterface.h"
+#include "PatchTestPrograms.h"
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
+static constexpr Patch::patch_place_type ALL_PLACES[] = {
+	Patch::PPT_ONCE_ON_LOAD, Patch::PPT_CONTINUOUSLY, Patch::PPT_COMBINED_0_1, Patch::PPT_ON_LOAD_OR_WHEN_ENABLED};
+
 // Create a test that makes sure applying a given list of patch commands results
-// in a certain sequence of memory reads/writes.
+// in a certain sequence of memory reads/writes, both directly and compiled.
 #define PATCH_TEST(name, ...) \
 	static void patch_test_setup_expected_calls_##name(MockMemoryInterface& ee, MockMemoryInterface& iop); \
 	TEST(Patch, name) \
 	{ \
-		testing::StrictMock<MockMemoryInterface> ee; \
-		testing::StrictMock<MockMemoryInterface> iop; \
-		{ \
-			testing::InSequence seq; \
-			patch_test_setup_expected_calls_##name(ee, iop); \
-		} \
 		Patch::PatchCommand commands[]{__VA_ARGS__}; \
 		std::vector<const Patch::PatchCommand*> pointers; \
 		pointers.reserve(std::size(commands)); \
 		for (Patch::PatchCommand& command : commands) \
 			pointers.push_back(&command); \
-		Patch::ApplyPatches(pointers, Patch::PPT_ONCE_ON_LOAD, ee, iop); \
-		Patch::ApplyPatches(pointers, Patch::PPT_CONTINUOUSLY, ee, iop); \
-		Patch::ApplyPatches(pointers, Patch::PPT_COMBINED_0_1, ee, iop); \
-		Patch::ApplyPatches(pointers, Patch::PPT_ON_LOAD_OR_WHEN_ENABLED, ee, iop); \
+		Patch::PatchProgram program; \
+		Patch::CompilePatches(&program, pointers); \
+		for (const bool compiled : {false, true}) \
+		{ \
+			testing::StrictMock<MockMemoryInterface> ee; \
+			testing::StrictMock<MockMemoryInterface> iop; \
+			{ \
+				testing::InSequence seq; \
+				patch_test_setup_expected_calls_##name(ee, iop); \
+			} \
+			for (const Patch::patch_place_type place : ALL_PLACES) \
+			{ \
+				if (compiled) \
+					Patch::ApplyPatches(program, place, ee, iop); \
+				else \
+					Patch::ApplyPatches(pointers, place, ee, iop); \
+			} \
+		} \
 	} \
 	static void patch_test_setup_expected_calls_##name(MockMemoryInterface& ee, MockMemoryInterface& iop)
 
-static Patch::PatchCommand BuildPatchCommand(
-	Patch::patch_place_type place,
-	Patch::patch_cpu_type cpu,
-	u32 address,
-	Patch::patch_data_type type,
-	u64 data)
-{
-	Patch::PatchCommand command;
-	command.placetopatch = place;
-	command.cpu = cpu;
-	command.addr = address;
-	command.type = type;
-	command.data = data;
-	return command;
-}
-
 // *****************************************************************************
 // Writes
 // *****************************************************************************
@@ -632,3 +630,124 @@ PATCH_TEST(ExtendedConditionalResetSkipCount,
 	ee.ExpectRead8(0x00200000, 0);
 	ee.ExpectWrite8(0x00200000, 0x12);
 }
+
+// *****************************************************************************
+// Compiled Programs
+// *****************************************************************************
+
+TEST(Patch, CompiledProgramBatchesWrites)
+{
+	Patch::PatchCommand commands[] = {
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, 0x00100000, Patch::WORD_T, 0x12345678),
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, 0x00100ff8, Patch::DOUBLE_BE_T, 0x0123456789abcdef),
+		BuildPatchCommand(Patch::PPT_ONCE_ON_LOAD, Patch::CPU_EE, 0x00100004, Patch::BYTE_T, 0x12),
+		// New page.
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, 0x00101000, Patch::SHORT_T, 0x1234),
+		// Different CPU.
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_IOP, 0x00101004, Patch::SHORT_T, 0x1234),
+		// Ignored by the IOP.
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_IOP, 0x00101008, Patch::DOUBLE_T, 0x1234),
+		// Straddles a page.
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, 0x00101ffe, Patch::WORD_T, 0x12345678),
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, 0x00200000, Patch::EXTENDED_T, 0x00000012),
+		BuildPatchCommand(Patch::PPT_CONTINUOUSLY, Patch::CPU_EE, 0x00200004, Patch::WORD_T, 0x12345678),
+	};
+
+	std::vector<const Patch::PatchCommand*> pointers = {nullptr};
+	for (const Patch::PatchCommand& command : commands)
+		pointers.push_back(&command);
+	pointers.push_back(nullptr);
+	pointers.push_back(&commands[0]);
+
+	Patch::PatchProgram program;
+	Patch::CompilePatches(&program, pointers);
+
+	using OpType = Patch::PatchProgram::OpType;
+	const std::vector<Patch::PatchProgram::Op>& ops = program.ops[Patch::PPT_CONTINUOUSLY];
+	ASSERT_EQ(ops.size(), 7u);
+	EXPECT_EQ(ops[0].type, OpType::WriteRun);
+	EXPECT_EQ(ops[0].count, 2u);
+	EXPECT_EQ(ops[1].type, OpType::WriteRun);
+	EXPECT_EQ(ops[1].count, 1u);
+	EXPECT_EQ(ops[2].type, OpType::WriteRun);
+	EXPECT_EQ(ops[2].cpu, Patch::CPU_IOP);
+	EXPECT_EQ(ops[2].count, 1u);
+	EXPECT_EQ(ops[3].type, OpType::Interpret);
+	EXPECT_EQ(ops[3].count, 2u);
+	EXPECT_EQ(ops[4].type, OpType::WriteRun);
+	EXPECT_EQ(ops[5].type, OpType::ResetState);
+	EXPECT_EQ(ops[6].type, OpType::WriteRun);
+	EXPECT_EQ(program.writes[ops[0].start + 1].value, 0xefcdab8967452301ull);
+
+	// Nothing extended, so no need to reset the state.
+	ASSERT_EQ(program.ops[Patch::PPT_ONCE_ON_LOAD].size(), 1u);
+	EXPECT_TRUE(program.ops[Patch::PPT_COMBINED_0_1].empty());
+}
+
+TEST(Patch, CompiledProgramMatchesInterpreter)
+{
+	const std::vector<Patch::PatchCommand> commands = BuildCheatSet(500);
+	const std::vector<const Patch::PatchCommand*> pointers = BuildPatchList(commands);
+
+	Patch::PatchProgram program;
+	Patch::CompilePatches(&program, pointers);
+
+	TestMemoryInterface interpreted_ee, interpreted_iop;
+	TestMemoryInterface compiled_ee, compiled_iop;
+	for (int frame = 0; frame < 2; frame++)
+	{
+		for (const Patch::patch_place_type place : ALL_PLACES)
+		{
+			Patch::ApplyPatches(pointers, place, interpreted_ee, interpreted_iop);
+			Patch::ApplyPatches(program, place, compiled_ee, compiled_iop);
+		}
+	}
+
+	EXPECT_NE(interpreted_ee.GetWriteCount(), 0u);
+	EXPECT_EQ(interpreted_ee.GetWriteCount(), compiled_ee.GetWriteCount());
+	EXPECT_EQ(interpreted_iop.GetWriteCount(), compiled_iop.GetWriteCount());
+	EXPECT_TRUE(interpreted_ee.GetData() == compiled_ee.GetData());
+	EXPECT_TRUE(interpreted_iop.GetData() == compiled_iop.GetData());
+}
+
+TEST(Patch, CompiledWriteRunComparesAgainstPage)
+{
+	const std::vector<Patch::PatchCommand> commands = BuildCheatSet(500);
+	const std::vector<const Patch::PatchCommand*> pointers = BuildPatchList(commands);
+
+	Patch::PatchProgram program;
+	Patch::CompilePatches(&program, pointers);
+
+	// One compares against the page directly, like EE RAM does. The other goes through the read handlers, like
+	// when the EE cache is enabled or the page is mapped to handlers.
+	TestMemoryInterface direct, handlers;
+	const Patch::PatchProgram::Write* last_run = nullptr;
+	u32 last_run_count = 0;
+	for (int frame = 0; frame < 2; frame++)
+	{
+		for (const Patch::patch_place_type place : ALL_PLACES)
+		{
+			for (const Patch::PatchProgram::Op& op : program.ops[place])
+			{
+				if (op.type != Patch::PatchProgram::OpType::WriteRun || op.cpu != Patch::CPU_EE)
+					continue;
+
+				last_run = &program.writes[op.start];
+				last_run_count = op.count;
+				Patch::ApplyWriteRun(last_run, last_run_count, direct, direct.GetPage(last_run[0].addr));
+				Patch::ApplyWriteRun(last_run, last_run_count, handlers, nullptr);
+			}
+		}
+
+		EXPECT_EQ(direct.GetWriteCount(), handlers.GetWriteCount());
+		EXPECT_TRUE(direct.GetData() == handlers.GetData());
+	}
+
+	EXPECT_NE(direct.GetWriteCount(), 0u);
+
+	// Nothing has changed since the last run was applied, so it shouldn't write anything.
+	ASSERT_NE(last_run, nullptr);
+	const u32 writes = direct.GetWriteCount();
+	Patch::ApplyWriteRun(last_run, last_run_count, direct, direct.GetPage(last_run[0].addr));
+	EXPECT_EQ(direct.GetWriteCount(), writes);
+}
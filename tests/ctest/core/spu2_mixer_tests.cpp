@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "SPU2/VoiceMix.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+	struct VoiceMixInput
+	{
+		VoiceOutputSet outputs;
+		V_VoiceGates gates[V_Core::NumVoices];
+	};
+
+	static void RandomizeInput(std::mt19937& rng, VoiceMixInput& input)
+	{
+		std::uniform_int_distribution<s32> sample(-0x8000, 0x7fff);
+		std::uniform_int_distribution<s32> gate(0, 1);
+
+		for (uint i = 0; i < V_Core::NumVoices; i++)
+		{
+			input.outputs.Set(i, sample(rng), sample(rng), sample(rng));
+			input.gates[i] = {-gate(rng), -gate(rng), -gate(rng), -gate(rng)};
+		}
+	}
+
+	static void ExpectEqual(const VoiceMixSet& expected, const VoiceMixSet& actual)
+	{
+		EXPECT_EQ(expected.Dry.Left, actual.Dry.Left);
+		EXPECT_EQ(expected.Dry.Right, actual.Dry.Right);
+		EXPECT_EQ(expected.Wet.Left, actual.Wet.Left);
+		EXPECT_EQ(expected.Wet.Right, actual.Wet.Right);
+	}
+} // namespace
+
+TEST(SPU2Mixer, VoiceMixMatchesReference)
+{
+	std::mt19937 rng(1234);
+	VoiceMixInput input;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		RandomizeInput(rng, input);
+		const VoiceMixSet expected = MixVoiceOutputs_reference(input.outputs, input.gates);
+		ExpectEqual(expected, MixVoiceOutputs_sse(input.outputs, input.gates));
+		ExpectEqual(expected, MixVoiceOutputs(input.outputs, input.gates));
+	}
+}
+
+TEST(SPU2Mixer, InterpolationMatchesReference)
+{
+	std::mt19937 rng(5678);
+	std::uniform_int_distribution<s32> sample(-0x8000, 0x7fff);
+
+	s32 fifo[32];
+	for (s32& value : fifo)
+		value = sample(rng);
+
+	// Every phase at every read position, including the ones which wrap around the fifo.
+	for (u32 pos = 0; pos < 64; pos++)
+	{
+		for (u32 phase = 0; phase < 256; phase++)
+			EXPECT_EQ(InterpolateVoice_reference(fifo, pos, phase), InterpolateVoice(fifo, pos, phase));
+	}
+}
+
+TEST(SPU2Mixer, PcmCacheInvalidation)
+{
+	PcmCache::Release();
+
+	for (u32 block = 0; block < 256; block++)
+	{
+		ASSERT_NE(PcmCache::GetEntry(block), nullptr);
+		PcmCache::Validate(block);
+	}
+
+	// Words 0x18..0x217 cover blocks 3..66, spanning a bitmap word boundary on each side.
+	PcmCache::InvalidateRange(0x18, 0x218);
+	for (u32 block = 0; block < 256; block++)
+		EXPECT_EQ(PcmCache::IsValid(block), block < 3 || block > 66) << "block " << block;
+
+	PcmCache::Invalidate(0x7ff);
+	EXPECT_FALSE(PcmCache::IsValid(0xff));
+	EXPECT_TRUE(PcmCache::IsValid(0xfe));
+
+	const PcmCache::Stats stats = PcmCache::GetStats();
+	EXPECT_EQ(stats.pages, 1u);
+
+	PcmCache::Release();
+	EXPECT_FALSE(PcmCache::IsValid(0));
+	EXPECT_EQ(PcmCache::GetStats().pages, 0u);
+}